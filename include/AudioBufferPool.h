@@ -0,0 +1,78 @@
+#pragma once
+
+#include "pico/audio.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Producer buffer pool for pico-extras audio in a static arena
+ *
+ * Builds the same audio_buffer_pool_t that audio_new_producer_pool()
+ * returns, but from statically allocated buffer headers and sample
+ * memory, so no audio buffer comes from the heap. pico-extras still
+ * mallocs a one-frame consumer pool when I2S is connected; the
+ * pass-through connection never uses it. There is one arena, for the
+ * one I2S output.
+ *
+ * All buffers are made up front; only the current depth of them
+ * circulate between the producer and I2S. The rest are parked: take()
+ * parks buffers coming back to the free list while the depth is above
+ * its target, and setDepth() hands parked buffers straight back.
+ *
+ * take() and setDepth() must run in the producer context only.
+ */
+class AudioBufferPool {
+public:
+    static constexpr uint MAX_BUFFERS = 8;
+    static constexpr size_t ARENA_BYTES = 8 * 1024;   ///< 8 stereo buffers of 256 samples
+
+    AudioBufferPool();
+
+    AudioBufferPool(const AudioBufferPool&) = delete;
+    AudioBufferPool& operator=(const AudioBufferPool&) = delete;
+
+    /**
+     * @brief Lay out @p bufferCount buffers of @p samplesPerBuffer frames in the arena
+     *
+     * @param depth Buffers circulating at first (the rest are parked)
+     * @return false if the buffers do not fit in MAX_BUFFERS or ARENA_BYTES
+     */
+    bool init(const audio_buffer_format_t* format, uint bufferCount, uint samplesPerBuffer, uint depth);
+
+    /**
+     * @brief The pool to connect to I2S (nullptr before init())
+     */
+    audio_buffer_pool_t* get() { return initialized_ ? &pool_ : nullptr; }
+
+    /**
+     * @brief Next free buffer, or nullptr; parks buffers while shrinking
+     */
+    audio_buffer_t* take();
+
+    /**
+     * @brief Change the number of circulating buffers, clamped to 1 - buffer count
+     *
+     * Growing takes effect at once; shrinking as buffers come back free.
+     */
+    void setDepth(uint depth);
+
+    uint getDepth() const { return target_; }
+    uint getCirculating() const { return circulating_; }
+    uint getBufferCount() const { return bufferCount_; }
+
+private:
+    static audio_buffer_t buffers_[MAX_BUFFERS];
+    static mem_buffer_t memory_[MAX_BUFFERS];
+    alignas(4) static uint8_t arena_[ARENA_BYTES];
+
+    audio_buffer_pool_t pool_;
+    audio_buffer_t* parked_;    // Out of circulation, linked by next
+    uint bufferCount_;
+    uint circulating_;          // Free, queued or playing
+    uint target_;
+    bool initialized_;
+};
+
+} // namespace Exterminate
@@ -1,6 +1,18 @@
 #pragma once
 
-#include "audio/audio_index.h"
+#include <audio/audio_index.h>
+#include "AudioBufferPool.h"
+#include "AudioDsp.h"
+#include "AudioMixer.h"
+#include "ClipCache.h"
+#include "ClipShuffle.h"
+#include "DalekVoice.h"
+#include "DirectPlayback.h"
+#include "MicCapture.h"
+#include "PsramAllocator.h"
+#include "SpscRing.h"
+#include "SynthEngine.h"
+#include "TimeStretch.h"
 #include "pico/audio_i2s.h"
 #include "pico/time.h"
 #include "hardware/pio.h"
@@ -16,6 +28,18 @@ namespace Exterminate {
  * Simplified implementation focused on reliable I2S audio output
  * using the proven Pico Extras library. Supports embedded PCM audio
  * with real-time streaming and LED visualization integration.
+ * Several clips can play at once through the fixed-point AudioMixer,
+ * and short effects can be synthesised by SynthEngine on the same bus.
+ * A live microphone can be mixed in through the DalekVoice effect.
+ * Speech clips can be pitch-bent live, optionally keeping their tempo
+ * through a WSOLA TimeStretch stage.
+ * The mixed bus then runs through a fixed-point speaker EQ and dynamics
+ * chain before master volume.
+ * After a quiet period the I2S clocks, their DMA and the amplifier are
+ * put in standby; the next trigger wakes them.
+ * Buffers are produced either on core0 or by a dedicated loop on core1;
+ * in both cases triggers reach the mixer through a lock-free command
+ * ring, and the producer is woken as soon as I2S releases a buffer.
  */
 class AudioController {
 public:
@@ -28,6 +52,16 @@ public:
         Paused
     };
 
+    /**
+     * @brief Where audio buffers are produced
+     */
+    enum class StreamingMode {
+        Timer,  ///< 5 ms repeating timer on core0, shared with BTstack
+        Core1   ///< Dedicated producer loop on core1
+    };
+
+    static constexpr uint8_t NO_PIN = 0xFF;   ///< Config pin that is not wired
+
     /**
      * @brief I2S Configuration structure
      */
@@ -35,16 +69,40 @@ public:
         uint8_t dataPin;        ///< I2S data output pin (DOUT)
         uint8_t clockPinBase;   ///< Base pin for clocks (BCK = base, LRCLK = base+1)
         uint32_t sampleRate;    ///< Audio sample rate (Hz)
-        uint bufferCount;       ///< Number of audio buffers to use
+        uint bufferCount;       ///< Buffers queued to I2S (the adaptive minimum)
         uint samplesPerBuffer;  ///< Samples per audio buffer
+        uint maxBufferCount;    ///< Adaptive depth ceiling (<= bufferCount: fixed depth)
+        StreamingMode streamingMode; ///< Buffer producer context
+        bool refillOnRelease;   ///< Refill as soon as I2S releases a buffer (timer becomes a fallback)
+        bool hotStart;          ///< Keep I2S running on silence and pre-render each clip's first buffer
+        bool clipCache;         ///< Decode played clips into PSRAM (when the board has it)
+        bool prefetch;          ///< DMA clip bytes into SRAM ahead of the mixer
+        uint8_t micPin;         ///< ADC pin of the Dalek voice microphone
+        bool outputDsp;         ///< Speaker EQ, compressor and limiter on the output bus
+        bool directPlayback;    ///< Claim DMA for playAudioDirect() (needs outputDsp off; skips EQ and limiter)
+        bool preserveTempo;     ///< Time-stretch bent speech back to its original duration
+        uint8_t ampShutdownPin; ///< MAX98357A SD pin, low in standby (NO_PIN if tied to 3V3)
+        uint32_t standbyMs;     ///< Silence before standby (0 = never)
         
         static Config getDefault() {
             return Config{
                 .dataPin = 34,         // GPIO 34 = I2S DOUT
                 .clockPinBase = 32,    // GPIO 32 = BCK, GPIO 33 = LRCLK
                 .sampleRate = 44100,   // Match our embedded audio files (they are 44.1kHz)
-                .bufferCount = 3,      // Triple buffering for smooth playback
-                .samplesPerBuffer = 256 // Small buffers for low latency
+                .bufferCount = 2,      // Double buffering is enough with release-driven refill
+                .samplesPerBuffer = 128, // 2.9 ms buffers keep the live mic under 10 ms
+                .maxBufferCount = 6,   // Up to 17 ms of queue through a BT pairing storm
+                .streamingMode = StreamingMode::Timer,
+                .refillOnRelease = true,
+                .hotStart = true,
+                .clipCache = true,
+                .prefetch = true,
+                .micPin = 40,          // GPIO 40 = ADC0 on the RP2350B
+                .outputDsp = true,
+                .directPlayback = false, // Would bypass the speaker EQ and limiter
+                .preserveTempo = false, // Varispeed: no added trigger latency
+                .ampShutdownPin = 16,  // GPIO 16 = MAX98357A SD
+                .standbyMs = 10000
             };
         }
     };
@@ -80,20 +138,189 @@ public:
     /**
      * @brief Play embedded audio by index
      * 
+     * The clip is mixed with anything already playing. When all mixer
+     * voices are busy the lowest-priority, oldest voice is replaced.
+     * 
      * @param audioIndex Audio file to play
+     * @param gain Per-voice gain (0.0 to 1.0), applied before master volume
+     * @param priority Voice priority used for stealing
      * @return true if playback started
      */
-    bool playAudio(Audio::AudioIndex audioIndex);
+    bool playAudio(Audio::AudioIndex audioIndex, float gain = 1.0f,
+                   AudioMixer::VoicePriority priority = AudioMixer::VoicePriority::Speech);
 
     /**
-     * @brief Play a random audio file from available audio files
+     * @brief Play a clip gaplessly after the most recently started one
+     * 
+     * The clip is resolved (and pinned in the clip cache) now, so the
+     * producer only has to switch readers at the seam. A looping clip
+     * being followed stops looping and plays out its tail first. With
+     * nothing playing the clip starts at once. The follow-on clip keeps
+     * the voice's gain and priority and must share its sample rate.
      * 
+     * @param audioIndex Audio file to play next
+     * @param gain Voice gain (0.0 to 1.0) if the clip starts a new voice
+     * @param priority Voice priority if the clip starts a new voice
+     * @return true if the clip was queued
+     */
+    bool queueAudio(Audio::AudioIndex audioIndex, float gain = 1.0f,
+                    AudioMixer::VoicePriority priority = AudioMixer::VoicePriority::Speech);
+
+    /**
+     * @brief Synthesise an effect from a patch instead of a stored clip
+     * 
+     * The note is mixed with any clips playing. When all synth voices are
+     * busy the oldest note is replaced.
+     * 
+     * @param patch Patch to play; must outlive the note (e.g. SynthPatches::ZAP)
+     * @param gain Note gain (0.0 to 1.0), applied before master volume
+     * @return Handle of the queued note, or SynthEngine::NO_NOTE if it was dropped
+     */
+    SynthEngine::NoteId playSynth(const SynthPatch& patch, float gain = 1.0f);
+
+    /**
+     * @brief Move one synthesised note to its release stage
+     * 
+     * Ends sustained patches such as SynthPatches::MOTOR_HUM. Other notes,
+     * and a note that has already ended or lost its voice, are untouched.
+     * 
+     * @param note Handle returned by playSynth()
+     */
+    void releaseSynth(SynthEngine::NoteId note);
+
+    /**
+     * @brief Scale the pitch of one note whose patch tracks it (e.g. from motor speed)
+     * 
+     * Only the latest note given keeps following; setting another note
+     * leaves the previous one at its last pitch.
+     * 
+     * @param note Handle returned by playSynth()
+     * @param scale Pitch multiplier (0.25 to 8.0, 1.0 = patch pitch)
+     */
+    void setSynthPitch(SynthEngine::NoteId note, float scale);
+
+    /**
+     * @brief Check whether a note is queued or still sounding
+     * 
+     * false once the note has finished its release or its voice was
+     * stolen by a newer note.
+     * 
+     * @param note Handle returned by playSynth()
+     */
+    bool isSynthPlaying(SynthEngine::NoteId note) const;
+
+    /**
+     * @brief Bend the pitch of speech clips, including ones already playing
+     * 
+     * Speech-priority voices are played faster or slower by the mixer's
+     * rate converter, which moves their tempo with the pitch. With
+     * Config::preserveTempo the bus is then time-stretched by 1/scale so
+     * clips keep their length; the stretcher delays the mix by up to
+     * ~35 ms while it is engaged, and stays engaged until the bus goes
+     * quiet. Applied at the next buffer fill.
+     * 
+     * @param scale Pitch multiplier (0.5 to 2.0, 1.0 = as recorded)
+     */
+    void setSpeechPitch(float scale);
+
+    /**
+     * @brief Get the pitch multiplier last set by setSpeechPitch()
+     */
+    float getSpeechPitch() const {
+        return static_cast<float>(speechPitchQ12_.load()) / AudioMixer::PITCH_UNITY;
+    }
+
+    /**
+     * @brief Pitch bend cost measurement
+     */
+    struct PitchBendStats {
+        uint32_t lastCycles;  ///< Cycles in the latest stretched fill, the mixing it pulled included
+        uint32_t peakCycles;  ///< Worst stretched fill
+        uint32_t sequences;   ///< WSOLA sequences built (one search and crossfade each)
+        bool stretching;      ///< The time-stretch stage is in the signal path
+    };
+
+    /**
+     * @brief Get the time-stretch cost, to compare against getFillBudgetCycles()
+     */
+    PitchBendStats getPitchBendStats() const;
+
+    /**
+     * @brief Start the live microphone through the Dalek voice effect
+     * 
+     * The ADC on Config::micPin is captured by DMA and processed a buffer
+     * at a time by the producer, mixed with any clips and synth notes.
+     * Mic-to-speaker latency is about one buffer of mic backlog plus
+     * getQueueLatencyUs(); it stays under 10 ms with samplesPerBuffer at
+     * 128 or less and the queue at a depth of 2 (see getDalekVoiceStats()).
+     * 
+     * @return false if the ADC or a DMA channel is unavailable
+     */
+    bool startDalekVoice();
+
+    /**
+     * @brief Stop the live microphone and release the ADC
+     */
+    void stopDalekVoice();
+
+    /**
+     * @brief Check whether the microphone is being played
+     */
+    bool isDalekVoiceActive() const { return dalekActive_.load(); }
+
+    /**
+     * @brief Live microphone path measurement
+     */
+    struct DalekVoiceStats {
+        uint32_t lastLatencyUs;   ///< Age of the oldest mic sample at fill plus the fill-to-playout delay
+        uint32_t peakLatencyUs;   ///< Largest latency seen
+        uint32_t droppedSamples;  ///< Mic backlog discarded to keep latency bounded
+        uint32_t underruns;       ///< Fills that found fewer mic samples than the buffer holds
+        uint32_t overruns;        ///< Times the capture DMA lapped the reader
+        uint32_t lastCycles;      ///< Cycles spent on the mic in the latest fill
+        uint32_t peakCycles;      ///< Worst mic cost per fill
+        uint16_t minLimiterGain;  ///< Lowest limiter gain (Q15) since the last call
+    };
+
+    /**
+     * @brief Get mic-to-speaker latency, sample drops and effect cost
+     */
+    DalekVoiceStats getDalekVoiceStats();
+
+    /**
+     * @brief Play a PCM16 clip by DMA straight from flash
+     * 
+     * Hands the I2S PIO FIFO to DirectPlayback for the length of the clip:
+     * no buffer fills, no per-sample CPU work. Only possible at unity
+     * volume with Config::directPlayback set, the output chain off (so
+     * without the speaker EQ and limiter) and no mixer voices active;
+     * otherwise (or for compressed clips, looping clips and clips not at
+     * the I2S rate) the clip is played through playAudio(). Any later
+     * playAudio() or stopAudio() ends direct playback.
+     * 
+     * @param audioIndex Audio file to play
+     * @return true if playback started (direct or mixed)
+     */
+    bool playAudioDirect(Audio::AudioIndex audioIndex);
+
+    /**
+     * @brief Check whether a clip is streaming by DMA from flash
+     */
+    bool isDirectPlaying() const { return directActive_.load(); }
+
+    /**
+     * @brief Play a random clip
+     *
+     * Picks a category by Audio::AUDIO_CATEGORY_WEIGHTS, then the next clip
+     * of that category's shuffled deck (see ClipShuffle), so no clip
+     * repeats until its category has been played through.
+     *
      * @return true if playback started
      */
     bool playRandomAudio();
 
     /**
-     * @brief Stop current audio playback
+     * @brief Stop current audio playback (all voices)
      * 
      * @return true if stopped successfully
      */
@@ -148,13 +375,245 @@ public:
      */
     bool isInitialized() const { return initialized_; }
 
+    /**
+     * @brief Get number of mixer and synth voices currently playing
+     * 
+     * @return size_t Active voice count
+     */
+    size_t getActiveVoiceCount() const { return activeVoices_.load(); }
+
+    /**
+     * @brief Get the cost of the most recent buffer fill
+     * 
+     * @return uint32_t CPU cycles spent in fillAudioBuffer()
+     */
+    uint32_t getLastFillCycles() const { return lastFillCycles_.load(); }
+
+    /**
+     * @brief Get the worst buffer fill cost since initialization or resetStats()
+     * 
+     * Compare against getFillBudgetCycles() to check the mixer never
+     * starves the I2S buffers.
+     * 
+     * @return uint32_t Peak CPU cycles spent in fillAudioBuffer()
+     */
+    uint32_t getPeakFillCycles() const { return peakFillCycles_.load(); }
+
+    /**
+     * @brief Get the real-time cycle budget of one audio buffer
+     * 
+     * @return uint32_t Cycles available to produce samplesPerBuffer samples
+     */
+    uint32_t getFillBudgetCycles() const;
+
+    /**
+     * @brief Get the output queue ahead of a new fill, in microseconds
+     * 
+     * Every circulating producer buffer, the one playing included. I2S
+     * plays them in place through a pass-through connection, so its
+     * consumer pool holds no audio and adds nothing to this figure.
+     * 
+     * @return uint32_t Latency from fill to DAC at the current depth
+     */
+    uint32_t getQueueLatencyUs() const;
+
+    /**
+     * @brief Get number of times I2S found no queued buffer while playing
+     * 
+     * Counted in the I2S consumer's take path, so it reflects real
+     * silence gaps rather than producer-side estimates.
+     * 
+     * @return uint32_t Underrun count since initialization or resetStats()
+     */
+    uint32_t getUnderrunCount() const { return underruns_.load(); }
+
+    /**
+     * @brief Get number of buffers handed to the I2S consumer
+     * 
+     * @return uint32_t Buffers produced since initialization or resetStats()
+     */
+    uint32_t getBuffersProduced() const { return buffersProduced_.load(); }
+
+    /**
+     * @brief Get number of triggers that never reached a voice
+     * 
+     * Either the command ring was full or every voice held a higher
+     * priority.
+     * 
+     * @return uint32_t Dropped trigger count
+     */
+    uint32_t getDroppedTriggerCount() const { return droppedTriggers_.load(); }
+
+    /**
+     * @brief Get number of refills requested by buffer releases and triggers
+     * 
+     * @return uint32_t Refill request count since initialization
+     */
+    uint32_t getRefillRequestCount() const { return refillRequests_.load(); }
+
+    /**
+     * @brief Trigger-to-sound latency measurement
+     */
+    struct TriggerLatency {
+        uint32_t lastUs;     ///< Latest trigger to first non-zero sample handed to DMA
+        uint32_t peakUs;     ///< Largest latency seen
+        uint32_t hotStarts;  ///< Triggers served from a pre-rendered buffer
+        uint32_t measured;   ///< Triggers measured
+    };
+
+    /**
+     * @brief Get playAudio()-to-first-audible-sample latency
+     * 
+     * Measured in the I2S consumer take path: the time the buffer reaches
+     * DMA plus the offset of its first non-zero sample, minus the time
+     * playAudio() was called.
+     */
+    TriggerLatency getTriggerLatency() const;
+
+    static constexpr size_t QUEUE_DEPTH_BINS = 8;   ///< Queue depth histogram size; the last bin holds deeper queues
+
+    /**
+     * @brief Snapshot of the buffer pipeline's health
+     */
+    struct AudioStats {
+        uint32_t underruns;          ///< I2S found no queued buffer while playing
+        uint32_t overruns;           ///< Fills that took longer than their buffer plays
+        uint32_t droppedTriggers;    ///< See getDroppedTriggerCount()
+        uint32_t decodeErrors;       ///< Clips cut short by missing stored bytes, since boot
+        uint32_t buffersProduced;    ///< Buffers handed to I2S
+        uint32_t buffersPerSecond;   ///< Over the latest STATS_WINDOW_US window
+        uint32_t playbackEnds;       ///< Times every voice ran out and the stream stopped
+        uint32_t fillBudgetCycles;   ///< Real-time budget of one buffer
+        uint32_t minFillCycles;      ///< Cheapest audible fill (0 before the first)
+        uint32_t avgFillCycles;      ///< Mean audible fill over the latest window
+        uint32_t maxFillCycles;      ///< Worst audible fill
+        uint32_t queueDepth[QUEUE_DEPTH_BINS];  ///< Buffers queued each time I2S went for the next one (0 = underrun)
+        uint32_t bufferDepth;        ///< Buffers circulating now (see Config::maxBufferCount)
+        uint32_t peakBufferDepth;    ///< Deepest the adaptive queue has grown
+        uint32_t queueLatencyUs;     ///< getQueueLatencyUs() at the current depth
+        uint32_t depthGrows;         ///< Buffers added after an underrun or a tight fill
+        uint32_t depthShrinks;       ///< Buffers parked after ADAPT_SHRINK_US without either
+        TriggerLatency triggerLatency;
+    };
+
+    /**
+     * @brief Read every pipeline counter without blocking
+     * 
+     * Counters are read one at a time while the producer and the I2S IRQ
+     * keep running, so a snapshot may mix values a buffer apart. Size
+     * bufferCount from queueDepth (buffers rarely in the lowest bins
+     * means one could go) and samplesPerBuffer from the fill cycles
+     * against the budget and from triggerLatency. With adaptive depth,
+     * peakBufferDepth and depthGrows show how much headroom the worst
+     * stretch needed.
+     */
+    AudioStats getStats() const;
+
+    /**
+     * @brief Zero the counters, fill extremes, queue histogram and trigger latency
+     */
+    void resetStats();
+
+    /**
+     * @brief Print getStats() and the subsystem stats to the console
+     * 
+     * Takes the Dalek voice's limiter gain window like getDalekVoiceStats().
+     */
+    void dumpStats();
+
+    /**
+     * @brief Get PSRAM clip cache hit/miss counters
+     * 
+     * All zero when the board has no PSRAM or Config::clipCache is off.
+     */
+    ClipCache::Stats getClipCacheStats() const { return clipCache_.getStats(); }
+
+    /**
+     * @brief Get clip prefetch and XIP cache counters
+     * 
+     * Compare against a build with Config::prefetch off: misses and
+     * stall cycles show what the mixer still waited for, the XIP
+     * counters show the cache pressure on the rest of the firmware.
+     */
+    ClipPrefetcher::Stats getPrefetchStats() const { return prefetcher_.getStats(); }
+    void resetPrefetchStats() { prefetcher_.resetStats(); }
+
+    /**
+     * @brief Get synthesiser render cost and note counters
+     * 
+     * lastCycles/peakCycles are the synth's share of getLastFillCycles()
+     * and getPeakFillCycles(), to compare against getFillBudgetCycles().
+     */
+    SynthEngine::Stats getSynthStats() const { return synth_.getStats(); }
+
+    /**
+     * @brief Get the configured buffer producer context
+     */
+    StreamingMode getStreamingMode() const { return config_.streamingMode; }
+
+    /**
+     * @brief Compare the float reference sample path with the Q15 kernel
+     * 
+     * Runs both mono-to-stereo paths over one buffer of synthetic samples
+     * and prints cycles per buffer, along with the cost of rendering a
+     * buffer with every synth voice busy, of each output DSP stage, of
+     * fully bent mixer voices and of the worst time-stretch fill.
+     * Safe to call before initialize().
+     */
+    void benchmarkSamplePaths();
+
+    /**
+     * @brief Check whether I2S and the amplifier are in standby
+     */
+    bool isInStandby() const { return standby_.load(); }
+
+    /**
+     * @brief Standby measurement
+     */
+    struct StandbyStats {
+        bool standby;                ///< In standby now
+        uint32_t entries;            ///< Times the pipeline went to standby
+        uint32_t wakes;              ///< Times a call woke it
+        uint32_t lastWakeLatencyUs;  ///< Trigger-to-sound latency of the latest trigger that woke the pipeline
+        uint32_t peakWakeLatencyUs;  ///< Largest of those
+    };
+
+    /**
+     * @brief Get standby counts and the latency of waking triggers
+     * 
+     * Compare the wake latency with getTriggerLatency(): the difference
+     * is the cost of standby, at most one silent buffer (or
+     * AMP_STARTUP_US when that is longer).
+     */
+    StandbyStats getStandbyStats() const;
+
     /**
      * @brief Get current audio intensity for LED effects
      * 
+     * Follows the buffer I2S is playing, not the one being filled.
+     * 
      * @return float Normalized intensity (0.0 to 1.0)
      */
     float getAudioIntensity() const { return audioIntensity_.load(); }
 
+    /**
+     * @brief Audio/LED alignment measurement
+     */
+    struct IntensitySkew {
+        uint32_t lastFillLeadUs;  ///< Fill-to-playout delay of the latest buffer (the old LED lead)
+        uint32_t peakFillLeadUs;  ///< Largest fill-to-playout delay seen
+        uint32_t currentAgeUs;    ///< Time since the audible buffer's intensity was published
+    };
+
+    /**
+     * @brief Measure how far the LED intensity is from what is audible
+     * 
+     * Intensity is published when I2S starts playing a buffer, so the
+     * remaining skew is currentAgeUs (bounded by one buffer plus the LED
+     * timer period). Call it right where the intensity is read.
+     */
+    IntensitySkew getIntensitySkew() const;
+
     /**
      * @brief Apply natural decay to audio intensity (for LED effects)
      * Call this periodically to make LED effects fade out
@@ -174,9 +633,11 @@ private:
     // Thread-safe state variables
     std::atomic<PlaybackState> playbackState_;
     std::atomic<float> volume_;
+    std::atomic<uint16_t> volumeQ15_;      // Master volume for the fixed-point kernel
     std::atomic<float> audioIntensity_;
     
-    // Pico Extras I2S components
+    // Pico Extras I2S components; the producer pool lives in a static arena
+    AudioBufferPool producerPool_;
     audio_buffer_pool_t* bufferPool_;
     audio_format_t audioFormat_;
     const audio_format_t* actualI2SFormat_;  // Store the actual format returned by I2S
@@ -189,15 +650,173 @@ private:
     int pio_sm_;        // Track which state machine we're using
     
     // Timer-based audio streaming
+    static constexpr int32_t STREAM_POLL_MS = 5;     // Timer period when it is the only refill source
+    static constexpr int32_t FALLBACK_POLL_MS = 20;  // Timer period behind the release-driven refill
     repeating_timer_t audioStreamingTimer_;
+    std::atomic<bool> streamingActive_;
+    
+    // Software IRQ pended when I2S releases a buffer (Timer mode), -1 if unused
+    int refillIrq_;
+    std::atomic<uint32_t> refillRequests_;
     
     // Timer for audio worker instead of multicore
     repeating_timer_t audioWorkerTimer_;
     
-    // Current audio data
-    const int16_t* currentAudioData_;
-    std::atomic<size_t> currentAudioSize_;
-    std::atomic<size_t> currentAudioPosition_;
+    // Mixer commands posted by core0 and applied by the buffer producer
+    struct AudioCommand {
+        enum class Type : uint8_t {
+            Play,
+            Queue,
+            Synth,
+            SynthRelease,
+            DalekStart,
+            DalekStop,
+            StopAll
+        };
+        Type type;
+        const Audio::AudioFile* file;
+        uint16_t gain;
+        AudioMixer::VoicePriority priority;
+        uint32_t skipSamples = 0;   // Output samples already sent by a hot start
+        const SynthPatch* patch = nullptr;
+        SynthEngine::NoteId note = SynthEngine::NO_NOTE;
+    };
+    static constexpr size_t COMMAND_QUEUE_SIZE = 16;
+    SpscRing<AudioCommand, COMMAND_QUEUE_SIZE> commands_;
+    
+    // Voice mixer and synthesiser, owned by the buffer producer context
+    AudioMixer mixer_;
+    SynthEngine synth_;
+    std::atomic<uint32_t> synthPitch_;      // Note (high 16 bits) and Q12 pitch scale handed to synth_ each fill
+    std::atomic<SynthEngine::NoteId> nextSynthNote_;
+    // Published by the producer for isSynthPlaying(): the latest note it
+    // has started, stored after the notes sounding on each voice
+    std::atomic<SynthEngine::NoteId> synthNotesStarted_;
+    std::atomic<SynthEngine::NoteId> synthNotes_[SynthEngine::MAX_VOICES];
+    std::atomic<uint16_t> speechPitchQ12_;  // Speech pitch handed to mixer_ each fill
+    std::atomic<size_t> activeVoices_;
+    
+    // Tempo correction for bent speech; pulls its input from mixer_
+    TimeStretch stretch_;
+    std::atomic<bool> stretching_;
+    std::atomic<uint32_t> lastStretchCycles_;
+    std::atomic<uint32_t> peakStretchCycles_;
+    
+    // Speaker EQ and dynamics on the mono bus, ahead of master volume
+    using OutputChain = AudioDsp::DspChain<AudioDsp::DcBlocker, AudioDsp::Biquad, AudioDsp::Biquad,
+                                           AudioDsp::Compressor, AudioDsp::SoftLimiter>;
+    OutputChain outputChain_;
+    
+    // Live microphone through the Dalek voice effect. dalekActive_ is the
+    // caller's view; dalekRunning_ follows it through the command ring.
+    static constexpr size_t MIC_CHUNK = 64;        // Samples processed per step
+    MicCapture mic_;
+    DalekVoice dalek_;
+    std::atomic<bool> dalekActive_;
+    bool dalekRunning_;
+    std::atomic<uint32_t> lastMicLatencyUs_;
+    std::atomic<uint32_t> peakMicLatencyUs_;
+    std::atomic<uint32_t> micDroppedSamples_;
+    std::atomic<uint32_t> micUnderruns_;
+    std::atomic<uint32_t> lastDalekCycles_;
+    std::atomic<uint32_t> peakDalekCycles_;
+    std::atomic<uint16_t> dalekMinGain_;
+    
+    // Core1 producer loop
+    static constexpr uint32_t CORE1_POLL_US = 250;
+    std::atomic<bool> core1Running_;
+    std::atomic<bool> core1Exited_;
+    
+    // Pipeline health counters
+    std::atomic<uint32_t> underruns_;
+    std::atomic<uint32_t> overruns_;
+    std::atomic<uint32_t> buffersProduced_;
+    std::atomic<uint32_t> playbackEnds_;    // Counted in the fill, printed by dumpStats()
+    std::atomic<uint32_t> droppedTriggers_;
+    std::atomic<bool> primed_;          // A buffer was queued in this playback session
+    std::atomic<uint32_t> queuedSamples_;   // Frames given to I2S and not yet taken by it
+    std::atomic<uint32_t> queueDepth_[QUEUE_DEPTH_BINS];
+    
+    // Rate and mean fill cost, published once per window by the producer
+    static constexpr uint32_t STATS_WINDOW_US = 1000000;
+    uint32_t statsWindowStartUs_;
+    uint32_t windowBuffers_;
+    uint32_t windowFills_;
+    uint64_t windowFillCycles_;
+    std::atomic<uint32_t> buffersPerSecond_;
+    std::atomic<uint32_t> avgFillCycles_;
+    
+    // Adaptive queue depth, adjusted by the producer between bufferCount
+    // and maxBufferCount
+    static constexpr uint32_t ADAPT_HEADROOM_PERCENT = 75;  // Fill cost that counts as tight
+    static constexpr uint32_t ADAPT_SHRINK_US = 2000000;    // Calm time before parking a buffer
+    uint32_t adaptUnderruns_;           // underruns_ when last checked
+    uint32_t adaptFills_;               // buffersProduced_ when last checked
+    uint32_t adaptPressureUs_;          // Last grow, shrink or pressure
+    std::atomic<uint32_t> peakBufferDepth_;
+    std::atomic<uint32_t> depthGrows_;
+    std::atomic<uint32_t> depthShrinks_;
+    
+    // Zero-copy DMA path; owns the PIO FIFO while directActive_ is set
+    DirectPlayback direct_;
+    std::atomic<bool> directActive_;
+    const Audio::AudioFile* directFile_;
+    
+    // Pico Extras connection shared by our pool and the I2S consumer
+    audio_connection_t* connection_;
+    static audio_buffer_t* (*s_consumerTake)(audio_connection_t* connection, bool block);
+    
+    // Playout-aligned intensity: stamped into audio_buffer_t::user_data at
+    // fill time, published when the I2S consumer takes the buffer
+    std::atomic<uint32_t> playoutStartUs_;
+    std::atomic<uint32_t> lastFillLeadUs_;
+    std::atomic<uint32_t> peakFillLeadUs_;
+    
+    // Hot start: first output buffer of every registered clip (mono, unity
+    // gain) and the queued silent buffer a trigger may overwrite
+    std::unique_ptr<int16_t[]> hotStartClips_;
+    size_t hotStartClipCount_;
+    audio_buffer_t* volatile hotBuffer_;
+    
+    // Trigger latency measurement
+    std::atomic<uint32_t> triggerUs_;
+    std::atomic<bool> triggerPending_;
+    std::atomic<uint32_t> lastTriggerLatencyUs_;
+    std::atomic<uint32_t> peakTriggerLatencyUs_;
+    std::atomic<uint32_t> hotStarts_;
+    std::atomic<uint32_t> latencySamples_;
+    
+    // Decoded clips in PSRAM, filled a slice per timer tick on core0
+    static constexpr int32_t CACHE_FILL_MS = 10;
+    static constexpr size_t CACHE_FILL_SAMPLES = 4096;
+    PsramAllocator psram_;
+    ClipCache clipCache_;
+    ClipShuffle shuffle_;                       // playRandomAudio() order, dealt on first use
+    repeating_timer_t cacheFillTimer_;
+    bool cacheFillActive_;
+    
+    // SRAM windows the mixer voices read instead of XIP
+    ClipPrefetcher prefetcher_;
+    
+    // Auto-standby, checked by a slow timer that only runs while awake
+    static constexpr int32_t STANDBY_POLL_MS = 250;
+    static constexpr uint32_t AMP_STARTUP_US = 1000;  // MAX98357A turn-on time after SD rises
+    repeating_timer_t standbyTimer_;
+    bool standbyTimerActive_;
+    std::atomic<bool> standby_;
+    std::atomic<uint32_t> lastActiveUs_;
+    std::atomic<uint32_t> standbyEntries_;
+    std::atomic<uint32_t> wakes_;
+    std::atomic<uint32_t> ampWarmupSamples_;  // Silence still owed to the amplifier's start-up
+    std::atomic<bool> wakePending_;     // The pending trigger latency includes a wake
+    std::atomic<uint32_t> lastWakeLatencyUs_;
+    std::atomic<uint32_t> peakWakeLatencyUs_;
+    
+    // Buffer fill cost measurement
+    std::atomic<uint32_t> lastFillCycles_;
+    std::atomic<uint32_t> peakFillCycles_;
+    std::atomic<uint32_t> minFillCycles_;
+    uint32_t fillBudgetCycles_;
     
     // Multicore synchronization
     static AudioController* instance_;
@@ -210,12 +829,43 @@ private:
     static void audioCallback(void* userData);
     
     /**
-     * @brief Fill audio buffer with current PCM data
+     * @brief Fill audio buffer with the mix of all active voices
      * 
      * @param buffer Buffer to fill
      * @return Number of samples written
      */
     size_t fillAudioBuffer(audio_buffer_t* buffer);
+
+    /**
+     * @brief Fill a whole buffer with silence stamped with zero intensity
+     */
+    void fillSilence(audio_buffer_t* buffer);
+    
+    /**
+     * @brief Mix the bus through the stretcher when bent speech needs its tempo back
+     * 
+     * @return Samples of audio written, as from AudioMixer::mix()
+     */
+    size_t mixSpeech(int16_t* out, size_t count);
+    
+    /**
+     * @brief TimeStretch source: the mixer's next samples
+     */
+    static size_t mixerSource(int16_t* out, size_t count, void* context);
+    
+    /**
+     * @brief Apply the speaker tuning to every stage of @p chain
+     */
+    static void configureOutputChain(OutputChain& chain, uint32_t sampleRate);
+    
+    /**
+     * @brief Add one buffer of processed microphone audio onto @p out
+     * 
+     * Reads the oldest unread mic samples, dropping backlog beyond one
+     * buffer so latency cannot build up and padding with silence when
+     * capture is behind.
+     */
+    void renderDalekVoice(int16_t* out, size_t count);
     
     /**
      * @brief Start timer-based audio streaming (single-core alternative to multicore)
@@ -223,12 +873,164 @@ private:
     void startTimerBasedAudioStreaming();
     
     /**
-     * @brief Calculate audio intensity for LED effects
+     * @brief Fill and queue free buffers (non-blocking)
+     * 
+     * @param maxBuffers Upper bound on buffers filled in this call
+     * @return false once playback reached the end of every voice
+     */
+    bool produceBuffers(uint maxBuffers);
+    
+    /**
+     * @brief Post a command to the producer context
+     * 
+     * @return false if the command ring is full
+     */
+    bool postCommand(const AudioCommand& command);
+    
+    /**
+     * @brief Apply queued commands to the mixer (producer context only)
+     */
+    void processCommands();
+    
+    /**
+     * @brief Publish the notes synth_ is sounding for isSynthPlaying()
+     */
+    void publishSynthNotes(SynthEngine::NoteId started);
+    
+    /**
+     * @brief Count a produced buffer and close the stats window when it is due
+     */
+    void updateStatsWindow();
+    
+    /**
+     * @brief Grow the queue after an underrun or a tight fill, shrink it after a calm spell
+     *
+     * Producer context only.
+     */
+    void adaptBufferDepth();
+    
+    /**
+     * @brief Launch / stop the core1 producer loop
+     */
+    void startCore1Engine();
+    void stopCore1Engine();
+    static void core1Entry();
+    void core1Loop();
+    
+    /**
+     * @brief Wrap the I2S consumer's take callback
+     * 
+     * Counts underruns and requests a refill each time I2S moves on to
+     * its next buffer.
+     */
+    void installConnectionHooks();
+    static audio_buffer_t* consumerTakeHook(audio_connection_t* connection, bool block);
+    
+    /**
+     * @brief Claim / release the software IRQ used for release-driven refill
+     */
+    void setupRefillIrq();
+    void releaseRefillIrq();
+    static void refillIrqHandler();
+    
+    /**
+     * @brief Leave direct playback and restart the pico-extras I2S DMA
+     * 
+     * Safe from the DMA completion IRQ and from thread context.
+     */
+    void finishDirectPlayback();
+    static void onDirectComplete();
+    
+    /**
+     * @brief Map PSRAM and start filling the clip cache
+     */
+    void setupClipCache();
+    
+    /**
+     * @brief Mixer release callback: unpin a cached clip
+     */
+    static void onVoiceReleased(const Audio::AudioFile* file, void* context);
+    
+    /**
+     * @brief Track LED intensity at the position DMA is sending
+     */
+    void serviceDirectPlayback();
+    
+    /**
+     * @brief Wake the producer context so it refills free buffers now
+     * 
+     * Safe to call from the I2S DMA IRQ and from thread context on core0.
+     */
+    void requestRefill();
+    
+    /**
+     * @brief Update audio intensity for LED effects
+     * 
+     * @param envelopeLevel Precomputed clip loudness (0-255) before master volume
+     */
+    void updateAudioIntensity(uint8_t envelopeLevel);
+    
+    /**
+     * @brief Render the first buffer of every registered clip into SRAM
+     * 
+     * Runs before streaming starts, using the mixer as the renderer.
+     */
+    void prerenderHotStartClips();
+    
+    /**
+     * @brief Overwrite the queued silent buffer with a clip's first buffer
+     * 
+     * @return false if no silent buffer is queued or voices are active
+     */
+    bool tryHotStart(Audio::AudioIndex audioIndex, const Audio::AudioFile* file,
+                     uint16_t gainQ15, AudioMixer::VoicePriority priority);
+    
+    /**
+     * @brief true while the pipeline should keep streaming silence
+     */
+    bool keepAlive() const { return hotStartClips_ != nullptr && !standby_; }
+    
+    /**
+     * @brief true when nothing is playing, queued or live
+     */
+    bool isIdle() const;
+    
+    /**
+     * @brief Start the timer that puts the pipeline in standby once idle
+     */
+    void startStandbyTimer();
+    static bool standbyTimerCallback(repeating_timer_t* timer);
+    
+    /**
+     * @brief Stop the I2S PIO and DMA and shut the amplifier down
+     * 
+     * Runs in the standby timer's IRQ, which never nests with the refill IRQ.
+     */
+    void enterStandby();
+    
+    /**
+     * @brief Restart I2S on silence and enable the amplifier
+     * 
+     * Called by every entry point that makes sound; returns at once when
+     * the pipeline is awake. Never waits: if one buffer of silence is
+     * shorter than AMP_STARTUP_US, the producer queues more ahead of
+     * the trigger's audio (ampWarmupSamples_).
+     * 
+     * @return true if the pipeline was in standby
+     */
+    bool wakeFromStandby();
+    
+    /**
+     * @brief Record trigger latency for a buffer reaching DMA
+     */
+    void measureTriggerLatency(const audio_buffer_t* buffer);
+    
+    /**
+     * @brief Publish a buffer's intensity stamp as it starts playing
      * 
-     * @param samples PCM samples to analyze
-     * @param sampleCount Number of samples
+     * @param stamp audio_buffer_t::user_data written by fillAudioBuffer()
      */
-    void updateAudioIntensity(const int16_t* samples, size_t sampleCount);
+    void publishPlayoutIntensity(uint32_t stamp);
     
     /**
      * @brief Timer-based audio worker disabled due to multicore conflicts
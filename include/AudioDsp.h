@@ -0,0 +1,388 @@
+#pragma once
+
+#include "SineTable.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+namespace Exterminate::AudioDsp {
+
+/**
+ * @brief Fixed-point processing stages and the chain that composes them
+ *
+ * A stage works in place on a block of int32_t samples at 16-bit scale
+ * (headroom above full scale is allowed between stages) through
+ *
+ *     static constexpr const char* NAME;
+ *     void reset();
+ *     void process(int32_t* samples, size_t count);
+ *
+ * DspChain<Stages...> fixes the stage list at compile time, so every
+ * process() call is resolved and inlined with no virtual dispatch.
+ * Coefficients are computed in float by each stage's configure(); the
+ * per-sample paths are integer-only. None of this depends on the Pico
+ * SDK, so tools/host builds the same code.
+ */
+
+constexpr size_t BLOCK_SAMPLES = 64;       ///< Samples each stage runs over per pass
+constexpr int32_t UNITY_Q15 = 32768;
+
+inline int32_t saturate16(int32_t value) {
+    return std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, value));
+}
+
+/**
+ * @brief One-pole DC blocker: y[n] = x[n] - x[n-1] + p * y[n-1]
+ */
+class DcBlocker {
+public:
+    static constexpr const char* NAME = "dc blocker";
+
+    void configure(float cornerHz, uint32_t sampleRate);
+    void reset() { x1_ = y1_ = 0; }
+
+    void process(int32_t* samples, size_t count) {
+        int32_t x1 = x1_;
+        int32_t y1 = y1_;
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t x = samples[i];
+            y1 = x - x1 + static_cast<int32_t>((static_cast<int64_t>(y1) * pole_) >> 15);
+            x1 = x;
+            samples[i] = y1;
+        }
+        x1_ = x1;
+        y1_ = y1;
+    }
+
+private:
+    int32_t pole_ = 32604;    // Q15, ~35 Hz at 44.1 kHz
+    int32_t x1_ = 0;
+    int32_t y1_ = 0;
+};
+
+/**
+ * @brief Constant Q8 gain, saturated to 16 bits
+ */
+class Gain {
+public:
+    static constexpr const char* NAME = "gain";
+
+    void configure(uint16_t gainQ8) { gainQ8_ = gainQ8; }
+    void reset() {}
+
+    void process(int32_t* samples, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] = saturate16((samples[i] * gainQ8_) >> 8);
+        }
+    }
+
+private:
+    int32_t gainQ8_ = 256;
+};
+
+/**
+ * @brief Multiply by a low-frequency sine from the shared table
+ */
+class RingModulator {
+public:
+    static constexpr const char* NAME = "ring modulator";
+
+    void configure(float frequencyHz, uint32_t sampleRate);
+    void reset() { phase_ = 0; }
+
+    void process(int32_t* samples, size_t count) {
+        uint32_t phase = phase_;
+        for (size_t i = 0; i < count; ++i) {
+            samples[i] = static_cast<int32_t>((static_cast<int64_t>(samples[i]) * SineTable::lookup(phase)) >> 15);
+            phase += step_;
+        }
+        phase_ = phase;
+    }
+
+private:
+    uint32_t phase_ = 0;
+    uint32_t step_ = 0;
+};
+
+/**
+ * @brief Direct form I second-order section with Q28 coefficients
+ *
+ * Designs follow the RBJ audio EQ cookbook. The part of each output cut
+ * off by the shift is carried into the next sample (first-order error
+ * feedback); otherwise low corners, whose poles sit close to 1, amplify
+ * the rounding into noise and DC.
+ */
+class Biquad {
+public:
+    static constexpr const char* NAME = "biquad";
+    static constexpr int COEFF_SHIFT = 28;
+
+    enum class Type : uint8_t {
+        Bypass,
+        LowPass,
+        HighPass,
+        Peaking,
+        LowShelf,
+        HighShelf
+    };
+
+    struct Config {
+        Type type;
+        float frequencyHz;
+        float q;          ///< 0.7071 for Butterworth; shelves use it as the slope
+        float gainDb;     ///< Peaking and shelf types only
+    };
+
+    void configure(const Config& config, uint32_t sampleRate);
+    void reset() { x1_ = x2_ = y1_ = y2_ = error_ = 0; }
+
+    void process(int32_t* samples, size_t count) {
+        int32_t x1 = x1_, x2 = x2_, y1 = y1_, y2 = y2_;
+        int32_t error = error_;
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t x = samples[i];
+            const int64_t acc = static_cast<int64_t>(b0_) * x
+                              + static_cast<int64_t>(b1_) * x1
+                              + static_cast<int64_t>(b2_) * x2
+                              - static_cast<int64_t>(a1_) * y1
+                              - static_cast<int64_t>(a2_) * y2
+                              + error;
+            const int32_t y = static_cast<int32_t>(acc >> COEFF_SHIFT);
+            error = static_cast<int32_t>(acc - static_cast<int64_t>(y) * (int64_t(1) << COEFF_SHIFT));
+            x2 = x1;
+            x1 = x;
+            y2 = y1;
+            y1 = y;
+            samples[i] = y;
+        }
+        x1_ = x1; x2_ = x2; y1_ = y1; y2_ = y2;
+        error_ = error;
+    }
+
+private:
+    int32_t b0_ = 1 << COEFF_SHIFT;
+    int32_t b1_ = 0, b2_ = 0, a1_ = 0, a2_ = 0;
+    int32_t x1_ = 0, x2_ = 0, y1_ = 0, y2_ = 0;
+    int32_t error_ = 0;
+};
+
+/**
+ * @brief Feed-forward compressor with make-up gain
+ *
+ * A one-pole peak follower runs every sample. The gain curve is
+ * evaluated every CONTROL_SAMPLES from the follower, and the gain is
+ * ramped linearly towards it so changes never step.
+ */
+class Compressor {
+public:
+    static constexpr const char* NAME = "compressor";
+    static constexpr size_t CONTROL_SAMPLES = 16;
+    static constexpr int GAIN_SHIFT = 12;             ///< Q12 gain, up to 8x
+
+    struct Config {
+        float thresholdDb;    ///< dBFS where compression starts
+        float ratio;          ///< Input dB per output dB above the threshold
+        float attackMs;
+        float releaseMs;
+        float makeupDb;
+    };
+
+    void configure(const Config& config, uint32_t sampleRate);
+    void reset();
+
+    void process(int32_t* samples, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (countdown_ == 0) {
+                updateGain();
+            }
+            --countdown_;
+
+            const int32_t x = samples[i];
+            const int32_t magnitude = x < 0 ? -x : x;
+            const int32_t coeff = magnitude > envelope_ ? attack_ : release_;
+            envelope_ += static_cast<int32_t>((static_cast<int64_t>(magnitude - envelope_) * coeff) >> 15);
+
+            gain_ += gainStep_;
+            samples[i] = static_cast<int32_t>((static_cast<int64_t>(x) * gain_) >> GAIN_SHIFT);
+        }
+    }
+
+    /**
+     * @brief Gain applied at the end of the last block (Q12)
+     */
+    int32_t currentGain() const { return gain_; }
+
+private:
+    float thresholdDb_ = 0.0f;
+    float slope_ = 0.0f;          // 1 - 1/ratio
+    float makeupDb_ = 0.0f;
+    int32_t threshold_ = INT32_MAX;   // Follower level where compression starts
+    int32_t makeupGain_ = 1 << GAIN_SHIFT;
+    int32_t attack_ = UNITY_Q15;  // Q15 follower coefficients
+    int32_t release_ = UNITY_Q15;
+    int32_t envelope_ = 0;
+    int32_t gain_ = 1 << GAIN_SHIFT;
+    int32_t gainStep_ = 0;
+    size_t countdown_ = 0;
+
+    void updateGain();
+};
+
+/**
+ * @brief Soft-knee clipper: linear below the knee, bends smoothly to the ceiling
+ *
+ * Above the knee the excess t is mapped to r * t / (t + r), with r the
+ * room between knee and ceiling, so the output never reaches the ceiling
+ * and never overshoots. Only samples above the knee pay for the divide.
+ */
+class SoftLimiter {
+public:
+    static constexpr const char* NAME = "soft limiter";
+
+    void configure(int32_t knee, int32_t ceiling);
+    void reset() {}
+
+    void process(int32_t* samples, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t x = samples[i];
+            const int32_t magnitude = x < 0 ? -x : x;
+            if (magnitude > knee_) {
+                const int32_t excess = magnitude - knee_;
+                const int32_t bent = knee_ + static_cast<int32_t>((static_cast<int64_t>(room_) * excess) / (excess + room_));
+                samples[i] = x < 0 ? -bent : bent;
+            }
+        }
+    }
+
+private:
+    int32_t knee_ = 26000;
+    int32_t room_ = 6767;
+};
+
+/**
+ * @brief Peak limiter: instant attack, exponential release
+ *
+ * Keeps the output at or below the ceiling and records the lowest gain
+ * applied, to show how hard it is working.
+ */
+class PeakLimiter {
+public:
+    static constexpr const char* NAME = "peak limiter";
+
+    void configure(int32_t ceiling, float releaseMs, uint32_t sampleRate);
+    void reset() { envelope_ = 0; minGain_ = UNITY_Q15; }
+
+    void process(int32_t* samples, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            const int32_t x = samples[i];
+            const int32_t magnitude = x < 0 ? -x : x;
+            if (magnitude > envelope_) {
+                envelope_ = magnitude;
+            } else {
+                envelope_ -= envelope_ >> releaseShift_;
+            }
+            const int32_t gain = envelope_ > ceiling_ ? (ceiling_ << 15) / envelope_ : UNITY_Q15;
+            minGain_ = std::min(minGain_, gain);
+            samples[i] = static_cast<int32_t>((static_cast<int64_t>(x) * gain) >> 15);
+        }
+    }
+
+    /**
+     * @brief Lowest gain (Q15) since the last call; 32767 when not limiting
+     */
+    uint16_t takeMinGain() {
+        const int32_t gain = minGain_;
+        minGain_ = UNITY_Q15;
+        return static_cast<uint16_t>(std::min<int32_t>(gain, INT16_MAX));
+    }
+
+private:
+    int32_t ceiling_ = 28000;
+    int32_t releaseShift_ = 12;   // Envelope time constant of 2^shift samples
+    int32_t envelope_ = 0;
+    int32_t minGain_ = UNITY_Q15;
+};
+
+/**
+ * @brief Compile-time pipeline of stages over PCM16 blocks
+ *
+ * Samples are widened to int32_t, run through every stage in order
+ * BLOCK_SAMPLES at a time, and saturated back to 16 bits.
+ */
+template <typename... Stages>
+class DspChain {
+public:
+    static constexpr size_t STAGE_COUNT = sizeof...(Stages);
+
+    template <size_t Index>
+    auto& stage() { return std::get<Index>(stages_); }
+
+    template <size_t Index>
+    const auto& stage() const { return std::get<Index>(stages_); }
+
+    static const char* stageName(size_t index) {
+        static constexpr const char* names[] = {Stages::NAME...};
+        return index < STAGE_COUNT ? names[index] : "";
+    }
+
+    void reset() {
+        std::apply([](auto&... stage) { (stage.reset(), ...); }, stages_);
+    }
+
+    /**
+     * @brief Run every stage over @p count samples; @p in and @p out may alias
+     */
+    void process(const int16_t* in, int16_t* out, size_t count) {
+        for (size_t offset = 0; offset < count; offset += BLOCK_SAMPLES) {
+            const size_t block = std::min(BLOCK_SAMPLES, count - offset);
+            load(in + offset, block);
+            std::apply([&](auto&... stage) { (stage.process(block_, block), ...); }, stages_);
+            store(out + offset, block);
+        }
+    }
+
+    /**
+     * @brief process(), adding each stage's elapsed ticks to @p ticks
+     *
+     * @param clock Callable returning a free-running uint32_t tick count
+     *              (CycleCounter::now on the target, a ns clock on a host)
+     */
+    template <typename Clock>
+    void processProfiled(const int16_t* in, int16_t* out, size_t count,
+                         uint32_t (&ticks)[STAGE_COUNT], Clock&& clock) {
+        for (size_t offset = 0; offset < count; offset += BLOCK_SAMPLES) {
+            const size_t block = std::min(BLOCK_SAMPLES, count - offset);
+            load(in + offset, block);
+            runTimed(block, ticks, clock, std::index_sequence_for<Stages...>{});
+            store(out + offset, block);
+        }
+    }
+
+private:
+    std::tuple<Stages...> stages_;
+    int32_t block_[BLOCK_SAMPLES];
+
+    void load(const int16_t* in, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            block_[i] = in[i];
+        }
+    }
+
+    void store(int16_t* out, size_t count) const {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<int16_t>(saturate16(block_[i]));
+        }
+    }
+
+    template <typename Clock, size_t... Index>
+    void runTimed(size_t count, uint32_t (&ticks)[STAGE_COUNT], Clock& clock, std::index_sequence<Index...>) {
+        uint32_t start = clock();
+        ((std::get<Index>(stages_).process(block_, count),
+          ticks[Index] += clock() - start,
+          start = clock()), ...);
+    }
+};
+
+} // namespace Exterminate::AudioDsp
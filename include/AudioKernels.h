@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate::AudioKernels {
+
+/**
+ * @brief Convert a float volume (0.0 to 1.0) to Q15 (32768 = 1.0)
+ */
+uint16_t volumeToQ15(float volume);
+
+/**
+ * @brief Reference sample path: float volume, clamp, per-channel loop
+ *
+ * Expands @p count mono samples at the front of @p samples into
+ * @p channels interleaved channels in place. Kept as the baseline the
+ * fixed-point kernel is benchmarked against.
+ */
+void monoToInterleavedReference(int16_t* samples, size_t count, uint16_t channels, float volume);
+
+/**
+ * @brief Fixed-point mono to stereo S16 kernel
+ *
+ * Expands @p count mono samples at the front of @p samples into
+ * interleaved stereo in place, scaling by a Q15 volume. Uses the
+ * Cortex-M33 DSP extension (SMULW/SSAT/PKHBT) when available, with a
+ * portable C++ fallback; both write one 32-bit L/R frame per store.
+ *
+ * @p samples must be 4-byte aligned and hold 2 * @p count samples.
+ */
+void monoToStereoQ15(int16_t* samples, size_t count, uint16_t volumeQ15);
+
+/**
+ * @brief true if monoToStereoQ15() was compiled with DSP instructions
+ */
+bool hasDspExtension();
+
+} // namespace Exterminate::AudioKernels
@@ -0,0 +1,228 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include "ClipReader.h"
+#include "ClipPrefetcher.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Fixed-point multi-voice mixer for embedded PCM clips
+ *
+ * Sums up to MAX_VOICES clips into a mono 16-bit bus. Compressed clips
+ * are decoded MIX_CHUNK samples at a time as they are mixed. Clips stored
+ * at another rate than the output are converted on the fly by a Q16
+ * phase-accumulator linear interpolator, so speech can live in flash at
+ * 16-22.05 kHz. The same converter bends the pitch of speech voices
+ * (varispeed) when setSpeechPitch() moves off unity. Each voice is
+ * scaled by its own Q15 gain, accumulated in 32 bits and saturated once
+ * per output sample. When every voice is busy a new clip steals the
+ * lowest-priority voice (oldest first), so gun, speech and ambience
+ * clips can overlap without cutting each other off. Looping clips and
+ * queued follow-on clips are handled by each voice's ClipReader, so a
+ * voice never drops a sample at a loop wrap or a chained clip's seam.
+ *
+ * The mixer is not thread-safe; the owner serialises access between the
+ * trigger path and the buffer producer.
+ */
+class AudioMixer {
+public:
+    static constexpr size_t MAX_VOICES = 6;       ///< Voices mixed per output sample
+    static constexpr size_t MIX_CHUNK = 64;       ///< Samples accumulated per inner pass
+    static constexpr uint16_t UNITY_GAIN = 32768; ///< Q15 gain of 1.0
+    static constexpr uint32_t MAX_RATE_RATIO = 2; ///< Highest clip rate as a multiple of the output rate
+    static constexpr uint16_t PITCH_UNITY = 4096; ///< Q12 speech pitch of 1.0
+
+    /**
+     * @brief Voice priorities used for stealing decisions (higher wins)
+     */
+    enum class VoicePriority : uint8_t {
+        Ambient = 0,  ///< Background loops and hums
+        Effect = 1,   ///< Guns, zaps and other one-shots
+        Speech = 2    ///< Dalek dialogue
+    };
+
+    /**
+     * @brief Called when a voice stops using its clip (end, stop or steal)
+     */
+    using ReleaseCallback = void (*)(const Audio::AudioFile* file, void* context);
+
+    AudioMixer();
+
+    /**
+     * @brief Be told when each voice lets go of its clip
+     *
+     * Runs in whatever context calls startVoice(), stopAll() or mix().
+     */
+    void setReleaseCallback(ReleaseCallback callback, void* context);
+
+    /**
+     * @brief Read clips through DMA-prefetched SRAM windows
+     *
+     * Voice n uses prefetcher->stream(n). Applies to voices started
+     * afterwards; nullptr reads XIP directly.
+     */
+    void setPrefetcher(ClipPrefetcher* prefetcher);
+
+    /**
+     * @brief Set the bus sample rate clips are converted to
+     *
+     * Applies to voices started afterwards.
+     */
+    void setOutputRate(uint32_t sampleRate);
+    uint32_t getOutputRate() const { return outputRate_; }
+
+    /**
+     * @brief Play Speech voices faster or slower, raising or lowering their pitch
+     *
+     * Takes effect at the next mix() chunk, on playing voices too. The
+     * combined clip and pitch step is capped at MAX_RATE_RATIO, so a
+     * native-rate clip bends at most one octave up.
+     *
+     * @param scaleQ12 Q12 rate multiplier (PITCH_UNITY = 1.0)
+     */
+    void setSpeechPitch(uint16_t scaleQ12);
+    uint16_t getSpeechPitch() const { return speechPitch_; }
+
+    /**
+     * @brief Start a clip on a free or stolen voice
+     *
+     * @param file Clip to play
+     * @param gain Q15 voice gain (UNITY_GAIN = 1.0)
+     * @param priority Priority used for stealing
+     * @param skipSamples Output samples to skip (already played from elsewhere)
+     * @return Voice slot, or -1 if every voice is busy with a higher priority
+     *         or the clip rate exceeds MAX_RATE_RATIO times the output rate
+     */
+    int startVoice(const Audio::AudioFile* file, uint16_t gain, VoicePriority priority,
+                   size_t skipSamples = 0);
+
+    /**
+     * @brief Play @p file gaplessly after the most recently started voice
+     *
+     * The voice's current clip stops looping and plays to its end, then
+     * @p file follows on the same voice, gain and priority. With no voice
+     * playing, @p file starts on a new voice instead.
+     *
+     * @return Voice slot, or -1 if that voice already has a clip queued,
+     *         @p file has another sample rate or no voice could start
+     */
+    int queueVoice(const Audio::AudioFile* file, uint16_t gain, VoicePriority priority);
+
+    /**
+     * @brief Silence a single voice
+     */
+    void stopVoice(int voice);
+
+    /**
+     * @brief Silence every voice
+     */
+    void stopAll();
+
+    /**
+     * @brief Mix all active voices into a mono buffer
+     *
+     * Always writes @p sampleCount samples (silence past the end of the
+     * longest voice).
+     *
+     * @param out Destination mono samples
+     * @param sampleCount Samples to produce
+     * @return Number of leading samples that carried clip data
+     */
+    size_t mix(int16_t* out, size_t sampleCount);
+
+    /**
+     * @brief Number of voices currently playing
+     */
+    size_t activeVoiceCount() const;
+
+    /**
+     * @brief Loudest precomputed envelope level among active voices
+     *
+     * Looks up each voice's clip envelope at its read position and scales
+     * it by the voice gain; no sample math.
+     *
+     * @return 0-255 loudness (0 when idle or clips carry no envelope)
+     */
+    uint8_t envelopeLevel() const;
+
+    /**
+     * @brief Precomputed loudness of @p file around clip sample @p position
+     *
+     * @return 0-255 loudness (0 if the clip carries no envelope)
+     */
+    static uint8_t envelopeAt(const Audio::AudioFile* file, size_t position);
+
+    /**
+     * @brief true if any voice is playing
+     */
+    bool isActive() const { return activeVoiceCount() > 0; }
+
+private:
+    static constexpr uint32_t PHASE_ONE = 1u << 16;  ///< Q16 step of one clip sample
+
+    struct Voice {
+        ClipReader reader;        ///< Clip and decoder state
+        uint16_t gain;            ///< Q15 gain
+        VoicePriority priority;
+        uint32_t startOrder;      ///< Monotonic start stamp for oldest-first stealing
+        bool active;
+
+        // Rate conversion (unused until a step other than PHASE_ONE is needed)
+        uint32_t phaseStep;       ///< Q16 clip samples per output sample, before pitch
+        bool interpolating;       ///< current/next are primed; stays set for the clip
+        uint32_t phase;           ///< Q16 position between current and next
+        int16_t current;          ///< Clip sample at the integer position
+        int16_t next;             ///< Following clip sample (0 past the end)
+        bool nextValid;           ///< false once next lies past the end
+    };
+
+    Voice voices_[MAX_VOICES];
+    int32_t accumulator_[MIX_CHUNK];
+    int16_t decodeBuffer_[MIX_CHUNK * MAX_RATE_RATIO + 1];
+    uint32_t startCounter_;
+    uint32_t outputRate_;
+    uint16_t speechPitch_;
+    ReleaseCallback releaseCallback_;
+    void* releaseContext_;
+    ClipPrefetcher* prefetcher_;
+
+    int findVoiceSlot(VoicePriority priority) const;
+
+    /**
+     * @brief Q16 clip samples per output sample, 0 if the clip rate is too high
+     */
+    uint32_t phaseStepFor(const Audio::AudioFile* file) const;
+
+    /**
+     * @brief Step of @p voice this chunk, speech pitch included
+     */
+    uint32_t effectiveStep(const Voice& voice) const;
+
+    /**
+     * @brief Load the first two samples into the converter (seamless from native reads)
+     */
+    void primeInterpolator(Voice& voice);
+
+    /**
+     * @brief Read clip samples, reporting a clip the reader chained past
+     */
+    size_t readClip(Voice& voice, int16_t* out, size_t count);
+
+    /**
+     * @brief Deactivate a playing voice and report its clip (and any queued one)
+     */
+    void releaseVoice(Voice& voice);
+
+    /**
+     * @brief Produce up to @p count output samples from a resampled voice
+     *
+     * @param step Q16 clip samples per output sample, at most MAX_RATE_RATIO
+     * @return Samples written to decodeBuffer_ (less at end of clip)
+     */
+    size_t readResampled(Voice& voice, int16_t* out, size_t count, uint32_t step);
+};
+
+} // namespace Exterminate
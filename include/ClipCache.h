@@ -0,0 +1,123 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include "ClipReader.h"
+#include "PsramAllocator.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief LRU cache of decoded clips in PSRAM
+ *
+ * Sits in front of Audio::getAudioFile(): acquire() swaps a registered
+ * clip for a PCM16 copy in PSRAM when one is ready, so the mixer reads
+ * plain samples with no decode and no flash XIP traffic. A miss plays the
+ * original clip and queues it; service() decodes the queued clip a slice
+ * at a time and evicts the least recently used idle clips when PSRAM is
+ * full. Master volume is not baked in, so volume changes never
+ * invalidate the cache.
+ *
+ * acquire() and service() must run on the same core and never preempt
+ * each other; release() may be called from any context.
+ */
+class ClipCache {
+public:
+    static constexpr size_t MAX_ENTRIES = 32;  ///< Clips cached at once
+
+    /**
+     * @brief Cache effectiveness counters
+     */
+    struct Stats {
+        uint32_t hits;        ///< acquire() served from PSRAM
+        uint32_t misses;      ///< acquire() served from flash
+        uint32_t fills;       ///< Clips decoded into PSRAM
+        uint32_t evictions;   ///< Clips dropped to make room
+        size_t bytesUsed;     ///< PSRAM held by cached clips
+        size_t capacity;      ///< PSRAM available to the cache
+        size_t clips;         ///< Clips currently cached
+    };
+
+    ClipCache();
+    ~ClipCache();
+
+    ClipCache(const ClipCache&) = delete;
+    ClipCache& operator=(const ClipCache&) = delete;
+
+    /**
+     * @brief Use @p heap for decoded clips
+     *
+     * @return false if the heap has no PSRAM
+     */
+    bool begin(PsramAllocator* heap);
+
+    /**
+     * @brief Drop every cached clip and detach from the heap
+     *
+     * Only call when no voice is playing a cached clip.
+     */
+    void end();
+
+    bool isReady() const { return heap_ != nullptr; }
+
+    /**
+     * @brief Return the clip the mixer should play for @p source
+     *
+     * On a hit the cached copy is pinned until release(); on a miss
+     * @p source is returned and queued for decoding.
+     */
+    const Audio::AudioFile* acquire(const Audio::AudioFile* source);
+
+    /**
+     * @brief Unpin a clip returned by acquire(); other clips are ignored
+     */
+    void release(const Audio::AudioFile* file);
+
+    /**
+     * @brief Decode up to @p maxSamples of the queued clip into PSRAM
+     */
+    void service(size_t maxSamples);
+
+    Stats getStats() const;
+
+private:
+    struct Entry {
+        const Audio::AudioFile* source;  ///< Registered clip (nullptr if free)
+        Audio::AudioFile file;           ///< PCM16 view handed to the mixer
+        int16_t* samples;                ///< Decoded samples in PSRAM
+        size_t filled;                   ///< Samples decoded so far
+        uint32_t lastUse;                ///< LRU stamp
+        std::atomic<uint16_t> users;     ///< Voices (and queued commands) playing it
+        bool ready;                      ///< Fully decoded
+    };
+
+    static constexpr size_t FILL_SLICE = 256;  ///< Samples staged in SRAM per PSRAM write
+
+    PsramAllocator* heap_;
+    Entry entries_[MAX_ENTRIES];
+    uint32_t useClock_;
+
+    // Clip queued by a miss, and the entry being decoded for it
+    const Audio::AudioFile* pending_;
+    Entry* filling_;
+    ClipReader fillReader_;
+    int16_t fillBuffer_[FILL_SLICE];
+
+    uint32_t hits_;
+    uint32_t misses_;
+    uint32_t fills_;
+    uint32_t evictions_;
+
+    Entry* find(const Audio::AudioFile* source);
+
+    /**
+     * @brief Allocate an entry and PSRAM for @p source, evicting LRU idle clips
+     */
+    Entry* reserve(const Audio::AudioFile* source);
+
+    void evict(Entry& entry);
+};
+
+} // namespace Exterminate
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+class ClipPrefetcher;
+
+/**
+ * @brief Double-buffered SRAM window over one clip's stored bytes
+ *
+ * While the reader consumes one window, DMA copies the next one from
+ * flash (or PSRAM) into the other half, so the audio fill loop only
+ * touches SRAM. Windows are aligned to WINDOW_BYTES from the start of the
+ * clip, which keeps every 256-byte ADPCM block inside a single window.
+ */
+class ClipStream {
+public:
+    static constexpr size_t WINDOW_BYTES = 1024;  ///< Bytes per half
+
+    ClipStream();
+
+    /**
+     * @brief Start streaming @p bytes stored at @p source
+     */
+    void open(const uint8_t* source, size_t bytes);
+
+    /**
+     * @brief Stop streaming; waits for this stream's DMA to finish
+     */
+    void close();
+
+    /**
+     * @brief Clip bytes from @p offset
+     *
+     * Returns SRAM when the window is resident (waiting for it if its DMA
+     * is still running) and the XIP address otherwise. Either way the next
+     * window is queued.
+     *
+     * @param available Set to the bytes readable before the window ends
+     * @return Pointer valid until the next fetch()
+     */
+    const uint8_t* fetch(size_t offset, size_t* available);
+
+    /**
+     * @brief Prefetch the window holding @p toOffset after the one holding @p fromOffset
+     *
+     * Set for a looping clip so the loop start is resident when the
+     * reader wraps. Cleared by clearLoop() and open().
+     */
+    void setLoop(size_t fromOffset, size_t toOffset);
+    void clearLoop();
+
+private:
+    friend class ClipPrefetcher;
+
+    static constexpr uint32_t NO_WINDOW = UINT32_MAX;
+
+    ClipPrefetcher* owner_;
+    const uint8_t* source_;     // Address the CPU reads on a miss
+    uintptr_t dmaSource_;       // Uncached, non-allocating alias read by DMA
+    size_t bytes_;
+    uint32_t window_[2];        // Window held by each half
+    bool loading_[2];           // Half has a DMA transfer in flight
+    uint32_t wantedWindow_;     // Prefetch waiting for the channel
+    uint8_t wantedHalf_;
+    uint32_t loopFrom_;         // Window followed by loopTo_ instead of the next one
+    uint32_t loopTo_;
+
+    alignas(4) uint8_t buffer_[2][WINDOW_BYTES];
+
+    /**
+     * @brief Window the reader moves on to after @p window
+     */
+    uint32_t following(uint32_t window) const { return window == loopFrom_ ? loopTo_ : window + 1; }
+
+    /**
+     * @brief Queue @p window into @p half unless a half already has it
+     */
+    void prefetch(uint32_t window, uint8_t half);
+};
+
+/**
+ * @brief DMA prefetch engine shared by the mixer voices' clip streams
+ *
+ * Owns one DMA channel, used for one window at a time, and counts how the
+ * audio hot path was served. The XIP cache hit/access counters are
+ * sampled too, so the effect on the whole system (BTstack and CYW43 code
+ * also run from flash) can be compared with prefetch turned off.
+ *
+ * Not thread-safe: every stream must be driven from the buffer producer.
+ */
+class ClipPrefetcher {
+public:
+    static constexpr size_t MAX_STREAMS = 6;   ///< One per mixer voice
+
+    /**
+     * @brief Hot path instrumentation
+     */
+    struct Stats {
+        uint32_t hits;         ///< Fetches served from SRAM
+        uint32_t misses;       ///< Fetches that read XIP directly
+        uint32_t stalls;       ///< Hits that waited for their DMA transfer
+        uint32_t stallCycles;  ///< Core cycles spent in those waits
+        uint32_t transfers;    ///< Windows copied by DMA
+        uint32_t xipAccesses;  ///< XIP cache accesses since begin() (all masters)
+        uint32_t xipHits;      ///< XIP cache hits since begin()
+    };
+
+    ClipPrefetcher();
+    ~ClipPrefetcher();
+
+    ClipPrefetcher(const ClipPrefetcher&) = delete;
+    ClipPrefetcher& operator=(const ClipPrefetcher&) = delete;
+
+    /**
+     * @brief Claim a DMA channel and clear the counters
+     *
+     * @return false if no DMA channel is free
+     */
+    bool begin();
+
+    /**
+     * @brief Release the DMA channel; streams fall back to XIP reads
+     */
+    void end();
+
+    bool isReady() const { return channel_ >= 0; }
+
+    /**
+     * @brief Stream reserved for mixer voice @p index (nullptr if out of range)
+     */
+    ClipStream* stream(size_t index);
+
+    /**
+     * @brief Read the counters; the XIP counters work even without begin()
+     */
+    Stats getStats() const;
+
+    /**
+     * @brief Zero the counters, including the XIP cache counters
+     */
+    void resetStats();
+
+private:
+    friend class ClipStream;
+
+    int channel_;
+    ClipStream streams_[MAX_STREAMS];
+
+    // Transfer on the channel, if any
+    ClipStream* busyStream_;
+    uint8_t busyHalf_;
+
+    uint32_t hits_;
+    uint32_t misses_;
+    uint32_t stalls_;
+    uint32_t stallCycles_;
+    uint32_t transfers_;
+
+    /**
+     * @brief Mark the last transfer complete once the channel is idle
+     *
+     * @return true if the channel is free
+     */
+    bool retire();
+
+    /**
+     * @brief Start copying @p window of @p stream into @p half
+     *
+     * @return false if the channel is busy with another transfer
+     */
+    bool startLoad(ClipStream& stream, uint8_t half, uint32_t window);
+
+    /**
+     * @brief Start the first prefetch that is waiting for the channel
+     */
+    void startWanted();
+
+    /**
+     * @brief Block until @p stream has no transfer in flight
+     */
+    void waitFor(ClipStream& stream);
+};
+
+} // namespace Exterminate
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+class ClipStream;
+
+/**
+ * @brief Streaming PCM reader over an embedded clip
+ *
+ * Hides the clip codec from the mixer: PCM16 is copied, mu-law goes
+ * through a 256-entry table and IMA-ADPCM is decoded block by block as
+ * samples are requested, so a compressed clip never needs a full-size
+ * RAM copy. With a ClipStream attached, stored bytes are read from its
+ * DMA-filled SRAM windows instead of straight from XIP.
+ *
+ * Clips with loop points wrap from loop_end back to loop_start inside
+ * read(), and a chained clip set with setNext() continues in the same
+ * read call, so neither costs the caller a gap or a restart.
+ *
+ * A clip whose stored bytes run out before its sample_count is cut short
+ * there and counted in decodeErrorCount(), rather than read forever.
+ */
+class ClipReader {
+public:
+    ClipReader();
+
+    /**
+     * @brief Start reading a clip from its first sample
+     *
+     * @return false if the clip has no usable data
+     */
+    bool open(const Audio::AudioFile* file);
+
+    /**
+     * @brief Detach from the current clip
+     */
+    void close();
+
+    /**
+     * @brief Read the open clip through @p stream (nullptr reads XIP directly)
+     */
+    void setStream(ClipStream* stream);
+
+    /**
+     * @brief Continue with @p next once this clip ends
+     *
+     * Ends the loop of a looping clip, so it plays out its tail (the
+     * samples after loop_end) first. @p next must already be resolved;
+     * it is opened in place, on the same stream, by the read that
+     * reaches the end.
+     *
+     * @return false if a clip is already chained or @p next has no data
+     */
+    bool setNext(const Audio::AudioFile* next);
+
+    /**
+     * @brief Play on past loop_end to the end of the clip
+     */
+    void endLoop();
+
+    /**
+     * @brief Decode up to @p count samples
+     *
+     * Wraps at the loop end and moves on to a chained clip without
+     * returning early.
+     *
+     * @param out Destination mono samples
+     * @param count Samples requested
+     * @return Samples written (less than @p count at end of clip)
+     */
+    size_t read(int16_t* out, size_t count);
+
+    /**
+     * @brief Move the read position, decoding forward within the ADPCM block
+     */
+    void seek(size_t position);
+
+    /**
+     * @brief Advance @p count samples the way read() would, without output
+     *
+     * @return Samples skipped (less than @p count at end of clip)
+     */
+    size_t skip(size_t count);
+
+    const Audio::AudioFile* file() const { return file_; }
+    const Audio::AudioFile* next() const { return next_; }
+    size_t position() const { return position_; }
+    bool isOpen() const { return file_ != nullptr; }
+    bool isLooping() const { return looping_; }
+
+    /**
+     * @brief true once read() has nothing more to return
+     */
+    bool atEnd() const { return !file_ || (!looping_ && !next_ && position_ >= file_->sample_count); }
+
+    /**
+     * @brief Decode one mu-law byte (G.711)
+     */
+    static int16_t decodeMuLaw(uint8_t value);
+
+    /**
+     * @brief Clips cut short because their stored bytes ran out, since boot
+     */
+    static uint32_t decodeErrorCount() { return s_decodeErrors.load(); }
+
+private:
+    static std::atomic<uint32_t> s_decodeErrors;
+
+    const Audio::AudioFile* file_;
+    const Audio::AudioFile* next_;  // Chained clip, opened at end of file_
+    size_t position_;
+    const uint8_t* stored_;     // PCM16 data or encoded bytes
+    size_t storedBytes_;
+    ClipStream* stream_;
+
+    // Loop [loopStart_, loopEnd_) while looping_
+    size_t loopStart_;
+    size_t loopEnd_;
+    bool looping_;
+
+    // IMA-ADPCM decoder state, valid for the block containing position_
+    int32_t adpcmPredictor_;
+    int32_t adpcmStepIndex_;
+
+    // ADPCM state at loopStart_, so a wrap needs no decoding from the block start
+    bool loopStateValid_;
+    int32_t loopPredictor_;
+    int32_t loopStepIndex_;
+
+    /**
+     * @brief Point the reader at @p file's stored bytes and loop
+     */
+    bool attach(const Audio::AudioFile* file);
+
+    /**
+     * @brief Sample where the current run stops: the loop end or the clip end
+     */
+    size_t segmentEnd() const { return looping_ ? loopEnd_ : file_->sample_count; }
+
+    /**
+     * @brief Continue at segmentEnd(): wrap the loop or open the chained clip
+     *
+     * @return false at the real end of playback
+     */
+    bool continueAtEnd();
+
+    /**
+     * @brief Byte offset of the stored unit holding @p sample
+     */
+    size_t storedOffset(size_t sample) const;
+
+    /**
+     * @brief Stored bytes from @p offset, contiguous for *available bytes
+     */
+    const uint8_t* fetch(size_t offset, size_t* available);
+
+    size_t decode(int16_t* out, size_t count);
+
+    /**
+     * @brief Count a read that found no stored bytes and end the clip there
+     */
+    void failDecode();
+
+    size_t readPcm16(int16_t* out, size_t count);
+    size_t readMuLaw(int16_t* out, size_t count);
+    size_t readAdpcm(int16_t* out, size_t count);
+};
+
+} // namespace Exterminate
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Weighted, non-repeating random clip order
+ *
+ * Each pick first draws a category with probability proportional to
+ * Audio::AUDIO_CATEGORY_WEIGHTS (skipping empty ones), then deals the next
+ * clip from that category's shuffled deck. A deck is reshuffled only once
+ * all its clips have played, and never starts with the clip that ended the
+ * previous pass, so no clip plays twice in a row.
+ *
+ * Random numbers come from an additive lagged-Fibonacci generator
+ * (x[n] = x[n-24] + x[n-55] mod 2^32): one table read, one add and one
+ * store per draw, no multiply or divide.
+ */
+class ClipShuffle {
+public:
+    static constexpr size_t MAX_CLIPS = 256;    ///< Largest sound bank
+
+    ClipShuffle();
+
+    /**
+     * @brief Refill the table generator from @p seed
+     */
+    void seed(uint32_t seed);
+
+    /**
+     * @brief Deal clips 0 to @p clipCount - 1 into per-category decks
+     *
+     * Categories come from Audio::getAudioCategory(). Clips past MAX_CLIPS
+     * are never picked.
+     */
+    void configure(size_t clipCount);
+
+    /**
+     * @brief Clip count the decks were dealt for
+     */
+    size_t getClipCount() const { return clipCount_; }
+
+    /**
+     * @brief Next clip to play
+     *
+     * @return false if there are no clips
+     */
+    bool next(Audio::AudioIndex* index);
+
+private:
+    static constexpr size_t CATEGORY_COUNT = static_cast<size_t>(Audio::AudioCategory::COUNT);
+    static constexpr size_t LONG_LAG = 55;
+    static constexpr size_t SHORT_LAG = 24;
+
+    uint32_t table_[LONG_LAG];
+    size_t tap_;                                // Oldest entry, x[n-55]
+    uint8_t order_[MAX_CLIPS];                  // Clip indices grouped by category
+    uint16_t start_[CATEGORY_COUNT];            // Each category's deck within order_
+    uint16_t count_[CATEGORY_COUNT];
+    uint16_t dealt_[CATEGORY_COUNT];            // Clips played from the current pass
+    size_t clipCount_;
+    int last_;                                  // Previous pick (-1 before the first)
+
+    uint32_t random();
+
+    /**
+     * @brief Uniform value below @p bound
+     */
+    uint32_t below(uint32_t bound);
+
+    /**
+     * @brief Fisher-Yates shuffle of one category's deck
+     */
+    void shuffle(size_t category);
+};
+
+} // namespace Exterminate
@@ -0,0 +1,50 @@
+#pragma once
+
+#include "pico/time.h"
+#include "hardware/clocks.h"
+#include <cstdint>
+
+#if defined(PICO_RP2350) && !defined(__riscv)
+#include "hardware/structs/m33.h"
+#define EXTERMINATE_HAS_DWT_CYCCNT 1
+#else
+#define EXTERMINATE_HAS_DWT_CYCCNT 0
+#endif
+
+namespace Exterminate::CycleCounter {
+
+/**
+ * @brief Enable the core cycle counter (Cortex-M33 DWT CYCCNT)
+ *
+ * Safe to call repeatedly. On targets without a DWT the counter falls
+ * back to the microsecond timer scaled by the system clock.
+ */
+inline void enable() {
+#if EXTERMINATE_HAS_DWT_CYCCNT
+    m33_hw->demcr |= M33_DEMCR_TRCENA_BITS;
+    m33_hw->dwt_ctrl |= M33_DWT_CTRL_CYCCNTENA_BITS;
+#endif
+}
+
+/**
+ * @brief Read the free-running cycle counter
+ *
+ * Differences between two reads are valid across wrap-around as long as
+ * the interval is shorter than 2^32 cycles (~28 s at 150 MHz).
+ */
+inline uint32_t now() {
+#if EXTERMINATE_HAS_DWT_CYCCNT
+    return m33_hw->dwt_cyccnt;
+#else
+    return time_us_32() * (clock_get_hz(clk_sys) / 1000000u);
+#endif
+}
+
+/**
+ * @brief Convert a sample count at a given rate to its real-time cycle budget
+ */
+inline uint32_t budgetForSamples(uint32_t samples, uint32_t sampleRate) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(clock_get_hz(clk_sys)) * samples) / sampleRate);
+}
+
+} // namespace Exterminate::CycleCounter
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "AudioDsp.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Fixed-point "Dalek voice" effect for live microphone audio
+ *
+ * An AudioDsp chain of DC blocker, input gain, ring modulation by a low
+ * sine (~30 Hz), a band-pass made of a Butterworth high-pass and low-pass
+ * biquad, and a peak limiter. Coefficients are computed by configure();
+ * process() is integer-only.
+ *
+ * The class has no Pico SDK dependency, so tools/host builds the same
+ * source against WAV files to check its sound and cost without hardware.
+ */
+class DalekVoice {
+public:
+    static constexpr uint16_t UNITY_GAIN = 32767;   ///< Q15 limiter gain when not limiting
+
+    using Chain = AudioDsp::DspChain<AudioDsp::DcBlocker, AudioDsp::Gain, AudioDsp::RingModulator,
+                                     AudioDsp::Biquad, AudioDsp::Biquad, AudioDsp::PeakLimiter>;
+
+    /**
+     * @brief Effect settings
+     */
+    struct Config {
+        uint32_t sampleRate;    ///< Hz
+        uint16_t ringHz;        ///< Ring modulator frequency
+        uint16_t lowHz;         ///< Band-pass lower corner
+        uint16_t highHz;        ///< Band-pass upper corner
+        uint16_t inputGain;     ///< Q8 gain before the ring modulator (256 = 1.0)
+        uint16_t ceiling;       ///< Limiter ceiling (peak sample value)
+        uint16_t releaseMs;     ///< Limiter recovery time
+
+        static Config getDefault() {
+            return Config{
+                .sampleRate = 44100,
+                .ringHz = 30,
+                .lowHz = 300,
+                .highHz = 3400,
+                .inputGain = 4 * 256,   // Electret mic through the ADC is quiet
+                .ceiling = 28000,
+                .releaseMs = 80
+            };
+        }
+    };
+
+    DalekVoice();
+
+    /**
+     * @brief Compute coefficients for @p config and clear the state
+     */
+    void configure(const Config& config);
+
+    /**
+     * @brief Clear filter, oscillator and limiter state
+     */
+    void reset();
+
+    /**
+     * @brief Run the effect over one block
+     *
+     * @p in and @p out may be the same buffer.
+     */
+    void process(const int16_t* in, int16_t* out, size_t count);
+
+    /**
+     * @brief Lowest limiter gain applied since the last call (Q15, UNITY_GAIN if none)
+     */
+    uint16_t takeMinLimiterGain();
+
+    const Config& getConfig() const { return config_; }
+
+    /**
+     * @brief The stages, e.g. for Chain::processProfiled()
+     */
+    Chain& chain() { return chain_; }
+
+private:
+    Config config_;
+    Chain chain_;
+};
+
+} // namespace Exterminate
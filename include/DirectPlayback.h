@@ -0,0 +1,99 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include "hardware/pio.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Zero-copy flash-to-I2S playback
+ *
+ * Streams PCM16 clips straight from their XIP-mapped arrays into the I2S
+ * PIO TX FIFO with no CPU involvement. A data channel moves one 16-bit
+ * sample per transfer; the bus fabric replicates a halfword write across
+ * both halves of the 32-bit FIFO word, so the unmodified I2S program
+ * shifts the same sample out in the left and right slots. A second
+ * channel reloads the data channel from a list of control blocks (one per
+ * clip segment) and a final null block raises the completion IRQ.
+ *
+ * Samples are sent as stored: there is no volume control in this path.
+ */
+class DirectPlayback {
+public:
+    static constexpr size_t MAX_SEGMENTS = 4;  ///< Clips chained per start()
+
+    using CompletionCallback = void (*)();
+
+    DirectPlayback();
+    ~DirectPlayback();
+
+    /**
+     * @brief Claim DMA channels and install the completion IRQ
+     *
+     * @param pio PIO block running the I2S program
+     * @param sm State machine running the I2S program
+     * @param onComplete Called from the DMA IRQ when the last segment ends
+     * @return false if no DMA channels are free
+     */
+    bool begin(PIO pio, uint sm, CompletionCallback onComplete);
+
+    /**
+     * @brief Release DMA channels and the IRQ handler
+     */
+    void end();
+
+    /**
+     * @brief Start streaming clips back to back
+     *
+     * The caller must have stopped every other writer to the PIO TX FIFO.
+     *
+     * @return false if not ready, busy, or a clip cannot be streamed
+     */
+    bool start(const Audio::AudioFile* const* files, size_t count);
+
+    /**
+     * @brief Abort streaming without invoking the completion callback
+     */
+    void stop();
+
+    bool isReady() const { return dataChannel_ >= 0; }
+    bool isActive() const { return active_.load(); }
+
+    /**
+     * @brief Samples the DMA is about to send from the current segment
+     *
+     * @param samples Set to the next sample read by the DMA
+     * @return Samples left in the current segment (0 when idle)
+     */
+    size_t peek(const int16_t** samples) const;
+
+    /**
+     * @brief true if @p file is stored in a format the DMA can stream
+     */
+    static bool canStream(const Audio::AudioFile* file);
+
+private:
+    // Field order matches the DMA alias 3 registers (TRANS_COUNT, READ_ADDR_TRIG)
+    struct ControlBlock {
+        uint32_t transferCount;
+        const void* readAddr;
+    };
+
+    PIO pio_;
+    uint sm_;
+    int dataChannel_;
+    int controlChannel_;
+    CompletionCallback onComplete_;
+    std::atomic<bool> active_;
+
+    // Read by the control channel while streaming; the last entry is a null trigger
+    alignas(8) ControlBlock blocks_[MAX_SEGMENTS + 1];
+
+    static DirectPlayback* instance_;
+    static void dmaIrqHandler();
+};
+
+} // namespace Exterminate
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Free-running microphone capture from the ADC by DMA
+ *
+ * The ADC converts continuously at the audio rate and one DMA channel,
+ * in endless mode with a write ring, copies every result into a ring of
+ * RING_SAMPLES samples. Nothing interrupts the CPU: the reader takes
+ * samples from behind the DMA write pointer whenever a buffer is filled.
+ *
+ * begin() and end() belong to the owner's thread; the reader side must
+ * stay in one context (the buffer producer) and only ever sees an empty
+ * ring while capture is stopped.
+ */
+class MicCapture {
+public:
+    static constexpr size_t RING_SAMPLES = 1024;   ///< ~23 ms at 44.1 kHz
+
+    MicCapture();
+    ~MicCapture();
+
+    MicCapture(const MicCapture&) = delete;
+    MicCapture& operator=(const MicCapture&) = delete;
+
+    /**
+     * @brief Start converting @p gpio at @p sampleRate into the ring
+     *
+     * @param gpio ADC-capable pin (GPIO 40-47 on the RP2350B)
+     * @return false if the pin has no ADC channel or no DMA channel is free
+     */
+    bool begin(uint8_t gpio, uint32_t sampleRate);
+
+    /**
+     * @brief Stop the ADC and release the DMA channel
+     */
+    void end();
+
+    bool isRunning() const { return channel_ >= 0; }
+
+    /**
+     * @brief Samples captured and not yet read
+     *
+     * When the DMA has lapped the reader the oldest samples are already
+     * overwritten; the reader then jumps to the newest half ring and the
+     * overrun is counted.
+     */
+    size_t available();
+
+    /**
+     * @brief Copy up to @p count of the oldest unread samples as signed PCM16
+     *
+     * @return Samples written to @p out
+     */
+    size_t read(int16_t* out, size_t count);
+
+    /**
+     * @brief Drop up to @p count of the oldest unread samples
+     */
+    void skip(size_t count);
+
+    uint32_t getOverrunCount() const { return overruns_; }
+
+private:
+    int channel_;
+    uint8_t adcInput_;
+    uint32_t readIndex_;    // Free-running sample count, wraps with the ring
+    uint32_t overruns_;
+
+    /**
+     * @brief Free-running index of the next sample @p channel writes
+     */
+    uint32_t writeIndex(int channel) const;
+};
+
+} // namespace Exterminate
@@ -2,6 +2,9 @@
 
 #include "hardware/pwm.h"
 #include "hardware/gpio.h"
+#include "pico/time.h"
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 
 namespace Exterminate {
@@ -15,6 +18,12 @@ namespace Exterminate {
  * interface (direction pins + PWM for speed control).
  * It follows RAII principles and provides differential drive control
  * suitable for a two-wheeled robot.
+ *
+ * Commands only set a target. A control loop on a repeating timer
+ * (Config::controlRateHz) moves each motor toward its target at a fixed
+ * rate, limited in acceleration and jerk, so the motor update no longer
+ * follows the gamepad's report timing and full-throttle steps do not
+ * pull current spikes that brown out the supply.
  */
 class MotorController {
 public:
@@ -35,6 +44,27 @@ public:
         uint8_t rightMotorPin1;  ///< Right motor direction pin 1 (BIN1)
         uint8_t rightMotorPin2;  ///< Right motor direction pin 2 (BIN2)
         uint32_t pwmFrequency;   ///< PWM frequency in Hz (typically 1000-20000)
+        uint32_t controlRateHz = 1000;  ///< Control loop rate (0 = apply commands directly, unlimited)
+        float maxAcceleration = 4.0f;   ///< Speed change per second (0 = no limit; 4 = full speed in 250 ms)
+        float maxJerk = 40.0f;          ///< Acceleration change per second (0 = no limit)
+    };
+
+    /**
+     * @brief Control loop timing and slew counters
+     *
+     * Jitter is how far each interval between ticks was from the period.
+     * A late tick means the timer IRQ was held off, usually by a
+     * higher-priority handler or a long interrupts-disabled section.
+     */
+    struct ControlStats {
+        uint32_t ticks;           ///< Control loop iterations
+        uint32_t periodUs;        ///< Nominal tick interval (0 = loop not running)
+        uint32_t lastJitterUs;    ///< |interval - period| of the latest tick
+        uint32_t avgJitterUs;     ///< Mean |interval - period|
+        uint32_t peakJitterUs;    ///< Worst |interval - period|
+        uint32_t lateTicks;       ///< Ticks that came a whole period late or later
+        uint32_t slewTicks;       ///< Ticks where a motor was still ramping to its target
+        uint32_t peakTickCycles;  ///< Longest tick, in CPU cycles
     };
 
     /**
@@ -63,6 +93,9 @@ public:
     /**
      * @brief Set motor speed and direction
      * 
+     * With the control loop running this sets the motor's target, which
+     * the next ticks ramp to.
+     * 
      * @param motor Which motor to control
      * @param speed Speed from -1.0 (full reverse) to 1.0 (full forward)
      */
@@ -71,6 +104,9 @@ public:
     /**
      * @brief Set differential drive motion
      * 
+     * Cheap enough to call at any report rate: it latches both wheel
+     * targets in one atomic store for the control loop.
+     * 
      * @param forward Forward speed from -1.0 to 1.0
      * @param turn Turn rate from -1.0 (left) to 1.0 (right)
      */
@@ -78,9 +114,36 @@ public:
 
     /**
      * @brief Stop all motors immediately
+     * 
+     * Bypasses the slew limits: outputs go to zero now, not on a ramp.
      */
     void stopAllMotors();
 
+    /**
+     * @brief Get the speed a motor is being driven at (after slew limiting)
+     */
+    float getMotorSpeed(Motor motor) const;
+
+    /**
+     * @brief Check whether commands go through the fixed-rate control loop
+     */
+    bool isControlLoopRunning() const { return controlLoopActive_; }
+
+    /**
+     * @brief Read the control loop counters without blocking
+     */
+    ControlStats getControlStats() const;
+
+    /**
+     * @brief Clear the control loop counters
+     */
+    void resetControlStats();
+
+    /**
+     * @brief Print getControlStats() to the console
+     */
+    void dumpControlStats() const;
+
     /**
      * @brief Check if the motor controller is initialized
      * 
@@ -97,6 +160,59 @@ private:
     uint8_t leftPwmChannelB_;
     uint8_t rightPwmChannelA_;
     uint8_t rightPwmChannelB_;
+    uint16_t pwmWrap_;
+
+    // Control loop: targets written by commands, ramp state owned by the tick
+    repeating_timer_t controlTimer_;
+    bool controlLoopActive_;
+    uint32_t controlPeriodUs_;
+    float controlPeriodS_;
+    std::atomic<uint32_t> targets_;         // Left and right targets, packed Q15
+    std::atomic<bool> stopRequested_;       // Zero the ramp state on the next tick
+    float speed_[2];                        // Output of the slew limiter
+    float acceleration_[2];
+    std::atomic<uint32_t> outputs_;         // speed_, packed Q15, for getMotorSpeed()
+
+    // Loop timing, written only by the tick
+    uint32_t lastTickUs_;
+    std::atomic<uint32_t> ticks_;
+    std::atomic<uint32_t> lastJitterUs_;
+    std::atomic<uint32_t> jitterSumUs_;
+    std::atomic<uint32_t> peakJitterUs_;
+    std::atomic<uint32_t> lateTicks_;
+    std::atomic<uint32_t> slewTicks_;
+    std::atomic<uint32_t> peakTickCycles_;
+
+    /**
+     * @brief Start the repeating timer that runs controlTick()
+     */
+    bool startControlLoop();
+    static bool controlTimerCallback(repeating_timer_t* timer);
+
+    /**
+     * @brief One control loop iteration: ramp both motors toward their targets
+     * 
+     * Runs in the timer IRQ, so it never prints or blocks.
+     */
+    void controlTick();
+
+    /**
+     * @brief Move one motor's speed a tick toward @p target within the acceleration and jerk limits
+     */
+    void slew(size_t motor, float target);
+
+    /**
+     * @brief Drive the H-bridge pins for a speed, without logging
+     */
+    void applyMotorSpeed(Motor motor, float speed);
+
+    static uint32_t packSpeeds(float left, float right);
+    static float unpackSpeed(uint32_t packed, Motor motor);
+
+    /**
+     * @brief Replace one motor's half of a packed pair
+     */
+    static void storeSpeed(std::atomic<uint32_t>& packed, Motor motor, float speed);
 
     /**
      * @brief Configure PWM for a specific pin
@@ -109,6 +225,8 @@ private:
     /**
      * @brief Set PWM duty cycle for a pin
      * 
+     * Scaled to the slice's wrap, so every duty cycle maps to its own level.
+     * 
      * @param pin GPIO pin number
      * @param dutyCycle Duty cycle from 0.0 to 1.0
      */
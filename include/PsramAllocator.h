@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// QMI chip select of the on-board PSRAM (Pico LiPo 2 XL W / Pico Plus 2 W)
+#ifndef PSRAM_CS_PIN
+#define PSRAM_CS_PIN 47
+#endif
+
+namespace Exterminate {
+
+/**
+ * @brief Allocator for the external QSPI PSRAM on QMI chip select 1
+ *
+ * begin() probes the APS6404-class PSRAM in QMI direct mode, switches it
+ * to QPI and maps it as writable XIP memory. Allocations are handed out
+ * through the uncached alias, so clip reads never evict the flash code
+ * that BTstack and CYW43 execute from the shared XIP cache.
+ *
+ * Block bookkeeping lives in SRAM (first fit, neighbours coalesced on
+ * free), so no allocator metadata is ever read back from PSRAM. Not
+ * thread-safe; the owner serialises calls.
+ */
+class PsramAllocator {
+public:
+    static constexpr size_t MAX_BLOCKS = 64;   ///< Free + used blocks tracked
+    static constexpr size_t ALIGNMENT = 32;    ///< Allocation granularity (bytes)
+
+    PsramAllocator();
+
+    /**
+     * @brief Detect and map the PSRAM
+     *
+     * Must run before core1 is launched: QMI direct mode stalls flash XIP.
+     *
+     * @return false if no PSRAM answered on PSRAM_CS_PIN
+     */
+    bool begin();
+
+    /**
+     * @brief Allocate @p bytes of PSRAM
+     *
+     * @return Uncached PSRAM address, or nullptr if no free block is large enough
+     */
+    void* allocate(size_t bytes);
+
+    /**
+     * @brief Return a block from allocate(); nullptr is ignored
+     */
+    void free(void* pointer);
+
+    bool isReady() const { return capacity_ > 0; }
+    size_t capacity() const { return capacity_; }
+    size_t bytesUsed() const { return used_; }
+
+    /**
+     * @brief Size of the largest block allocate() could return now
+     */
+    size_t largestFreeBlock() const;
+
+private:
+    struct Block {
+        uint32_t offset;
+        uint32_t size;
+        bool used;
+    };
+
+    uint8_t* base_;
+    size_t capacity_;
+    size_t used_;
+    Block blocks_[MAX_BLOCKS];   // Sorted by offset, covering the whole region
+    size_t blockCount_;
+
+    /**
+     * @brief Probe the PSRAM ID and configure QMI window 1
+     *
+     * @return Detected size in bytes (0 if absent)
+     */
+    static size_t setupHardware();
+
+    void removeBlock(size_t index);
+};
+
+} // namespace Exterminate
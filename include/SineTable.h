@@ -0,0 +1,57 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate::SineTable {
+
+constexpr size_t BITS = 8;                 ///< log2 of the table size
+constexpr size_t SIZE = size_t{1} << BITS;
+
+namespace detail {
+
+// Taylor series on [-pi/2, pi/2]; only evaluated at compile time
+constexpr double taylorSine(double x) {
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 12; ++n) {
+        term *= -x * x / ((2 * n) * (2 * n + 1));
+        sum += term;
+    }
+    return sum;
+}
+
+constexpr std::array<int16_t, SIZE + 1> makeTable() {
+    constexpr double PI = 3.14159265358979323846;
+    std::array<int16_t, SIZE + 1> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        double angle = 2.0 * PI * static_cast<double>(i) / SIZE;
+        if (angle > 1.5 * PI) {
+            angle -= 2.0 * PI;
+        } else if (angle > 0.5 * PI) {
+            angle = PI - angle;
+        }
+        const double value = taylorSine(angle) * 32767.0;
+        table[i] = static_cast<int16_t>(value < 0 ? value - 0.5 : value + 0.5);
+    }
+    return table;
+}
+
+} // namespace detail
+
+/// One period of sin() in Q15, plus a guard entry so interpolation never wraps
+inline constexpr std::array<int16_t, SIZE + 1> TABLE = detail::makeTable();
+
+/**
+ * @brief sin(2*pi*phase/2^32) in Q15, linearly interpolated
+ */
+inline int32_t lookup(uint32_t phase) {
+    const uint32_t index = phase >> (32 - BITS);
+    const int32_t fraction = static_cast<int32_t>((phase >> (16 - BITS)) & 0xFFFF);
+    const int32_t a = TABLE[index];
+    const int32_t b = TABLE[index + 1];
+    return a + (((b - a) * fraction) >> 16);
+}
+
+} // namespace Exterminate::SineTable
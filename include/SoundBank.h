@@ -0,0 +1,92 @@
+#pragma once
+
+#include <audio/audio_index.h>
+#include <cstddef>
+#include <cstdint>
+
+// Flash partition holding the sound bank (offset from the start of flash).
+// It ends below BTstack's pairing key storage in the last flash sectors.
+#ifndef SOUND_BANK_FLASH_OFFSET
+#define SOUND_BANK_FLASH_OFFSET 0x00C00000u
+#endif
+
+#ifndef SOUND_BANK_SIZE_BYTES
+#define SOUND_BANK_SIZE_BYTES 0x003F0000u
+#endif
+
+namespace Exterminate {
+
+/**
+ * @brief Flash-resident sound bank, decoupled from the firmware image
+ *
+ * A bank is packed on the host by tools/pack_sound_bank.py and written to
+ * its own flash partition, so sounds can change without a rebuild.
+ * Layout (little endian, all pointers are absolute XIP addresses):
+ *
+ *   Header            32 bytes, see Header
+ *   Index             clipCount x Audio::AudioFile, in AudioIndex order
+ *   Names, envelopes  NUL-terminated names and uint8 loudness tables
+ *   Payloads          PCM16 / ADPCM / mu-law data, each 4 KB aligned
+ *
+ * The index entries are laid out exactly like Audio::AudioFile, so once
+ * mounted Audio::getAudioFile() returns pointers straight into the XIP
+ * mapping and nothing is copied to RAM.
+ */
+class SoundBank {
+public:
+    static constexpr uint32_t MAGIC = 0x42535845;   ///< "EXSB"
+    static constexpr uint16_t VERSION = 2;
+    static constexpr size_t MAX_CLIPS = 256;
+    static constexpr size_t PAYLOAD_ALIGN = 4096;   ///< Flash sector size
+
+    /**
+     * @brief Fixed-size bank header
+     */
+    struct Header {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t clipCount;
+        uint32_t xipBase;       ///< XIP address the bank was packed for
+        uint32_t indexOffset;   ///< Byte offset of the AudioFile index
+        uint32_t dataOffset;    ///< Byte offset of the first payload
+        uint32_t totalBytes;    ///< Bank size including payloads
+        uint32_t reserved;
+        uint32_t headerCrc;     ///< CRC-32 of the preceding 28 bytes
+    };
+
+    /**
+     * @brief Validate the bank partition and make it the active registry
+     *
+     * Checks the header CRC, the XIP base, bounds and 4 KB payload
+     * alignment of each index entry. Cost depends only on the index size
+     * (at most MAX_CLIPS entries), never on the payload size.
+     *
+     * @return false if no valid bank is present; the compiled-in clips stay active
+     */
+    static bool mount(uintptr_t xipBase = defaultXipBase(), size_t partitionBytes = SOUND_BANK_SIZE_BYTES);
+
+    /**
+     * @brief Return to the compiled-in clips
+     */
+    static void unmount();
+
+    static bool isMounted() { return header_ != nullptr; }
+    static size_t clipCount() { return header_ ? header_->clipCount : 0; }
+
+    /**
+     * @brief XIP address of the sound bank partition
+     */
+    static uintptr_t defaultXipBase();
+
+    /**
+     * @brief CRC-32 (IEEE 802.3, same as zlib.crc32)
+     */
+    static uint32_t crc32(const uint8_t* data, size_t length);
+
+private:
+    static const Header* header_;
+
+    static bool validateEntry(const Audio::AudioFile& file, uintptr_t base, size_t totalBytes);
+};
+
+} // namespace Exterminate
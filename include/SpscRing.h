@@ -0,0 +1,70 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+namespace Exterminate {
+
+/**
+ * @brief Lock-free single-producer/single-consumer ring buffer
+ *
+ * One context pushes, one context pops; they may run on different cores
+ * or in interrupt vs thread context. Capacity must be a power of two and
+ * one slot is kept free to distinguish full from empty.
+ */
+template <typename T, size_t Capacity>
+class SpscRing {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "SpscRing capacity must be a power of two");
+
+public:
+    /**
+     * @brief Append an element (producer side)
+     *
+     * @return false if the ring is full
+     */
+    bool push(const T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        const size_t next = (head + 1) & MASK;
+        if (next == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        items_[head] = value;
+        head_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Remove the oldest element (consumer side)
+     *
+     * @return false if the ring is empty
+     */
+    bool pop(T& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = items_[tail];
+        tail_.store((tail + 1) & MASK, std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t size() const {
+        return (head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire)) & MASK;
+    }
+
+    static constexpr size_t capacity() { return Capacity - 1; }
+
+private:
+    static constexpr size_t MASK = Capacity - 1;
+
+    T items_[Capacity] = {};
+    std::atomic<size_t> head_{0};
+    std::atomic<size_t> tail_{0};
+};
+
+} // namespace Exterminate
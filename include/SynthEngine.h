@@ -0,0 +1,219 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief Parameters of one synthesised sound
+ *
+ * A patch is a few bytes in flash where the same effect as a PCM clip
+ * would take tens of kilobytes. Times are in milliseconds and levels in
+ * 0-255 so patches stay readable.
+ */
+struct SynthPatch {
+    enum class Waveform : uint8_t {
+        Sine,      ///< 256-entry table, linearly interpolated
+        Square,
+        Saw,
+        Triangle
+    };
+
+    Waveform waveform;
+    uint8_t noise;            ///< LFSR noise blended over the oscillator (0 = none, 255 = noise only)
+    uint16_t pitchHz;         ///< Oscillator frequency at note on
+    int16_t sweep;            ///< Pitch glide in semitones per second (negative falls)
+    uint16_t cutoffHz;        ///< One-pole low-pass corner (0 = no filter)
+    uint16_t attackMs;
+    uint16_t decayMs;
+    uint8_t sustain;          ///< Sustain level (0-255)
+    uint16_t holdMs;          ///< Sustain time before release (0 = until released)
+    uint16_t releaseMs;
+    bool tracksPitch;         ///< Follow SynthEngine::setPitchScale() for the note (e.g. motor speed)
+};
+
+/**
+ * @brief Built-in effect patches
+ */
+namespace SynthPatches {
+
+/// Falling square zap with a noisy edge, for the gun
+inline constexpr SynthPatch ZAP{
+    .waveform = SynthPatch::Waveform::Square, .noise = 64, .pitchHz = 1800, .sweep = -60,
+    .cutoffHz = 6000, .attackMs = 2, .decayMs = 60, .sustain = 90, .holdMs = 80, .releaseMs = 60,
+    .tracksPitch = false};
+
+/// Low filtered saw drone; pitch follows the motors, sustains until released
+inline constexpr SynthPatch MOTOR_HUM{
+    .waveform = SynthPatch::Waveform::Saw, .noise = 24, .pitchHz = 55, .sweep = 0,
+    .cutoffHz = 700, .attackMs = 120, .decayMs = 200, .sustain = 180, .holdMs = 0, .releaseMs = 250,
+    .tracksPitch = true};
+
+/// Short sine beep for UI feedback
+inline constexpr SynthPatch BEEP{
+    .waveform = SynthPatch::Waveform::Sine, .noise = 0, .pitchHz = 1320, .sweep = 0,
+    .cutoffHz = 0, .attackMs = 3, .decayMs = 20, .sustain = 200, .holdMs = 70, .releaseMs = 30,
+    .tracksPitch = false};
+
+} // namespace SynthPatches
+
+/**
+ * @brief Fixed-point effect synthesiser mixed onto the audio bus
+ *
+ * Each voice runs a Q32 phase-accumulator oscillator, a 16-bit Galois
+ * LFSR noise source, a one-pole low-pass filter and a linear ADSR
+ * envelope, all in integer arithmetic. Coefficients are worked out once
+ * at note on; pitch glide and the pitch scale are applied every
+ * CONTROL_SAMPLES samples, so the per-sample loop has no divides and no
+ * floating point.
+ *
+ * render() adds its voices onto the mono bus the AudioMixer has just
+ * written, so synthesised effects and clips share the buffer's master
+ * volume and I2S format conversion. The cost of every render() is
+ * recorded in cycles for comparison against the buffer deadline.
+ *
+ * Not thread-safe; the owner serialises access like the mixer's.
+ */
+class SynthEngine {
+public:
+    static constexpr size_t MAX_VOICES = 4;           ///< Effects synthesised at once
+    static constexpr size_t CONTROL_SAMPLES = 32;     ///< Samples between pitch updates
+    static constexpr uint16_t UNITY_GAIN = 32768;     ///< Q15 gain of 1.0
+    static constexpr uint16_t PITCH_UNITY = 4096;     ///< Q12 pitch scale of 1.0
+
+    /// Handle naming one note; stale once the note ends or its voice is stolen
+    using NoteId = uint16_t;
+    static constexpr NoteId NO_NOTE = 0;
+
+    /**
+     * @brief Render cost measurement
+     */
+    struct Stats {
+        uint32_t lastCycles;   ///< Cycles spent in the latest render()
+        uint32_t peakCycles;   ///< Worst render() since construction
+        uint32_t notes;        ///< Notes started
+        uint32_t steals;       ///< Notes that replaced a sounding voice
+    };
+
+    SynthEngine();
+
+    /**
+     * @brief Set the bus rate; applies to notes started afterwards
+     */
+    void setSampleRate(uint32_t sampleRate);
+
+    /**
+     * @brief Start @p patch on a free voice, or the oldest one
+     *
+     * @p patch must outlive the note (patches normally live in flash).
+     *
+     * @param gain Q15 voice gain (UNITY_GAIN = 1.0)
+     * @param note Handle for the note, NO_NOTE to take the next one in turn
+     * @return The note's handle, or NO_NOTE if the patch is unusable
+     */
+    NoteId noteOn(const SynthPatch* patch, uint16_t gain, NoteId note = NO_NOTE);
+
+    /**
+     * @brief Move @p note to its release stage, leaving other notes alone
+     */
+    void release(NoteId note);
+
+    /**
+     * @brief Silence every voice at once
+     */
+    void stopAll();
+
+    /**
+     * @brief Scale the pitch of @p note, if its patch has tracksPitch set
+     *
+     * @param scaleQ12 Q12 pitch multiplier (PITCH_UNITY = 1.0, up to 8.0)
+     */
+    void setPitchScale(NoteId note, uint16_t scaleQ12);
+
+    /**
+     * @brief Add every sounding voice onto @p out with saturation
+     *
+     * @param out Mono bus samples, already holding the mixer output
+     * @param count Samples to render
+     * @return @p count if any voice sounded, otherwise 0
+     */
+    size_t render(int16_t* out, size_t count);
+
+    size_t activeVoiceCount() const;
+    bool isActive() const { return activeVoiceCount() > 0; }
+
+    /**
+     * @brief Note sounding on @p voice, or NO_NOTE if it is silent
+     */
+    NoteId voiceNote(size_t voice) const;
+
+    bool isPlaying(NoteId note) const { return findVoice(note) != nullptr; }
+
+    Stats getStats() const { return Stats{lastCycles_, peakCycles_, notes_, steals_}; }
+
+private:
+    enum class Stage : uint8_t {
+        Off,
+        Attack,
+        Decay,
+        Sustain,
+        Release
+    };
+
+    struct Voice {
+        const SynthPatch* patch;
+        Stage stage;
+        uint32_t startOrder;
+        NoteId note;
+        uint16_t pitchScale;    ///< Q12, used if the patch tracks pitch
+
+        // Oscillator
+        uint32_t phase;
+        uint32_t baseStep;      ///< Q32 phase step before the pitch scale
+        uint32_t sweepFactor;   ///< Q16 baseStep multiplier per control block
+
+        // Noise and filter
+        uint16_t lfsr;
+        int32_t noiseMix;       ///< Q8 noise share
+        int32_t filterCoeff;    ///< Q15 one-pole coefficient (32767 = bypass)
+        int32_t filterState;
+
+        // Envelope (Q16 level, 65536 = full scale)
+        int32_t level;
+        int32_t attackStep;
+        int32_t decayStep;
+        int32_t sustainLevel;
+        int32_t releaseStep;
+        uint32_t holdSamples;   ///< Sustain samples left (0 = hold until released)
+        uint16_t gain;
+    };
+
+    Voice voices_[MAX_VOICES];
+    int32_t accumulator_[CONTROL_SAMPLES];
+    uint32_t sampleRate_;
+    uint32_t startCounter_;
+    NoteId nextNote_;
+    uint32_t lastCycles_;
+    uint32_t peakCycles_;
+    uint32_t notes_;
+    uint32_t steals_;
+
+    /**
+     * @brief Envelope step covering full scale in @p ms
+     */
+    int32_t stepForMs(uint32_t ms) const;
+
+    /**
+     * @brief Voice still playing @p note, or nullptr
+     */
+    const Voice* findVoice(NoteId note) const;
+    Voice* findVoice(NoteId note);
+
+    /**
+     * @brief Accumulate up to CONTROL_SAMPLES samples of @p voice
+     */
+    void renderVoice(Voice& voice, int32_t* accumulator, size_t count);
+};
+
+} // namespace Exterminate
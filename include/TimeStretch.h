@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate {
+
+/**
+ * @brief WSOLA time-stretch of a mono stream
+ *
+ * Changes how fast the input is played through without changing its
+ * pitch. Output is built from overlapping sequences (~25 ms) of input;
+ * each new sequence starts where the input has advanced by tempo times
+ * the output, moved within a ~10 ms seek window to the offset that best
+ * matches the tail of the previous one, and is joined to it with a
+ * ~6 ms linear crossfade. At unity tempo the best offset is the seam
+ * itself, so the output equals the input.
+ *
+ * Paired with the mixer's varispeed pitch (which also changes tempo) the
+ * stretch restores the original duration: tempo = 1 / pitch.
+ *
+ * Input is pulled from a Source callback only as far as the next
+ * sequence needs, so the stage delays its input by at most one sequence
+ * plus the seek window. Sample arithmetic is integer; the match score
+ * uses one float divide per candidate offset. Buffers are fixed and
+ * sized for MAX_SAMPLE_RATE.
+ *
+ * The class has no Pico SDK dependency, so tools/host can run it on WAV
+ * files.
+ */
+class TimeStretch {
+public:
+    static constexpr uint32_t MAX_SAMPLE_RATE = 48000;
+    static constexpr uint32_t TEMPO_UNITY = 65536;            ///< Q16 tempo of 1.0
+    static constexpr uint32_t MIN_TEMPO = TEMPO_UNITY / 2;
+    static constexpr uint32_t MAX_TEMPO = TEMPO_UNITY * 2;
+    static constexpr uint32_t SEQUENCE_MS = 25;
+    static constexpr uint32_t SEEK_MS = 10;
+    static constexpr uint32_t OVERLAP_MS = 6;
+
+    /**
+     * @brief Input provider; fills @p out with up to @p count samples
+     *
+     * @return Samples of real audio written (the rest of @p out must be
+     *         zeroed); less than @p count once the input has ended
+     */
+    using Source = size_t (*)(int16_t* out, size_t count, void* context);
+
+    TimeStretch();
+
+    /**
+     * @brief Size the sequence, seek and overlap windows for @p sampleRate and reset
+     *
+     * Rates above MAX_SAMPLE_RATE are treated as MAX_SAMPLE_RATE.
+     */
+    void configure(uint32_t sampleRate);
+
+    /**
+     * @brief Drop all buffered audio; the next output starts unstretched
+     */
+    void reset();
+
+    /**
+     * @brief Input samples consumed per output sample, from the next sequence on
+     *
+     * @param tempoQ16 Q16 tempo (TEMPO_UNITY = 1.0), clamped to MIN_TEMPO-MAX_TEMPO
+     */
+    void setTempo(uint32_t tempoQ16);
+    uint32_t getTempo() const { return tempo_; }
+
+    /**
+     * @brief Produce @p count stretched samples
+     *
+     * @return Samples of audio written, less than @p count (the rest
+     *         zeroed) once the source has ended and its audio has been
+     *         played out; 0 when fully drained
+     */
+    size_t process(int16_t* out, size_t count, Source source, void* context);
+
+    /**
+     * @brief true while input or output is still buffered
+     */
+    bool isActive() const { return audioCount_ > 0 || outputCount_ > 0; }
+
+    /**
+     * @brief Sequences produced since configure()
+     */
+    uint32_t getSequenceCount() const { return sequences_; }
+
+    /**
+     * @brief Output samples one sequence adds (the work done every this many samples)
+     */
+    size_t getSequenceOutput() const { return sequence_ - overlap_; }
+
+private:
+    static constexpr size_t MAX_SEQUENCE = MAX_SAMPLE_RATE * SEQUENCE_MS / 1000;
+    static constexpr size_t MAX_SEEK = MAX_SAMPLE_RATE * SEEK_MS / 1000;
+    static constexpr size_t MAX_OVERLAP = MAX_SAMPLE_RATE * OVERLAP_MS / 1000;
+    static constexpr size_t INPUT_CAPACITY = 2 * MAX_SEQUENCE;    // Covers seek + sequence and a 2x skip
+    static constexpr size_t COARSE_STEP = 4;                      // Seek stride before refining
+
+    int16_t input_[INPUT_CAPACITY];
+    int16_t output_[MAX_SEQUENCE];
+    int16_t tail_[MAX_OVERLAP];                 // End of the previous sequence, to crossfade from
+    size_t sequence_;
+    size_t seek_;
+    size_t overlap_;
+    uint32_t tempo_;
+    uint32_t skipFraction_;                     // Q16 input position carried between sequences
+    size_t inputCount_;                         // Samples in input_
+    size_t audioCount_;                         // Leading samples of input_ that are real audio
+    size_t outputRead_;
+    size_t outputCount_;
+    bool haveTail_;
+    uint32_t sequences_;
+
+    /**
+     * @brief Input samples the next sequence reads or skips
+     */
+    size_t inputNeeded() const;
+
+    /**
+     * @brief Append up to @p count source samples to input_
+     */
+    void pull(size_t count, Source source, void* context);
+
+    /**
+     * @brief Build one sequence into output_
+     *
+     * @return false if the source has nothing left to stretch
+     */
+    bool nextSequence(Source source, void* context);
+
+    /**
+     * @brief Offset within the seek window that best continues tail_
+     */
+    size_t bestOffset() const;
+
+    /**
+     * @brief Normalised cross-correlation of tail_ with input_ at @p offset
+     */
+    float matchScore(size_t offset) const;
+};
+
+} // namespace Exterminate
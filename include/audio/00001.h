@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 1395ms (61,545 samples)
 extern const int16_t AUDIO_00001_DATA[];
-extern const size_t AUDIO_00001_SAMPLE_COUNT;
-extern const size_t AUDIO_00001_BYTE_SIZE;
-extern const uint32_t AUDIO_00001_SAMPLE_RATE;
-extern const uint8_t AUDIO_00001_CHANNELS;
-extern const uint8_t AUDIO_00001_BIT_DEPTH;
+constexpr size_t AUDIO_00001_SAMPLE_COUNT = 61545;
+constexpr size_t AUDIO_00001_BYTE_SIZE = 123090;
+constexpr uint32_t AUDIO_00001_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00001_CHANNELS = 1;
+constexpr uint8_t AUDIO_00001_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00001_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 2011ms (88,713 samples)
 extern const int16_t AUDIO_00002_DATA[];
-extern const size_t AUDIO_00002_SAMPLE_COUNT;
-extern const size_t AUDIO_00002_BYTE_SIZE;
-extern const uint32_t AUDIO_00002_SAMPLE_RATE;
-extern const uint8_t AUDIO_00002_CHANNELS;
-extern const uint8_t AUDIO_00002_BIT_DEPTH;
+constexpr size_t AUDIO_00002_SAMPLE_COUNT = 88713;
+constexpr size_t AUDIO_00002_BYTE_SIZE = 177426;
+constexpr uint32_t AUDIO_00002_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00002_CHANNELS = 1;
+constexpr uint8_t AUDIO_00002_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00002_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 2671ms (117,823 samples)
 extern const int16_t AUDIO_00003_DATA[];
-extern const size_t AUDIO_00003_SAMPLE_COUNT;
-extern const size_t AUDIO_00003_BYTE_SIZE;
-extern const uint32_t AUDIO_00003_SAMPLE_RATE;
-extern const uint8_t AUDIO_00003_CHANNELS;
-extern const uint8_t AUDIO_00003_BIT_DEPTH;
+constexpr size_t AUDIO_00003_SAMPLE_COUNT = 117823;
+constexpr size_t AUDIO_00003_BYTE_SIZE = 235646;
+constexpr uint32_t AUDIO_00003_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00003_CHANNELS = 1;
+constexpr uint8_t AUDIO_00003_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00003_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
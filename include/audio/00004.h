@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 5972ms (263,368 samples)
 extern const int16_t AUDIO_00004_DATA[];
-extern const size_t AUDIO_00004_SAMPLE_COUNT;
-extern const size_t AUDIO_00004_BYTE_SIZE;
-extern const uint32_t AUDIO_00004_SAMPLE_RATE;
-extern const uint8_t AUDIO_00004_CHANNELS;
-extern const uint8_t AUDIO_00004_BIT_DEPTH;
+constexpr size_t AUDIO_00004_SAMPLE_COUNT = 263368;
+constexpr size_t AUDIO_00004_BYTE_SIZE = 526736;
+constexpr uint32_t AUDIO_00004_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00004_CHANNELS = 1;
+constexpr uint8_t AUDIO_00004_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00004_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
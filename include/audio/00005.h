@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 4425ms (195,171 samples)
 extern const int16_t AUDIO_00005_DATA[];
-extern const size_t AUDIO_00005_SAMPLE_COUNT;
-extern const size_t AUDIO_00005_BYTE_SIZE;
-extern const uint32_t AUDIO_00005_SAMPLE_RATE;
-extern const uint8_t AUDIO_00005_CHANNELS;
-extern const uint8_t AUDIO_00005_BIT_DEPTH;
+constexpr size_t AUDIO_00005_SAMPLE_COUNT = 195171;
+constexpr size_t AUDIO_00005_BYTE_SIZE = 390342;
+constexpr uint32_t AUDIO_00005_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00005_CHANNELS = 1;
+constexpr uint8_t AUDIO_00005_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00005_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
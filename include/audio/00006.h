@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 2678ms (118,100 samples)
 extern const int16_t AUDIO_00006_DATA[];
-extern const size_t AUDIO_00006_SAMPLE_COUNT;
-extern const size_t AUDIO_00006_BYTE_SIZE;
-extern const uint32_t AUDIO_00006_SAMPLE_RATE;
-extern const uint8_t AUDIO_00006_CHANNELS;
-extern const uint8_t AUDIO_00006_BIT_DEPTH;
+constexpr size_t AUDIO_00006_SAMPLE_COUNT = 118100;
+constexpr size_t AUDIO_00006_BYTE_SIZE = 236200;
+constexpr uint32_t AUDIO_00006_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00006_CHANNELS = 1;
+constexpr uint8_t AUDIO_00006_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00006_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 4859ms (214,299 samples)
 extern const int16_t AUDIO_00007_DATA[];
-extern const size_t AUDIO_00007_SAMPLE_COUNT;
-extern const size_t AUDIO_00007_BYTE_SIZE;
-extern const uint32_t AUDIO_00007_SAMPLE_RATE;
-extern const uint8_t AUDIO_00007_CHANNELS;
-extern const uint8_t AUDIO_00007_BIT_DEPTH;
+constexpr size_t AUDIO_00007_SAMPLE_COUNT = 214299;
+constexpr size_t AUDIO_00007_BYTE_SIZE = 428598;
+constexpr uint32_t AUDIO_00007_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00007_CHANNELS = 1;
+constexpr uint8_t AUDIO_00007_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00007_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 1904ms (84,001 samples)
 extern const int16_t AUDIO_00008_DATA[];
-extern const size_t AUDIO_00008_SAMPLE_COUNT;
-extern const size_t AUDIO_00008_BYTE_SIZE;
-extern const uint32_t AUDIO_00008_SAMPLE_RATE;
-extern const uint8_t AUDIO_00008_CHANNELS;
-extern const uint8_t AUDIO_00008_BIT_DEPTH;
+constexpr size_t AUDIO_00008_SAMPLE_COUNT = 84001;
+constexpr size_t AUDIO_00008_BYTE_SIZE = 168002;
+constexpr uint32_t AUDIO_00008_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00008_CHANNELS = 1;
+constexpr uint8_t AUDIO_00008_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00008_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
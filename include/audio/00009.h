@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 5431ms (239,527 samples)
 extern const int16_t AUDIO_00009_DATA[];
-extern const size_t AUDIO_00009_SAMPLE_COUNT;
-extern const size_t AUDIO_00009_BYTE_SIZE;
-extern const uint32_t AUDIO_00009_SAMPLE_RATE;
-extern const uint8_t AUDIO_00009_CHANNELS;
-extern const uint8_t AUDIO_00009_BIT_DEPTH;
+constexpr size_t AUDIO_00009_SAMPLE_COUNT = 239527;
+constexpr size_t AUDIO_00009_BYTE_SIZE = 479054;
+constexpr uint32_t AUDIO_00009_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00009_CHANNELS = 1;
+constexpr uint8_t AUDIO_00009_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00009_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
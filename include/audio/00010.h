@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 3922ms (172,992 samples)
 extern const int16_t AUDIO_00010_DATA[];
-extern const size_t AUDIO_00010_SAMPLE_COUNT;
-extern const size_t AUDIO_00010_BYTE_SIZE;
-extern const uint32_t AUDIO_00010_SAMPLE_RATE;
-extern const uint8_t AUDIO_00010_CHANNELS;
-extern const uint8_t AUDIO_00010_BIT_DEPTH;
+constexpr size_t AUDIO_00010_SAMPLE_COUNT = 172992;
+constexpr size_t AUDIO_00010_BYTE_SIZE = 345984;
+constexpr uint32_t AUDIO_00010_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00010_CHANNELS = 1;
+constexpr uint8_t AUDIO_00010_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00010_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 1665ms (73,466 samples)
 extern const int16_t AUDIO_00011_DATA[];
-extern const size_t AUDIO_00011_SAMPLE_COUNT;
-extern const size_t AUDIO_00011_BYTE_SIZE;
-extern const uint32_t AUDIO_00011_SAMPLE_RATE;
-extern const uint8_t AUDIO_00011_CHANNELS;
-extern const uint8_t AUDIO_00011_BIT_DEPTH;
+constexpr size_t AUDIO_00011_SAMPLE_COUNT = 73466;
+constexpr size_t AUDIO_00011_BYTE_SIZE = 146932;
+constexpr uint32_t AUDIO_00011_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00011_CHANNELS = 1;
+constexpr uint8_t AUDIO_00011_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00011_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
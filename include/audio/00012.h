@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 2188ms (96,529 samples)
 extern const int16_t AUDIO_00012_DATA[];
-extern const size_t AUDIO_00012_SAMPLE_COUNT;
-extern const size_t AUDIO_00012_BYTE_SIZE;
-extern const uint32_t AUDIO_00012_SAMPLE_RATE;
-extern const uint8_t AUDIO_00012_CHANNELS;
-extern const uint8_t AUDIO_00012_BIT_DEPTH;
+constexpr size_t AUDIO_00012_SAMPLE_COUNT = 96529;
+constexpr size_t AUDIO_00012_BYTE_SIZE = 193058;
+constexpr uint32_t AUDIO_00012_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00012_CHANNELS = 1;
+constexpr uint8_t AUDIO_00012_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00012_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 5287ms (233,199 samples)
 extern const int16_t AUDIO_00013_DATA[];
-extern const size_t AUDIO_00013_SAMPLE_COUNT;
-extern const size_t AUDIO_00013_BYTE_SIZE;
-extern const uint32_t AUDIO_00013_SAMPLE_RATE;
-extern const uint8_t AUDIO_00013_CHANNELS;
-extern const uint8_t AUDIO_00013_BIT_DEPTH;
+constexpr size_t AUDIO_00013_SAMPLE_COUNT = 233199;
+constexpr size_t AUDIO_00013_BYTE_SIZE = 466398;
+constexpr uint32_t AUDIO_00013_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00013_CHANNELS = 1;
+constexpr uint8_t AUDIO_00013_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00013_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 8387ms (369,870 samples)
 extern const int16_t AUDIO_00014_DATA[];
-extern const size_t AUDIO_00014_SAMPLE_COUNT;
-extern const size_t AUDIO_00014_BYTE_SIZE;
-extern const uint32_t AUDIO_00014_SAMPLE_RATE;
-extern const uint8_t AUDIO_00014_CHANNELS;
-extern const uint8_t AUDIO_00014_BIT_DEPTH;
+constexpr size_t AUDIO_00014_SAMPLE_COUNT = 369870;
+constexpr size_t AUDIO_00014_BYTE_SIZE = 739740;
+constexpr uint32_t AUDIO_00014_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00014_CHANNELS = 1;
+constexpr uint8_t AUDIO_00014_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00014_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 3640ms (160,564 samples)
 extern const int16_t AUDIO_00015_DATA[];
-extern const size_t AUDIO_00015_SAMPLE_COUNT;
-extern const size_t AUDIO_00015_BYTE_SIZE;
-extern const uint32_t AUDIO_00015_SAMPLE_RATE;
-extern const uint8_t AUDIO_00015_CHANNELS;
-extern const uint8_t AUDIO_00015_BIT_DEPTH;
+constexpr size_t AUDIO_00015_SAMPLE_COUNT = 160564;
+constexpr size_t AUDIO_00015_BYTE_SIZE = 321128;
+constexpr uint32_t AUDIO_00015_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00015_CHANNELS = 1;
+constexpr uint8_t AUDIO_00015_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00015_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
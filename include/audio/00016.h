@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 4095ms (180,633 samples)
 extern const int16_t AUDIO_00016_DATA[];
-extern const size_t AUDIO_00016_SAMPLE_COUNT;
-extern const size_t AUDIO_00016_BYTE_SIZE;
-extern const uint32_t AUDIO_00016_SAMPLE_RATE;
-extern const uint8_t AUDIO_00016_CHANNELS;
-extern const uint8_t AUDIO_00016_BIT_DEPTH;
+constexpr size_t AUDIO_00016_SAMPLE_COUNT = 180633;
+constexpr size_t AUDIO_00016_BYTE_SIZE = 361266;
+constexpr uint32_t AUDIO_00016_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00016_CHANNELS = 1;
+constexpr uint8_t AUDIO_00016_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00016_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 17099ms (754,075 samples)
 extern const int16_t AUDIO_00017_DATA[];
-extern const size_t AUDIO_00017_SAMPLE_COUNT;
-extern const size_t AUDIO_00017_BYTE_SIZE;
-extern const uint32_t AUDIO_00017_SAMPLE_RATE;
-extern const uint8_t AUDIO_00017_CHANNELS;
-extern const uint8_t AUDIO_00017_BIT_DEPTH;
+constexpr size_t AUDIO_00017_SAMPLE_COUNT = 754075;
+constexpr size_t AUDIO_00017_BYTE_SIZE = 1508150;
+constexpr uint32_t AUDIO_00017_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00017_CHANNELS = 1;
+constexpr uint8_t AUDIO_00017_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00017_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 12591ms (555,282 samples)
 extern const int16_t AUDIO_00018_DATA[];
-extern const size_t AUDIO_00018_SAMPLE_COUNT;
-extern const size_t AUDIO_00018_BYTE_SIZE;
-extern const uint32_t AUDIO_00018_SAMPLE_RATE;
-extern const uint8_t AUDIO_00018_CHANNELS;
-extern const uint8_t AUDIO_00018_BIT_DEPTH;
+constexpr size_t AUDIO_00018_SAMPLE_COUNT = 555282;
+constexpr size_t AUDIO_00018_BYTE_SIZE = 1110564;
+constexpr uint32_t AUDIO_00018_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00018_CHANNELS = 1;
+constexpr uint8_t AUDIO_00018_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00018_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
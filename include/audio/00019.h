@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 4915ms (216,793 samples)
 extern const int16_t AUDIO_00019_DATA[];
-extern const size_t AUDIO_00019_SAMPLE_COUNT;
-extern const size_t AUDIO_00019_BYTE_SIZE;
-extern const uint32_t AUDIO_00019_SAMPLE_RATE;
-extern const uint8_t AUDIO_00019_CHANNELS;
-extern const uint8_t AUDIO_00019_BIT_DEPTH;
+constexpr size_t AUDIO_00019_SAMPLE_COUNT = 216793;
+constexpr size_t AUDIO_00019_BYTE_SIZE = 433586;
+constexpr uint32_t AUDIO_00019_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00019_CHANNELS = 1;
+constexpr uint8_t AUDIO_00019_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00019_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 3212ms (141,664 samples)
 extern const int16_t AUDIO_00020_DATA[];
-extern const size_t AUDIO_00020_SAMPLE_COUNT;
-extern const size_t AUDIO_00020_BYTE_SIZE;
-extern const uint32_t AUDIO_00020_SAMPLE_RATE;
-extern const uint8_t AUDIO_00020_CHANNELS;
-extern const uint8_t AUDIO_00020_BIT_DEPTH;
+constexpr size_t AUDIO_00020_SAMPLE_COUNT = 141664;
+constexpr size_t AUDIO_00020_BYTE_SIZE = 283328;
+constexpr uint32_t AUDIO_00020_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00020_CHANNELS = 1;
+constexpr uint8_t AUDIO_00020_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00020_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
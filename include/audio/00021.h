@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 5252ms (231,647 samples)
 extern const int16_t AUDIO_00021_DATA[];
-extern const size_t AUDIO_00021_SAMPLE_COUNT;
-extern const size_t AUDIO_00021_BYTE_SIZE;
-extern const uint32_t AUDIO_00021_SAMPLE_RATE;
-extern const uint8_t AUDIO_00021_CHANNELS;
-extern const uint8_t AUDIO_00021_BIT_DEPTH;
+constexpr size_t AUDIO_00021_SAMPLE_COUNT = 231647;
+constexpr size_t AUDIO_00021_BYTE_SIZE = 463294;
+constexpr uint32_t AUDIO_00021_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00021_CHANNELS = 1;
+constexpr uint8_t AUDIO_00021_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00021_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 22958ms (1,012,480 samples)
 extern const int16_t AUDIO_00022_DATA[];
-extern const size_t AUDIO_00022_SAMPLE_COUNT;
-extern const size_t AUDIO_00022_BYTE_SIZE;
-extern const uint32_t AUDIO_00022_SAMPLE_RATE;
-extern const uint8_t AUDIO_00022_CHANNELS;
-extern const uint8_t AUDIO_00022_BIT_DEPTH;
+constexpr size_t AUDIO_00022_SAMPLE_COUNT = 1012480;
+constexpr size_t AUDIO_00022_BYTE_SIZE = 2024960;
+constexpr uint32_t AUDIO_00022_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00022_CHANNELS = 1;
+constexpr uint8_t AUDIO_00022_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00022_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 9373ms (413,355 samples)
 extern const int16_t AUDIO_00023_DATA[];
-extern const size_t AUDIO_00023_SAMPLE_COUNT;
-extern const size_t AUDIO_00023_BYTE_SIZE;
-extern const uint32_t AUDIO_00023_SAMPLE_RATE;
-extern const uint8_t AUDIO_00023_CHANNELS;
-extern const uint8_t AUDIO_00023_BIT_DEPTH;
+constexpr size_t AUDIO_00023_SAMPLE_COUNT = 413355;
+constexpr size_t AUDIO_00023_BYTE_SIZE = 826710;
+constexpr uint32_t AUDIO_00023_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00023_CHANNELS = 1;
+constexpr uint8_t AUDIO_00023_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00023_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -13,11 +13,12 @@ namespace Audio {
 // Format: 44100Hz, 1 channel(s), 16-bit PCM
 // Duration: 6750ms (297,711 samples)
 extern const int16_t AUDIO_00024_DATA[];
-extern const size_t AUDIO_00024_SAMPLE_COUNT;
-extern const size_t AUDIO_00024_BYTE_SIZE;
-extern const uint32_t AUDIO_00024_SAMPLE_RATE;
-extern const uint8_t AUDIO_00024_CHANNELS;
-extern const uint8_t AUDIO_00024_BIT_DEPTH;
+constexpr size_t AUDIO_00024_SAMPLE_COUNT = 297711;
+constexpr size_t AUDIO_00024_BYTE_SIZE = 595422;
+constexpr uint32_t AUDIO_00024_SAMPLE_RATE = 44100;
+constexpr uint8_t AUDIO_00024_CHANNELS = 1;
+constexpr uint8_t AUDIO_00024_BIT_DEPTH = 16;
+extern const uint8_t AUDIO_00024_ENVELOPE[];
 
 } // namespace Audio
 } // namespace Exterminate
@@ -8,6 +8,29 @@
 #include <cstring>
 
 #include "00001.h"
+#include "00002.h"
+#include "00003.h"
+#include "00004.h"
+#include "00005.h"
+#include "00006.h"
+#include "00007.h"
+#include "00008.h"
+#include "00009.h"
+#include "00010.h"
+#include "00011.h"
+#include "00012.h"
+#include "00013.h"
+#include "00014.h"
+#include "00015.h"
+#include "00016.h"
+#include "00017.h"
+#include "00018.h"
+#include "00019.h"
+#include "00020.h"
+#include "00021.h"
+#include "00022.h"
+#include "00023.h"
+#include "00024.h"
 
 namespace Exterminate {
 namespace Audio {
@@ -17,30 +40,234 @@ constexpr uint32_t AUDIO_SAMPLE_RATE = 44100;
 constexpr uint8_t AUDIO_CHANNELS = 1;
 constexpr uint8_t AUDIO_BIT_DEPTH = 16;
 
+// Clip sample encodings
+enum class AudioCodec : uint8_t {
+    PCM16 = 0,      // Raw signed 16-bit samples in data
+    IMA_ADPCM = 1,  // 4-bit IMA-ADPCM blocks in encoded (4:1)
+    MU_LAW = 2      // 8-bit G.711 mu-law bytes in encoded (2:1)
+};
+
+// IMA-ADPCM block layout: int16 first sample, uint8 step index, uint8 pad,
+// then two samples per byte (low nibble first)
+constexpr size_t ADPCM_BLOCK_BYTES = 256;
+constexpr size_t ADPCM_HEADER_BYTES = 4;
+constexpr size_t ADPCM_BLOCK_SAMPLES = 1 + (ADPCM_BLOCK_BYTES - ADPCM_HEADER_BYTES) * 2;
+
+// Clip samples covered by one loudness envelope entry
+constexpr size_t ENVELOPE_BLOCK_SAMPLES = 256;
+
 // PCM audio file registry
 struct AudioFile {
     const char* name;
-    const int16_t* data;
-    size_t sample_count;
-    size_t byte_size;
+    const int16_t* data;        // PCM16 samples (nullptr for compressed clips)
+    size_t sample_count;        // Decoded mono samples
+    size_t byte_size;           // Stored bytes in flash
     uint32_t sample_rate;
     uint8_t channels;
     uint8_t bit_depth;
+    AudioCodec codec;
+    const uint8_t* encoded;     // Compressed payload (nullptr for PCM16)
+    const uint8_t* envelope;    // Loudness (0-255) per ENVELOPE_BLOCK_SAMPLES samples
+    uint32_t loop_start;        // First sample of the loop
+    uint32_t loop_end;          // Sample after the loop (0 = play once)
+};
+
+// Available audio files; constant data in flash, nothing runs at startup
+inline constexpr AudioFile AUDIO_FILES[] = {
+    {"00001.mp3", AUDIO_00001_DATA, AUDIO_00001_SAMPLE_COUNT, AUDIO_00001_BYTE_SIZE,
+     AUDIO_00001_SAMPLE_RATE, AUDIO_00001_CHANNELS, AUDIO_00001_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00001_ENVELOPE, 0, 0},
+    {"00002.mp3", AUDIO_00002_DATA, AUDIO_00002_SAMPLE_COUNT, AUDIO_00002_BYTE_SIZE,
+     AUDIO_00002_SAMPLE_RATE, AUDIO_00002_CHANNELS, AUDIO_00002_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00002_ENVELOPE, 0, 0},
+    {"00003.mp3", AUDIO_00003_DATA, AUDIO_00003_SAMPLE_COUNT, AUDIO_00003_BYTE_SIZE,
+     AUDIO_00003_SAMPLE_RATE, AUDIO_00003_CHANNELS, AUDIO_00003_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00003_ENVELOPE, 0, 0},
+    {"00004.mp3", AUDIO_00004_DATA, AUDIO_00004_SAMPLE_COUNT, AUDIO_00004_BYTE_SIZE,
+     AUDIO_00004_SAMPLE_RATE, AUDIO_00004_CHANNELS, AUDIO_00004_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00004_ENVELOPE, 0, 0},
+    {"00005.mp3", AUDIO_00005_DATA, AUDIO_00005_SAMPLE_COUNT, AUDIO_00005_BYTE_SIZE,
+     AUDIO_00005_SAMPLE_RATE, AUDIO_00005_CHANNELS, AUDIO_00005_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00005_ENVELOPE, 0, 0},
+    {"00006.mp3", AUDIO_00006_DATA, AUDIO_00006_SAMPLE_COUNT, AUDIO_00006_BYTE_SIZE,
+     AUDIO_00006_SAMPLE_RATE, AUDIO_00006_CHANNELS, AUDIO_00006_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00006_ENVELOPE, 0, 0},
+    {"00007.mp3", AUDIO_00007_DATA, AUDIO_00007_SAMPLE_COUNT, AUDIO_00007_BYTE_SIZE,
+     AUDIO_00007_SAMPLE_RATE, AUDIO_00007_CHANNELS, AUDIO_00007_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00007_ENVELOPE, 0, 0},
+    {"00008.mp3", AUDIO_00008_DATA, AUDIO_00008_SAMPLE_COUNT, AUDIO_00008_BYTE_SIZE,
+     AUDIO_00008_SAMPLE_RATE, AUDIO_00008_CHANNELS, AUDIO_00008_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00008_ENVELOPE, 0, 0},
+    {"00009.mp3", AUDIO_00009_DATA, AUDIO_00009_SAMPLE_COUNT, AUDIO_00009_BYTE_SIZE,
+     AUDIO_00009_SAMPLE_RATE, AUDIO_00009_CHANNELS, AUDIO_00009_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00009_ENVELOPE, 0, 0},
+    {"00010.mp3", AUDIO_00010_DATA, AUDIO_00010_SAMPLE_COUNT, AUDIO_00010_BYTE_SIZE,
+     AUDIO_00010_SAMPLE_RATE, AUDIO_00010_CHANNELS, AUDIO_00010_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00010_ENVELOPE, 0, 0},
+    {"00011.mp3", AUDIO_00011_DATA, AUDIO_00011_SAMPLE_COUNT, AUDIO_00011_BYTE_SIZE,
+     AUDIO_00011_SAMPLE_RATE, AUDIO_00011_CHANNELS, AUDIO_00011_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00011_ENVELOPE, 0, 0},
+    {"00012.mp3", AUDIO_00012_DATA, AUDIO_00012_SAMPLE_COUNT, AUDIO_00012_BYTE_SIZE,
+     AUDIO_00012_SAMPLE_RATE, AUDIO_00012_CHANNELS, AUDIO_00012_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00012_ENVELOPE, 0, 0},
+    {"00013.mp3", AUDIO_00013_DATA, AUDIO_00013_SAMPLE_COUNT, AUDIO_00013_BYTE_SIZE,
+     AUDIO_00013_SAMPLE_RATE, AUDIO_00013_CHANNELS, AUDIO_00013_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00013_ENVELOPE, 0, 0},
+    {"00014.mp3", AUDIO_00014_DATA, AUDIO_00014_SAMPLE_COUNT, AUDIO_00014_BYTE_SIZE,
+     AUDIO_00014_SAMPLE_RATE, AUDIO_00014_CHANNELS, AUDIO_00014_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00014_ENVELOPE, 0, 0},
+    {"00015.mp3", AUDIO_00015_DATA, AUDIO_00015_SAMPLE_COUNT, AUDIO_00015_BYTE_SIZE,
+     AUDIO_00015_SAMPLE_RATE, AUDIO_00015_CHANNELS, AUDIO_00015_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00015_ENVELOPE, 0, 0},
+    {"00016.mp3", AUDIO_00016_DATA, AUDIO_00016_SAMPLE_COUNT, AUDIO_00016_BYTE_SIZE,
+     AUDIO_00016_SAMPLE_RATE, AUDIO_00016_CHANNELS, AUDIO_00016_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00016_ENVELOPE, 0, 0},
+    {"00017.mp3", AUDIO_00017_DATA, AUDIO_00017_SAMPLE_COUNT, AUDIO_00017_BYTE_SIZE,
+     AUDIO_00017_SAMPLE_RATE, AUDIO_00017_CHANNELS, AUDIO_00017_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00017_ENVELOPE, 0, 0},
+    {"00018.mp3", AUDIO_00018_DATA, AUDIO_00018_SAMPLE_COUNT, AUDIO_00018_BYTE_SIZE,
+     AUDIO_00018_SAMPLE_RATE, AUDIO_00018_CHANNELS, AUDIO_00018_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00018_ENVELOPE, 0, 0},
+    {"00019.mp3", AUDIO_00019_DATA, AUDIO_00019_SAMPLE_COUNT, AUDIO_00019_BYTE_SIZE,
+     AUDIO_00019_SAMPLE_RATE, AUDIO_00019_CHANNELS, AUDIO_00019_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00019_ENVELOPE, 0, 0},
+    {"00020.mp3", AUDIO_00020_DATA, AUDIO_00020_SAMPLE_COUNT, AUDIO_00020_BYTE_SIZE,
+     AUDIO_00020_SAMPLE_RATE, AUDIO_00020_CHANNELS, AUDIO_00020_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00020_ENVELOPE, 0, 0},
+    {"00021.mp3", AUDIO_00021_DATA, AUDIO_00021_SAMPLE_COUNT, AUDIO_00021_BYTE_SIZE,
+     AUDIO_00021_SAMPLE_RATE, AUDIO_00021_CHANNELS, AUDIO_00021_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00021_ENVELOPE, 0, 0},
+    {"00022.mp3", AUDIO_00022_DATA, AUDIO_00022_SAMPLE_COUNT, AUDIO_00022_BYTE_SIZE,
+     AUDIO_00022_SAMPLE_RATE, AUDIO_00022_CHANNELS, AUDIO_00022_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00022_ENVELOPE, 0, 0},
+    {"00023.mp3", AUDIO_00023_DATA, AUDIO_00023_SAMPLE_COUNT, AUDIO_00023_BYTE_SIZE,
+     AUDIO_00023_SAMPLE_RATE, AUDIO_00023_CHANNELS, AUDIO_00023_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00023_ENVELOPE, 0, 0},
+    {"00024.mp3", AUDIO_00024_DATA, AUDIO_00024_SAMPLE_COUNT, AUDIO_00024_BYTE_SIZE,
+     AUDIO_00024_SAMPLE_RATE, AUDIO_00024_CHANNELS, AUDIO_00024_BIT_DEPTH,
+     AudioCodec::PCM16, nullptr, AUDIO_00024_ENVELOPE, 0, 0},
 };
 
-// Available audio files
-extern const AudioFile AUDIO_FILES[];
-extern const size_t AUDIO_FILE_COUNT;
+constexpr size_t AUDIO_FILE_COUNT = 24;
 
 // Audio file indices for easy access
 enum class AudioIndex : size_t {
     AUDIO_00001 = 0,
-    COUNT = 1
+    AUDIO_00002 = 1,
+    AUDIO_00003 = 2,
+    AUDIO_00004 = 3,
+    AUDIO_00005 = 4,
+    AUDIO_00006 = 5,
+    AUDIO_00007 = 6,
+    AUDIO_00008 = 7,
+    AUDIO_00009 = 8,
+    AUDIO_00010 = 9,
+    AUDIO_00011 = 10,
+    AUDIO_00012 = 11,
+    AUDIO_00013 = 12,
+    AUDIO_00014 = 13,
+    AUDIO_00015 = 14,
+    AUDIO_00016 = 15,
+    AUDIO_00017 = 16,
+    AUDIO_00018 = 17,
+    AUDIO_00019 = 18,
+    AUDIO_00020 = 19,
+    AUDIO_00021 = 20,
+    AUDIO_00022 = 21,
+    AUDIO_00023 = 22,
+    AUDIO_00024 = 23,
+    COUNT = 24
+};
+
+// Clip groups for random playback
+enum class AudioCategory : uint8_t {
+    Phrase = 0,
+    Effect = 1,
+    Ambient = 2,
+    COUNT = 3
+};
+
+// Category of each clip, in AudioIndex order
+inline constexpr AudioCategory AUDIO_CATEGORIES[] = {
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase,
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase,
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase,
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase,
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase,
+    AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase, AudioCategory::Phrase
+};
+
+// Relative chance of each category in playRandomAudio()
+inline constexpr uint8_t AUDIO_CATEGORY_WEIGHTS[] = {
+    4, 2, 1
 };
 
-// Helper functions
+// Perfect hash of the clip names: the seed-0 hash picks a bucket, the
+// bucket's seed hashes the name to a slot holding its index
+constexpr size_t AUDIO_NAME_BUCKETS = 16;
+constexpr size_t AUDIO_NAME_SLOTS = 32;
+constexpr uint16_t AUDIO_NAME_EMPTY = 0xFFFF;
+
+inline constexpr uint16_t AUDIO_NAME_SEEDS[] = {
+    1, 1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1
+};
+
+inline constexpr uint16_t AUDIO_NAME_INDEX[] = {
+    12, 13, 19, 22, 3, 17, 10, 11,
+    7, 20, 5, 4, AUDIO_NAME_EMPTY, 9, 23, 8,
+    AUDIO_NAME_EMPTY, 6, AUDIO_NAME_EMPTY, AUDIO_NAME_EMPTY, 16, AUDIO_NAME_EMPTY, 1, 0,
+    AUDIO_NAME_EMPTY, AUDIO_NAME_EMPTY, 14, 15, 21, 2, 18, AUDIO_NAME_EMPTY
+};
+
+// Seeded 32-bit FNV-1a; must match hash_name() in tools/audio_to_pcm_header.py
+constexpr uint32_t hashAudioName(const char* name, uint32_t seed) {
+    uint32_t hash = 2166136261u ^ seed;
+    for (; *name; ++name) {
+        hash = (hash ^ static_cast<uint8_t>(*name)) * 16777619u;
+    }
+    return hash;
+}
+
+constexpr bool audioNameEquals(const char* a, const char* b) {
+    for (; *a && *a == *b; ++a, ++b) {
+    }
+    return *a == *b;
+}
+
+// Index of a compiled-in clip by name (AudioIndex::COUNT if unknown);
+// two hashes and one compare, folded away for a literal name
+constexpr AudioIndex findAudioIndex(const char* name) {
+    const uint32_t seed = AUDIO_NAME_SEEDS[hashAudioName(name, 0) & (AUDIO_NAME_BUCKETS - 1)];
+    const uint16_t index = AUDIO_NAME_INDEX[hashAudioName(name, seed) & (AUDIO_NAME_SLOTS - 1)];
+    return index != AUDIO_NAME_EMPTY && audioNameEquals(AUDIO_FILES[index].name, name)
+               ? static_cast<AudioIndex>(index)
+               : AudioIndex::COUNT;
+}
+
+// Compiled-in clip by tag, e.g. audioFile<AudioIndex::AUDIO_00001>().sample_rate
+template <AudioIndex Index>
+constexpr const AudioFile& audioFile() {
+    static_assert(Index < AudioIndex::COUNT, "no such clip");
+    return AUDIO_FILES[static_cast<size_t>(Index)];
+}
+
+constexpr uint32_t audioDurationMs(const AudioFile& file) {
+    return static_cast<uint32_t>(static_cast<uint64_t>(file.sample_count) * 1000 / file.sample_rate);
+}
+
+// Category of a clip; clips past the compiled-in table (a larger sound bank) are phrases
+constexpr AudioCategory getAudioCategory(size_t index) {
+    return index < AUDIO_FILE_COUNT ? AUDIO_CATEGORIES[index] : AudioCategory::Phrase;
+}
+
+// Helper functions (these follow a mounted sound bank)
 const AudioFile* getAudioFile(AudioIndex index);
 const AudioFile* getAudioFile(const char* name);
+size_t getAudioFileCount();
+
+// Replace the compiled-in registry (e.g. with a flash sound bank's index);
+// nullptr restores AUDIO_FILES
+void setAudioFileTable(const AudioFile* files, size_t count);
 
 } // namespace Audio
 } // namespace Exterminate
@@ -0,0 +1,80 @@
+#include "AudioBufferPool.h"
+#include "hardware/sync.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Exterminate {
+
+audio_buffer_t AudioBufferPool::buffers_[MAX_BUFFERS];
+mem_buffer_t AudioBufferPool::memory_[MAX_BUFFERS];
+alignas(4) uint8_t AudioBufferPool::arena_[ARENA_BYTES];
+
+AudioBufferPool::AudioBufferPool()
+    : pool_{}
+    , parked_(nullptr)
+    , bufferCount_(0)
+    , circulating_(0)
+    , target_(0)
+    , initialized_(false)
+{
+}
+
+bool AudioBufferPool::init(const audio_buffer_format_t* format, uint bufferCount, uint samplesPerBuffer, uint depth) {
+    const size_t bufferBytes = static_cast<size_t>(samplesPerBuffer) * format->sample_stride;
+    if (bufferCount == 0 || bufferCount > MAX_BUFFERS || bufferBytes * bufferCount > ARENA_BYTES) {
+        return false;
+    }
+
+    // Same layout audio_new_producer_pool() builds, minus the mallocs
+    depth = std::max(1u, std::min(depth, bufferCount));
+    memset(&pool_, 0, sizeof(pool_));
+    pool_.type = audio_buffer_pool::ac_producer;
+    pool_.format = format->format;
+    pool_.free_list_spin_lock = spin_lock_init(PICO_SPINLOCK_ID_AUDIO_FREE_LIST_LOCK);
+    pool_.prepared_list_spin_lock = spin_lock_init(PICO_SPINLOCK_ID_AUDIO_PREPARED_LISTS_LOCK);
+    parked_ = nullptr;
+
+    for (uint i = 0; i < bufferCount; ++i) {
+        memory_[i] = mem_buffer_t{bufferBytes, arena_ + i * bufferBytes, 0};
+        audio_buffer_t& buffer = buffers_[i];
+        buffer.buffer = &memory_[i];
+        buffer.format = format;
+        buffer.sample_count = 0;
+        buffer.max_sample_count = samplesPerBuffer;
+        buffer.user_data = 0;
+        // The first depth buffers are free, the rest parked
+        audio_buffer_t** list = i < depth ? &pool_.free_list : &parked_;
+        buffer.next = *list;
+        *list = &buffer;
+    }
+
+    bufferCount_ = bufferCount;
+    circulating_ = depth;
+    target_ = depth;
+    initialized_ = true;
+    return true;
+}
+
+audio_buffer_t* AudioBufferPool::take() {
+    for (;;) {
+        audio_buffer_t* buffer = take_audio_buffer(&pool_, false);
+        if (!buffer || circulating_ <= target_) {
+            return buffer;
+        }
+        buffer->next = parked_;
+        parked_ = buffer;
+        --circulating_;
+    }
+}
+
+void AudioBufferPool::setDepth(uint depth) {
+    target_ = std::max(1u, std::min(depth, bufferCount_));
+    while (circulating_ < target_ && parked_) {
+        audio_buffer_t* buffer = parked_;
+        parked_ = buffer->next;
+        queue_free_audio_buffer(&pool_, buffer);
+        ++circulating_;
+    }
+}
+
+} // namespace Exterminate
@@ -1,31 +1,181 @@
 #include "AudioController.h"
-#include "audio/audio_index.h"
+#include "AudioKernels.h"
+#include "CycleCounter.h"
+#include <audio/audio_index.h>
 #include "pico/multicore.h"
 #include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
 #include "hardware/pio.h"
+#include "hardware/sync.h"
 #include <algorithm>
 #include <cmath>
 #include <cstring>
+#include <new>
 #include <stdio.h>
 
 namespace Exterminate {
 
+namespace {
+
+// DMA IRQ used by pico-extras to complete I2S buffers
+#ifdef PICO_AUDIO_I2S_DMA_IRQ
+constexpr uint I2S_DMA_IRQ_INDEX = PICO_AUDIO_I2S_DMA_IRQ;
+#else
+constexpr uint I2S_DMA_IRQ_INDEX = 0;
+#endif
+
+// audio_buffer_t::user_data layout: fill time (us, low 24 bits) | level (8 bits)
+constexpr uint32_t STAMP_LEVEL_BITS = 8;
+constexpr uint32_t STAMP_TIME_MASK = 0x00FFFFFFu;
+
+inline uint32_t packIntensityStamp(uint8_t level, uint32_t nowUs) {
+    return ((nowUs & STAMP_TIME_MASK) << STAMP_LEVEL_BITS) | level;
+}
+
+// audio_i2s_connect() copies the producer's buffers into a consumer pool
+// of its own (2 x 256 frames), so the I2S DMA never sees our buffers:
+// not their user_data stamps, not which one is playing, and the copy
+// adds 11.6 ms of queue nobody counts. This connection hands I2S the
+// producer buffers themselves instead. It is static like pico-extras'
+// own connections, so a hooked callback survives a reconnect.
+audio_buffer_t* passThroughProducerTake(audio_connection_t* connection, bool block) {
+    return get_free_audio_buffer(connection->producer_pool, block);
+}
+
+void passThroughProducerGive(audio_connection_t* connection, audio_buffer_t* buffer) {
+    queue_full_audio_buffer(connection->producer_pool, buffer);
+}
+
+audio_buffer_t* passThroughConsumerTake(audio_connection_t* connection, bool block) {
+    return get_full_audio_buffer(connection->producer_pool, block);
+}
+
+void passThroughConsumerGive(audio_connection_t* connection, audio_buffer_t* buffer) {
+    queue_free_audio_buffer(connection->producer_pool, buffer);
+}
+
+audio_connection_t s_i2sPassThrough = {
+    .producer_pool_take = &passThroughProducerTake,
+    .producer_pool_give = &passThroughProducerGive,
+    .consumer_pool_take = &passThroughConsumerTake,
+    .consumer_pool_give = &passThroughConsumerGive,
+    .producer_pool = nullptr,
+    .consumer_pool = nullptr
+};
+
+// audio_i2s_connect_extra() still mallocs a consumer pool, the one heap
+// allocation of the output path. The pass-through connection never takes
+// from it, so it is a single frame that never holds audio and adds
+// nothing to the queue depth or latency.
+constexpr uint I2S_CONSUMER_BUFFERS = 1;
+constexpr uint I2S_CONSUMER_SAMPLES = 1;
+
+// Output chain tuning for the MAX98357A into a small full-range speaker:
+// cut what the cone cannot reproduce, lift speech presence, then keep
+// the level up without ever clipping
+// Mic-to-speaker target for the live Dalek voice
+constexpr uint32_t DALEK_LATENCY_TARGET_US = 10000;
+
+constexpr float OUTPUT_DC_CORNER_HZ = 20.0f;
+constexpr AudioDsp::Biquad::Config SPEAKER_HIGH_PASS{AudioDsp::Biquad::Type::HighPass, 150.0f, 0.7071f, 0.0f};
+constexpr AudioDsp::Biquad::Config SPEAKER_PRESENCE{AudioDsp::Biquad::Type::Peaking, 3000.0f, 1.0f, 3.0f};
+constexpr AudioDsp::Compressor::Config SPEAKER_COMPRESSOR{
+    .thresholdDb = -18.0f, .ratio = 3.0f, .attackMs = 3.0f, .releaseMs = 150.0f, .makeupDb = 6.0f};
+constexpr int32_t SPEAKER_LIMIT_KNEE = 24000;
+constexpr int32_t SPEAKER_LIMIT_CEILING = 32000;
+
+} // namespace
+
 // Static instance for audio callbacks
 AudioController* AudioController::instance_ = nullptr;
 
+
+// Original I2S consumer take callback, wrapped by consumerTakeHook()
+audio_buffer_t* (*AudioController::s_consumerTake)(audio_connection_t*, bool) = nullptr;
+
 AudioController::AudioController(const Config& config)
     : config_(config)
     , playbackState_(PlaybackState::Stopped)
     , volume_(1.0f)
+    , volumeQ15_(AudioMixer::UNITY_GAIN)
     , audioIntensity_(0.0f)
     , bufferPool_(nullptr)
     , actualI2SFormat_(nullptr)
     , initialized_(false)
     , pio_instance_(nullptr)
     , pio_sm_(-1)
-    , currentAudioData_(nullptr)
-    , currentAudioSize_(0)
-    , currentAudioPosition_(0)
+    , streamingActive_(false)
+    , refillIrq_(-1)
+    , refillRequests_(0)
+    , synthPitch_(SynthEngine::PITCH_UNITY)
+    , nextSynthNote_(SynthEngine::NO_NOTE)
+    , synthNotesStarted_(SynthEngine::NO_NOTE)
+    , synthNotes_{}
+    , speechPitchQ12_(AudioMixer::PITCH_UNITY)
+    , activeVoices_(0)
+    , stretching_(false)
+    , lastStretchCycles_(0)
+    , peakStretchCycles_(0)
+    , dalekActive_(false)
+    , dalekRunning_(false)
+    , lastMicLatencyUs_(0)
+    , peakMicLatencyUs_(0)
+    , micDroppedSamples_(0)
+    , micUnderruns_(0)
+    , lastDalekCycles_(0)
+    , peakDalekCycles_(0)
+    , dalekMinGain_(DalekVoice::UNITY_GAIN)
+    , core1Running_(false)
+    , core1Exited_(true)
+    , underruns_(0)
+    , overruns_(0)
+    , buffersProduced_(0)
+    , playbackEnds_(0)
+    , droppedTriggers_(0)
+    , primed_(false)
+    , queuedSamples_(0)
+    , queueDepth_{}
+    , statsWindowStartUs_(0)
+    , windowBuffers_(0)
+    , windowFills_(0)
+    , windowFillCycles_(0)
+    , buffersPerSecond_(0)
+    , avgFillCycles_(0)
+    , adaptUnderruns_(0)
+    , adaptFills_(0)
+    , adaptPressureUs_(0)
+    , peakBufferDepth_(0)
+    , depthGrows_(0)
+    , depthShrinks_(0)
+    , directActive_(false)
+    , directFile_(nullptr)
+    , connection_(nullptr)
+    , playoutStartUs_(0)
+    , lastFillLeadUs_(0)
+    , peakFillLeadUs_(0)
+    , hotStartClipCount_(0)
+    , hotBuffer_(nullptr)
+    , triggerUs_(0)
+    , triggerPending_(false)
+    , lastTriggerLatencyUs_(0)
+    , peakTriggerLatencyUs_(0)
+    , hotStarts_(0)
+    , latencySamples_(0)
+    , cacheFillActive_(false)
+    , standbyTimerActive_(false)
+    , standby_(false)
+    , lastActiveUs_(0)
+    , standbyEntries_(0)
+    , wakes_(0)
+    , ampWarmupSamples_(0)
+    , wakePending_(false)
+    , lastWakeLatencyUs_(0)
+    , peakWakeLatencyUs_(0)
+    , lastFillCycles_(0)
+    , peakFillCycles_(0)
+    , minFillCycles_(UINT32_MAX)
+    , fillBudgetCycles_(0)
 {
     printf("AudioController: Created with Pico Extras I2S - data_pin=%u, clock_base=%u, sample_rate=%u\n",
            config_.dataPin, config_.clockPinBase, config_.sampleRate);
@@ -48,6 +198,9 @@ bool AudioController::initialize() {
     // Set static instance for callbacks
     instance_ = this;
 
+    // Fill cost is reported in core cycles
+    CycleCounter::enable();
+
     // Configure audio format for I2S output
     // I2S typically expects stereo output, so we'll use 2 channels
     // Our mono audio files will be duplicated to both channels
@@ -112,6 +265,18 @@ bool AudioController::initialize() {
 
     // Store the actual format for later use
     actualI2SFormat_ = actualFormat;
+    
+    // Clips at other rates are converted to the I2S rate by the mixer
+    mixer_.setOutputRate(actualFormat->sample_freq);
+    synth_.setSampleRate(actualFormat->sample_freq);
+    fillBudgetCycles_ = getFillBudgetCycles();
+    stretch_.configure(actualFormat->sample_freq);
+    configureOutputChain(outputChain_, actualFormat->sample_freq);
+    
+    // PSRAM setup uses QMI direct mode, so it must run before core1 starts
+    if (config_.clipCache) {
+        setupClipCache();
+    }
 
     printf("AudioController: I2S setup successful\n");
     printf("AudioController: I2S actual format - %uHz, %u channels\n", 
@@ -125,32 +290,86 @@ bool AudioController::initialize() {
         .sample_stride = static_cast<uint16_t>(actualFormat->channel_count * 2)
     };
 
-    bufferPool_ = audio_new_producer_pool(&bufferFormat_, config_.bufferCount, config_.samplesPerBuffer);
-    if (!bufferPool_) {
-        printf("AudioController: ERROR - Failed to create buffer pool\n");
+    // Every buffer the adaptive depth may use is laid out now; the ones
+    // above bufferCount start parked
+    const uint poolBuffers = std::max(config_.bufferCount, config_.maxBufferCount);
+    if (!producerPool_.init(&bufferFormat_, poolBuffers, config_.samplesPerBuffer, config_.bufferCount)) {
+        printf("AudioController: ERROR - %u buffers of %u samples exceed the %u buffer, %u byte pool\n",
+               poolBuffers, config_.samplesPerBuffer, AudioBufferPool::MAX_BUFFERS,
+               static_cast<unsigned>(AudioBufferPool::ARENA_BYTES));
         return false;
     }
+    bufferPool_ = producerPool_.get();
+    peakBufferDepth_ = producerPool_.getDepth();
 
-    printf("AudioController: Created producer buffer pool - %u buffers, %u samples each\n",
-           config_.bufferCount, config_.samplesPerBuffer);
+    printf("AudioController: Created static producer pool - %u buffers (%u-%u queued), %u samples each\n",
+           poolBuffers, config_.bufferCount, poolBuffers, config_.samplesPerBuffer);
 
-    // Connect our producer pool to the I2S consumer
-    bool connect_ok = audio_i2s_connect(bufferPool_);
+    // Connect our producer pool to the I2S consumer, which plays its buffers in place
+    bool connect_ok = audio_i2s_connect_extra(bufferPool_, false, I2S_CONSUMER_BUFFERS, I2S_CONSUMER_SAMPLES,
+                                              &s_i2sPassThrough);
     if (!connect_ok) {
         printf("AudioController: ERROR - Failed to connect buffer pool to I2S\n");
-        // TODO: Add proper buffer pool cleanup when we find the right function
         bufferPool_ = nullptr;
         return false;
     }
 
     printf("AudioController: Connected producer pool to I2S consumer\n");
 
+    // Observe the consumer side of the connection for underruns and refills
+    installConnectionHooks();
+    if (config_.refillOnRelease && config_.streamingMode == StreamingMode::Timer) {
+        setupRefillIrq();
+    }
+    
+    // Hot start swaps buffers from core0 thread context, so it needs the
+    // producer on core0 and the refill IRQ to keep silence queued
+    if (config_.hotStart && refillIrq_ >= 0) {
+        prerenderHotStartClips();
+    }
+
+    // The amplifier runs whenever I2S does
+    if (config_.ampShutdownPin != NO_PIN) {
+        gpio_init(config_.ampShutdownPin);
+        gpio_set_dir(config_.ampShutdownPin, GPIO_OUT);
+        gpio_put(config_.ampShutdownPin, true);
+    }
+
     // Enable I2S output
     audio_i2s_set_enabled(true);
 
     printf("AudioController: I2S enabled\n");
 
+    // pico-extras runs I2S on the PIO block chosen at compile time
+#ifdef PICO_AUDIO_I2S_PIO
+    PIO i2sPio = pio_get_instance(PICO_AUDIO_I2S_PIO);
+#else
+    PIO i2sPio = pio0;
+#endif
+    // Only reachable with the output chain off, so only then worth two DMA channels and DMA_IRQ_1
+    if (config_.directPlayback && !config_.outputDsp &&
+        !direct_.begin(i2sPio, i2sConfig_.pio_sm, &AudioController::onDirectComplete)) {
+        printf("AudioController: Direct playback unavailable - using the mixer only\n");
+    }
+    
+    // Claimed after I2S so the channel found for pico-extras stays free
+    if (config_.prefetch && prefetcher_.begin()) {
+        mixer_.setPrefetcher(&prefetcher_);
+    }
+
+    if (config_.streamingMode == StreamingMode::Core1) {
+        startCore1Engine();
+    }
+
     initialized_ = true;
+    
+    // Start the silent stream that hot start triggers swap into
+    if (keepAlive()) {
+        requestRefill();
+    }
+    lastActiveUs_ = time_us_32();
+    startStandbyTimer();
+    
     printf("AudioController: Initialization complete!\n");
     return true;
 }
@@ -163,20 +382,45 @@ void AudioController::shutdown() {
     printf("AudioController: Shutting down...\n");
     
     stopAudio();
+    mic_.end();
+    stopCore1Engine();
+    releaseRefillIrq();
+    direct_.end();
     
-    // Disable I2S
-    audio_i2s_set_enabled(false);
+    if (cacheFillActive_) {
+        cancel_repeating_timer(&cacheFillTimer_);
+        cacheFillActive_ = false;
+    }
+    if (standbyTimerActive_) {
+        cancel_repeating_timer(&standbyTimer_);
+        standbyTimerActive_ = false;
+    }
+    // Apply the queued StopAll so no voice still reads a cached clip
+    uint32_t interrupts = save_and_disable_interrupts();
+    processCommands();
+    restore_interrupts(interrupts);
+    clipCache_.end();
+    mixer_.setPrefetcher(nullptr);
+    prefetcher_.end();
+    hotBuffer_ = nullptr;
+    hotStartClips_.reset();
+    hotStartClipCount_ = 0;
     
-    if (bufferPool_) {
-        // TODO: Add proper buffer pool cleanup when we find the right function
-        bufferPool_ = nullptr;
+    // Disable I2S and the amplifier
+    audio_i2s_set_enabled(false);
+    if (config_.ampShutdownPin != NO_PIN) {
+        gpio_put(config_.ampShutdownPin, false);
     }
+    standby_ = false;
+    
+    // The pool's arena is static; the next initialize() lays it out again
+    bufferPool_ = nullptr;
     
     initialized_ = false;
     printf("AudioController: Shutdown complete\n");
 }
 
-bool AudioController::playAudio(Audio::AudioIndex audioIndex) {
+bool AudioController::playAudio(Audio::AudioIndex audioIndex, float gain, AudioMixer::VoicePriority priority) {
     if (!initialized_) {
         printf("AudioController: ERROR - Not initialized\n");
         return false;
@@ -192,54 +436,423 @@ bool AudioController::playAudio(Audio::AudioIndex audioIndex) {
     printf("AudioController: Playing audio file '%s' - %zu samples, %u Hz\n",
            audioFile->name, audioFile->sample_count, audioFile->sample_rate);
 
-    // Stop any current playback
-    stopAudio();
+    // The mixer needs the I2S FIFO back
+    if (directActive_) {
+        direct_.stop();
+        finishDirectPlayback();
+    }
 
-    // Set up new audio data
-    currentAudioData_ = audioFile->data;
-    currentAudioSize_ = audioFile->sample_count;
-    currentAudioPosition_ = 0;
+    // Convert voice gain to Q15 for the mixer
+    gain = std::max(0.0f, std::min(1.0f, gain));
+    uint16_t gainQ15 = static_cast<uint16_t>(gain * AudioMixer::UNITY_GAIN);
+    
+    // Play the decoded PSRAM copy when there is one; it stays pinned
+    // until the mixer releases the voice. The fill timer shares core0.
+    uint32_t interrupts = save_and_disable_interrupts();
+    const Audio::AudioFile* playFile = clipCache_.acquire(audioFile);
+    restore_interrupts(interrupts);
 
-    // Instead of multicore, use timer-based audio streaming on the same core
-    printf("AudioController: Audio acknowledged - starting timer-based streaming\n");
-    printf("AudioController: Using single-core approach to avoid BluePad32 conflicts\n");
-    printf("AudioController: Creating LED pulse effect\n");
+    // Latency is measured for triggers that start from silence
+    const bool woke = wakeFromStandby();
+    triggerUs_ = time_us_32();
+    triggerPending_ = activeVoices_ == 0 && commands_.empty();
+    wakePending_ = woke && triggerPending_;
+
+    // Swap the clip's pre-rendered first buffer into the queued silence
+    if (tryHotStart(audioIndex, playFile, gainQ15, priority)) {
+        audioIntensity_ = 0.9f;  // High intensity for LED reaction
+        startTimerBasedAudioStreaming();
+        requestRefill();
+        return true;
+    }
+
+    // Hand the clip to the producer; existing voices keep playing
+    AudioCommand command{AudioCommand::Type::Play, playFile, gainQ15, priority, 0, nullptr};
+    if (!postCommand(command)) {
+        printf("AudioController: Command queue full - '%s' dropped\n", audioFile->name);
+        clipCache_.release(playFile);
+        return false;
+    }
     
     // Create LED pulse effect
     audioIntensity_ = 0.9f;  // High intensity for LED reaction
     
-    // Start timer-based audio worker instead of multicore
-    startTimerBasedAudioStreaming();
+    // Start timer-based audio worker if it is not already streaming
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    
+    // Fill the first buffer now rather than at the next release or tick
+    requestRefill();
     
     return true;
 }
 
+bool AudioController::queueAudio(Audio::AudioIndex audioIndex, float gain, AudioMixer::VoicePriority priority) {
+    if (!initialized_) {
+        printf("AudioController: ERROR - Not initialized\n");
+        return false;
+    }
+
+    const Audio::AudioFile* audioFile = Audio::getAudioFile(audioIndex);
+    if (!audioFile) {
+        printf("AudioController: ERROR - Invalid audio index %d\n", static_cast<int>(audioIndex));
+        return false;
+    }
+
+    // Direct playback cannot chain; hand the clip to the mixer instead
+    if (directActive_) {
+        return playAudio(audioIndex, gain, priority);
+    }
+
+    gain = std::max(0.0f, std::min(1.0f, gain));
+    uint16_t gainQ15 = static_cast<uint16_t>(gain * AudioMixer::UNITY_GAIN);
+
+    wakeFromStandby();
+
+    // Resolve the clip now so the seam is a reader switch on the producer
+    uint32_t interrupts = save_and_disable_interrupts();
+    const Audio::AudioFile* playFile = clipCache_.acquire(audioFile);
+    restore_interrupts(interrupts);
+
+    AudioCommand command{AudioCommand::Type::Queue, playFile, gainQ15, priority, 0, nullptr};
+    if (!postCommand(command)) {
+        printf("AudioController: Command queue full - '%s' dropped\n", audioFile->name);
+        clipCache_.release(playFile);
+        return false;
+    }
+
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    requestRefill();
+    return true;
+}
+
+SynthEngine::NoteId AudioController::playSynth(const SynthPatch& patch, float gain) {
+    if (!initialized_) {
+        printf("AudioController: ERROR - Not initialized\n");
+        return SynthEngine::NO_NOTE;
+    }
+
+    // The synth needs the I2S FIFO back
+    if (directActive_) {
+        direct_.stop();
+        finishDirectPlayback();
+    }
+
+    gain = std::max(0.0f, std::min(1.0f, gain));
+    uint16_t gainQ15 = static_cast<uint16_t>(gain * SynthEngine::UNITY_GAIN);
+
+    const bool woke = wakeFromStandby();
+    triggerUs_ = time_us_32();
+    triggerPending_ = activeVoices_ == 0 && commands_.empty();
+    wakePending_ = woke && triggerPending_;
+
+    SynthEngine::NoteId note = ++nextSynthNote_;
+    if (note == SynthEngine::NO_NOTE) {
+        note = ++nextSynthNote_;
+    }
+    AudioCommand command{AudioCommand::Type::Synth, nullptr, gainQ15, AudioMixer::VoicePriority::Effect, 0, &patch, note};
+    if (!postCommand(command)) {
+        printf("AudioController: Command queue full - synth note dropped\n");
+        return SynthEngine::NO_NOTE;
+    }
+
+    audioIntensity_ = 0.9f;  // High intensity for LED reaction
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    requestRefill();
+    return note;
+}
+
+void AudioController::releaseSynth(SynthEngine::NoteId note) {
+    if (note == SynthEngine::NO_NOTE) {
+        return;
+    }
+    AudioCommand command{AudioCommand::Type::SynthRelease, nullptr, 0, AudioMixer::VoicePriority::Effect, 0, nullptr, note};
+    postCommand(command);
+    requestRefill();
+}
+
+void AudioController::setSynthPitch(SynthEngine::NoteId note, float scale) {
+    scale = std::max(0.25f, std::min(8.0f, scale));
+    const uint16_t scaleQ12 = static_cast<uint16_t>(std::min(scale * SynthEngine::PITCH_UNITY, 65535.0f));
+    // One word, so a fill never pairs a note with another note's pitch
+    synthPitch_ = (static_cast<uint32_t>(note) << 16) | scaleQ12;
+}
+
+bool AudioController::isSynthPlaying(SynthEngine::NoteId note) const {
+    if (note == SynthEngine::NO_NOTE) {
+        return false;
+    }
+    // Not yet started by the producer: still queued
+    if (static_cast<int16_t>(note - synthNotesStarted_.load()) > 0) {
+        return true;
+    }
+    for (const auto& sounding : synthNotes_) {
+        if (sounding.load() == note) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void AudioController::publishSynthNotes(SynthEngine::NoteId started) {
+    for (size_t i = 0; i < SynthEngine::MAX_VOICES; ++i) {
+        synthNotes_[i] = synth_.voiceNote(i);
+    }
+    if (started != SynthEngine::NO_NOTE) {
+        synthNotesStarted_ = started;
+    }
+}
+
+void AudioController::setSpeechPitch(float scale) {
+    scale = std::max(0.5f, std::min(2.0f, scale));
+    speechPitchQ12_ = static_cast<uint16_t>(scale * AudioMixer::PITCH_UNITY + 0.5f);
+}
+
+AudioController::PitchBendStats AudioController::getPitchBendStats() const {
+    return PitchBendStats{
+        lastStretchCycles_.load(),
+        peakStretchCycles_.load(),
+        stretch_.getSequenceCount(),
+        stretching_.load()
+    };
+}
+
+bool AudioController::startDalekVoice() {
+    if (!initialized_) {
+        printf("AudioController: ERROR - Not initialized\n");
+        return false;
+    }
+    if (dalekActive_) {
+        return true;
+    }
+
+    wakeFromStandby();
+
+    // The mic is mixed, so the mixer needs the I2S FIFO back
+    if (directActive_) {
+        direct_.stop();
+        finishDirectPlayback();
+    }
+
+    if (!mic_.begin(config_.micPin, actualI2SFormat_->sample_freq)) {
+        return false;
+    }
+
+    AudioCommand command{AudioCommand::Type::DalekStart, nullptr, 0, AudioMixer::VoicePriority::Speech, 0, nullptr};
+    if (!postCommand(command)) {
+        printf("AudioController: Command queue full - Dalek voice not started\n");
+        mic_.end();
+        return false;
+    }
+    dalekActive_ = true;
+
+    // The whole output queue plus about one buffer of mic backlog. I2S
+    // plays the producer buffers in place, so no consumer pool adds to it.
+    const uint depth = producerPool_.getDepth();
+    const uint32_t queuedUs = getQueueLatencyUs();
+    const uint32_t bufferUs = static_cast<uint32_t>(
+        (static_cast<uint64_t>(config_.samplesPerBuffer) * 1000000) / actualI2SFormat_->sample_freq);
+    const uint32_t expectedUs = queuedUs + bufferUs;
+    printf("AudioController: Dalek voice on - %u buffers of %u samples queue %u us, about %u us mic to speaker%s\n",
+           depth, config_.samplesPerBuffer, static_cast<unsigned>(queuedUs), static_cast<unsigned>(expectedUs),
+           expectedUs > DALEK_LATENCY_TARGET_US ? " (over the 10 ms target)" : "");
+
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    requestRefill();
+    return true;
+}
+
+void AudioController::stopDalekVoice() {
+    if (!dalekActive_.exchange(false)) {
+        return;
+    }
+
+    AudioCommand command{AudioCommand::Type::DalekStop, nullptr, 0, AudioMixer::VoicePriority::Speech, 0, nullptr};
+    postCommand(command);
+    
+    // Until the producer applies the stop it just finds the ring empty
+    mic_.end();
+    requestRefill();
+    printf("AudioController: Dalek voice off\n");
+}
+
+AudioController::DalekVoiceStats AudioController::getDalekVoiceStats() {
+    return DalekVoiceStats{
+        lastMicLatencyUs_.load(),
+        peakMicLatencyUs_.load(),
+        micDroppedSamples_.load(),
+        micUnderruns_.load(),
+        mic_.getOverrunCount(),
+        lastDalekCycles_.load(),
+        peakDalekCycles_.load(),
+        dalekMinGain_.exchange(DalekVoice::UNITY_GAIN)
+    };
+}
+
+bool AudioController::playAudioDirect(Audio::AudioIndex audioIndex) {
+    if (!initialized_) {
+        printf("AudioController: ERROR - Not initialized\n");
+        return false;
+    }
+
+    const Audio::AudioFile* audioFile = Audio::getAudioFile(audioIndex);
+    if (!audioFile) {
+        printf("AudioController: ERROR - Invalid audio index %d\n", static_cast<int>(audioIndex));
+        return false;
+    }
+
+    // DMA sends samples as stored, so anything needing the mixer, rate
+    // conversion (pitch bend included), a volume change or the output
+    // chain goes through the buffered path
+    bool mixerIdle = activeVoices_ == 0 && commands_.empty();
+    bool nativeRate = audioFile->sample_rate == mixer_.getOutputRate() &&
+                      speechPitchQ12_ == AudioMixer::PITCH_UNITY;
+    bool playsOnce = audioFile->loop_end == 0;
+    if (!direct_.isReady() || !DirectPlayback::canStream(audioFile) || !nativeRate || !playsOnce ||
+        volumeQ15_ < AudioMixer::UNITY_GAIN || !mixerIdle || config_.outputDsp) {
+        return playAudio(audioIndex);
+    }
+
+    // Direct playback starts at once; only the buffered path queues
+    // silence ahead of the audio while the amplifier starts up
+    if (standby_ && config_.ampShutdownPin != NO_PIN) {
+        return playAudio(audioIndex);
+    }
+
+    if (directActive_) {
+        direct_.stop();
+        finishDirectPlayback();
+    }
+    // I2S is taken over below either way
+    wakeFromStandby();
+
+    printf("AudioController: Direct playback of '%s' - %zu samples\n",
+           audioFile->name, audioFile->sample_count);
+
+    // Take the PIO FIFO from the pico-extras DMA channel; disabling I2S
+    // returns its in-flight buffer but leaves the channel mid-transfer
+    audio_i2s_set_enabled(false);
+    dma_channel_abort(i2sConfig_.dma_channel);
+    dma_irqn_acknowledge_channel(I2S_DMA_IRQ_INDEX, i2sConfig_.dma_channel);
+
+    directFile_ = audioFile;
+    triggerPending_ = false;
+    directActive_ = true;
+    primed_ = false;
+    playbackState_ = PlaybackState::Playing;
+    if (!direct_.start(&audioFile, 1)) {
+        finishDirectPlayback();
+        return playAudio(audioIndex);
+    }
+
+    audioIntensity_ = 0.9f;  // High intensity for LED reaction
+    
+    // The streaming timer keeps the LED intensity moving
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    return true;
+}
+
+void AudioController::finishDirectPlayback() {
+    if (!directActive_.exchange(false)) {
+        return;
+    }
+
+    // Queued triggers resume on the buffered path
+    if (commands_.empty()) {
+        playbackState_ = PlaybackState::Stopped;
+    }
+    primed_ = false;
+    audio_i2s_set_enabled(true);
+}
+
+void AudioController::onDirectComplete() {
+    AudioController* controller = AudioController::instance_;
+    if (controller) {
+        controller->finishDirectPlayback();
+    }
+}
+
+void AudioController::setupClipCache() {
+    if (!psram_.begin() || !clipCache_.begin(&psram_)) {
+        printf("AudioController: No PSRAM - clips play from flash\n");
+        return;
+    }
+    mixer_.setReleaseCallback(&AudioController::onVoiceReleased, this);
+    
+    // Misses are decoded in slices from a core0 timer, never in playAudio()
+    cacheFillActive_ = add_repeating_timer_ms(CACHE_FILL_MS, [](repeating_timer_t* rt) -> bool {
+        static_cast<ClipCache*>(rt->user_data)->service(CACHE_FILL_SAMPLES);
+        return true;
+    }, &clipCache_, &cacheFillTimer_);
+    if (!cacheFillActive_) {
+        printf("AudioController: ERROR - No alarm slots available for clip cache fill\n");
+        clipCache_.end();
+    }
+}
+
+void AudioController::onVoiceReleased(const Audio::AudioFile* file, void* context) {
+    static_cast<AudioController*>(context)->clipCache_.release(file);
+}
+
+void AudioController::serviceDirectPlayback() {
+    const int16_t* samples = nullptr;
+    direct_.peek(&samples);
+    const Audio::AudioFile* file = directFile_;
+    if (samples && file) {
+        updateAudioIntensity(AudioMixer::envelopeAt(file, samples - file->data));
+    }
+}
+
 bool AudioController::playRandomAudio() {
     if (!initialized_) {
         printf("AudioController: Cannot play random audio - not initialized\n");
         return false;
     }
 
-    // For now, we only have one audio file, so "random" is just that one file
-    // In the future, when more audio files are added, we can implement proper randomization
-    Audio::AudioIndex randomIndex = Audio::AudioIndex::AUDIO_00001;
-    
-    printf("AudioController: Triggering random audio (simplified mode)\n");
+    // Deal the decks on first use (the press time seeds the generator) and
+    // again if a sound bank changed the clip count
+    const size_t clipCount = Audio::getAudioFileCount();
+    if (shuffle_.getClipCount() != clipCount) {
+        shuffle_.seed(time_us_32());
+        shuffle_.configure(clipCount);
+    }
+
+    Audio::AudioIndex randomIndex;
+    if (!shuffle_.next(&randomIndex)) {
+        printf("AudioController: Cannot play random audio - no clips\n");
+        return false;
+    }
+
+    printf("AudioController: Triggering random audio %u\n", static_cast<unsigned>(randomIndex));
     return playAudio(randomIndex);
 }
 
 bool AudioController::stopAudio() {
-    if (playbackState_ == PlaybackState::Stopped) {
+    if (playbackState_ == PlaybackState::Stopped && commands_.empty()) {
         return true;
     }
 
     printf("AudioController: Stopping audio playback\n");
     
+    if (directActive_) {
+        direct_.stop();
+        finishDirectPlayback();
+    }
     playbackState_ = PlaybackState::Stopped;
+    stopDalekVoice();
     
-    currentAudioData_ = nullptr;
-    currentAudioSize_ = 0;
-    currentAudioPosition_ = 0;
+    // Voices are released by the producer, after any triggers already queued
+    AudioCommand command{AudioCommand::Type::StopAll, nullptr, 0, AudioMixer::VoicePriority::Ambient, 0, nullptr};
+    postCommand(command);
     audioIntensity_ = 0.0f;
     
     return true;
@@ -262,6 +875,12 @@ bool AudioController::resumeAudio() {
 
     printf("AudioController: Resuming audio playback\n");
     playbackState_ = PlaybackState::Playing;
+    
+    // The streaming timer stops itself while paused
+    if (config_.streamingMode == StreamingMode::Timer) {
+        startTimerBasedAudioStreaming();
+    }
+    requestRefill();
     return true;
 }
 
@@ -269,84 +888,859 @@ void AudioController::setVolume(float volume) {
     // Clamp volume to valid range
     volume = std::max(0.0f, std::min(1.0f, volume));
     volume_ = volume;
+    volumeQ15_ = AudioKernels::volumeToQ15(volume);
     printf("AudioController: Volume set to %.2f\n", volume);
 }
 
+uint32_t AudioController::getFillBudgetCycles() const {
+    return CycleCounter::budgetForSamples(config_.samplesPerBuffer, config_.sampleRate);
+}
+
+uint32_t AudioController::getQueueLatencyUs() const {
+    // The producer buffers are the whole queue; the consumer pool stays empty
+    const uint32_t rate = actualI2SFormat_ ? actualI2SFormat_->sample_freq : config_.sampleRate;
+    if (rate == 0) {
+        return 0;
+    }
+    const uint64_t frames = static_cast<uint64_t>(producerPool_.getDepth()) * config_.samplesPerBuffer;
+    return static_cast<uint32_t>(frames * 1000000 / rate);
+}
+
+void AudioController::benchmarkSamplePaths() {
+    // Stereo scratch for one buffer; static to stay off the small core0 stack
+    static constexpr size_t BENCH_SAMPLES = 512;
+    alignas(4) static int16_t scratch[BENCH_SAMPLES * 2];
+    static constexpr int ITERATIONS = 16;
+
+    const size_t samples = std::min<size_t>(config_.samplesPerBuffer, BENCH_SAMPLES);
+    const float vol = 0.8f;
+    const uint16_t volQ15 = AudioKernels::volumeToQ15(vol);
+
+    auto seed = [&]() {
+        for (size_t i = 0; i < samples; ++i) {
+            scratch[i] = static_cast<int16_t>((i * 2654435761u) >> 16);
+        }
+    };
+
+    CycleCounter::enable();
+
+    uint32_t referenceCycles = 0;
+    uint32_t kernelCycles = 0;
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        seed();
+        uint32_t start = CycleCounter::now();
+        AudioKernels::monoToInterleavedReference(scratch, samples, 2, vol);
+        referenceCycles += CycleCounter::now() - start;
+
+        seed();
+        start = CycleCounter::now();
+        AudioKernels::monoToStereoQ15(scratch, samples, volQ15);
+        kernelCycles += CycleCounter::now() - start;
+    }
+    referenceCycles /= ITERATIONS;
+    kernelCycles /= ITERATIONS;
+
+    printf("AudioController: Sample path benchmark (%zu samples/buffer, budget %u cycles)\n",
+           samples, getFillBudgetCycles());
+    printf("AudioController:   float reference : %u cycles/buffer\n", referenceCycles);
+    printf("AudioController:   Q15 %s kernel : %u cycles/buffer (%.1fx)\n",
+           AudioKernels::hasDspExtension() ? "DSP" : "C++", kernelCycles,
+           kernelCycles ? static_cast<float>(referenceCycles) / kernelCycles : 0.0f);
+
+    // Worst case for the synth: every voice busy, the filtered patches included
+    static SynthEngine bench;
+    bench.setSampleRate(config_.sampleRate);
+    const SynthPatch* patches[] = {&SynthPatches::ZAP, &SynthPatches::MOTOR_HUM, &SynthPatches::BEEP};
+    for (size_t i = 0; i < SynthEngine::MAX_VOICES; ++i) {
+        bench.noteOn(patches[i % 3], SynthEngine::UNITY_GAIN / 4);
+    }
+    uint32_t synthCycles = 0;
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        std::fill(scratch, scratch + samples, 0);
+        bench.render(scratch, samples);
+        synthCycles += bench.getStats().lastCycles;
+    }
+    bench.stopAll();
+    printf("AudioController:   synth, %zu voices : %u cycles/buffer\n",
+           SynthEngine::MAX_VOICES, synthCycles / ITERATIONS);
+
+    // Output chain stage by stage, on a loud signal so the dynamics work
+    static OutputChain chain;
+    configureOutputChain(chain, config_.sampleRate);
+    uint32_t stageCycles[OutputChain::STAGE_COUNT] = {};
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        seed();
+        chain.processProfiled(scratch, scratch, samples, stageCycles, &CycleCounter::now);
+    }
+    uint32_t chainCycles = 0;
+    for (size_t i = 0; i < OutputChain::STAGE_COUNT; ++i) {
+        printf("AudioController:   output %-12s : %u cycles/buffer\n",
+               OutputChain::stageName(i), stageCycles[i] / ITERATIONS);
+        chainCycles += stageCycles[i] / ITERATIONS;
+    }
+    printf("AudioController:   output chain total : %u cycles/buffer\n", chainCycles);
+
+    // Pitch bend worst cases: every voice converting at the highest step
+    // (a 2x bend), and the stretcher's costliest fill - the one that
+    // searches and crossfades a new sequence - at 2x tempo. The stretch
+    // source here is free, so the mixing it would pull is not included.
+    const uint32_t rate = actualI2SFormat_ ? actualI2SFormat_->sample_freq : config_.sampleRate;
+    static AudioMixer benchMixer;
+    benchMixer.setOutputRate(rate);
+    benchMixer.setSpeechPitch(2 * AudioMixer::PITCH_UNITY);
+    const size_t clipCount = Audio::getAudioFileCount();
+    for (size_t i = 0; i < AudioMixer::MAX_VOICES && clipCount > 0; ++i) {
+        benchMixer.startVoice(Audio::getAudioFile(static_cast<Audio::AudioIndex>(i % clipCount)),
+                              AudioMixer::UNITY_GAIN / 4, AudioMixer::VoicePriority::Speech);
+    }
+    uint32_t bentCycles = 0;
+    for (int iter = 0; iter < ITERATIONS; ++iter) {
+        const uint32_t start = CycleCounter::now();
+        benchMixer.mix(scratch, samples);
+        bentCycles += CycleCounter::now() - start;
+    }
+    benchMixer.stopAll();
+    printf("AudioController:   mixer, %zu voices bent 2x : %u cycles/buffer\n",
+           AudioMixer::MAX_VOICES, bentCycles / ITERATIONS);
+
+    static TimeStretch benchStretch;
+    benchStretch.configure(rate);
+    benchStretch.setTempo(TimeStretch::MAX_TEMPO);
+    auto noise = [](int16_t* out, size_t count, void*) -> size_t {
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = static_cast<int16_t>((i * 2654435761u) >> 16);
+        }
+        return count;
+    };
+    // Enough fills for a few sequences after the first, which has no search
+    const size_t fills = 4 * (benchStretch.getSequenceOutput() / samples + 1);
+    uint32_t stretchPeak = 0;
+    for (size_t fill = 0; fill < fills; ++fill) {
+        const uint32_t start = CycleCounter::now();
+        benchStretch.process(scratch, samples, noise, nullptr);
+        stretchPeak = std::max(stretchPeak, CycleCounter::now() - start);
+    }
+    benchStretch.reset();
+    const uint32_t budget256 = CycleCounter::budgetForSamples(256, rate);
+    printf("AudioController:   time stretch, worst fill : %u cycles (%u%% of this buffer, %u%% of 256 samples)\n",
+           stretchPeak, getFillBudgetCycles() ? stretchPeak * 100 / getFillBudgetCycles() : 0,
+           budget256 ? stretchPeak * 100 / budget256 : 0);
+
+    // Codec decode for one 5 ms timer tick of a clip. The shipped bank is
+    // PCM16, so synthetic ADPCM and mu-law clips stand in; the bytes are
+    // arbitrary but decode through the same paths as real ones.
+    static constexpr size_t BENCH_ADPCM_BLOCKS = 2;
+    static uint8_t adpcmBytes[BENCH_ADPCM_BLOCKS * Audio::ADPCM_BLOCK_BYTES];
+    static uint8_t muLawBytes[BENCH_ADPCM_BLOCKS * Audio::ADPCM_BLOCK_SAMPLES];
+    for (size_t i = 0; i < sizeof(adpcmBytes); ++i) {
+        adpcmBytes[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+    for (size_t block = 0; block < BENCH_ADPCM_BLOCKS; ++block) {
+        uint8_t* header = adpcmBytes + block * Audio::ADPCM_BLOCK_BYTES;
+        header[2] = 40;     // Valid step index (0-88)
+        header[3] = 0;
+    }
+    for (size_t i = 0; i < sizeof(muLawBytes); ++i) {
+        muLawBytes[i] = static_cast<uint8_t>((i * 2654435761u) >> 24);
+    }
+    const Audio::AudioFile benchClips[] = {
+        {"adpcm", nullptr, sizeof(muLawBytes), sizeof(adpcmBytes), Audio::AUDIO_SAMPLE_RATE,
+         1, 16, Audio::AudioCodec::IMA_ADPCM, adpcmBytes, nullptr, 0, 0},
+        {"mu-law", nullptr, sizeof(muLawBytes), sizeof(muLawBytes), Audio::AUDIO_SAMPLE_RATE,
+         1, 16, Audio::AudioCodec::MU_LAW, muLawBytes, nullptr, 0, 0},
+    };
+    const size_t tickSamples = std::min<size_t>(Audio::AUDIO_SAMPLE_RATE * 5 / 1000, BENCH_SAMPLES * 2);
+    const uint32_t tickBudget = CycleCounter::budgetForSamples(tickSamples, Audio::AUDIO_SAMPLE_RATE);
+    static ClipReader benchReader;
+    for (const Audio::AudioFile& clip : benchClips) {
+        uint32_t decodeCycles = 0;
+        for (int iter = 0; iter < ITERATIONS; ++iter) {
+            // Start mid-block so the tick crosses an ADPCM block boundary
+            benchReader.open(&clip);
+            benchReader.seek(Audio::ADPCM_BLOCK_SAMPLES - tickSamples / 2);
+            const uint32_t start = CycleCounter::now();
+            benchReader.read(scratch, tickSamples);
+            decodeCycles += CycleCounter::now() - start;
+        }
+        benchReader.close();
+        decodeCycles /= ITERATIONS;
+        printf("AudioController:   %s decode, 5 ms tick : %u cycles (%u%% of %u)\n",
+               clip.name, decodeCycles, tickBudget ? decodeCycles * 100 / tickBudget : 0, tickBudget);
+    }
+}
+
+void AudioController::configureOutputChain(OutputChain& chain, uint32_t sampleRate) {
+    chain.stage<0>().configure(OUTPUT_DC_CORNER_HZ, sampleRate);
+    chain.stage<1>().configure(SPEAKER_HIGH_PASS, sampleRate);
+    chain.stage<2>().configure(SPEAKER_PRESENCE, sampleRate);
+    chain.stage<3>().configure(SPEAKER_COMPRESSOR, sampleRate);
+    chain.stage<4>().configure(SPEAKER_LIMIT_KNEE, SPEAKER_LIMIT_CEILING);
+}
+
+bool AudioController::postCommand(const AudioCommand& command) {
+    if (!commands_.push(command)) {
+        ++droppedTriggers_;
+        return false;
+    }
+    return true;
+}
+
+void AudioController::processCommands() {
+    AudioCommand command;
+    SynthEngine::NoteId started = SynthEngine::NO_NOTE;
+    while (commands_.pop(command)) {
+        switch (command.type) {
+            case AudioCommand::Type::Play:
+                if (mixer_.startVoice(command.file, command.gain, command.priority,
+                                      command.skipSamples) < 0) {
+                    // Every voice holds a higher priority
+                    ++droppedTriggers_;
+                    clipCache_.release(command.file);
+                } else if (playbackState_ == PlaybackState::Stopped) {
+                    primed_ = false;
+                    playbackState_ = PlaybackState::Playing;
+                }
+                break;
+            case AudioCommand::Type::Queue:
+                if (mixer_.queueVoice(command.file, command.gain, command.priority) < 0) {
+                    ++droppedTriggers_;
+                    clipCache_.release(command.file);
+                } else if (playbackState_ == PlaybackState::Stopped) {
+                    primed_ = false;
+                    playbackState_ = PlaybackState::Playing;
+                }
+                break;
+            case AudioCommand::Type::Synth:
+                started = command.note;
+                if (synth_.noteOn(command.patch, command.gain, command.note) == SynthEngine::NO_NOTE) {
+                    ++droppedTriggers_;
+                } else if (playbackState_ == PlaybackState::Stopped) {
+                    primed_ = false;
+                    playbackState_ = PlaybackState::Playing;
+                }
+                break;
+            case AudioCommand::Type::SynthRelease:
+                synth_.release(command.note);
+                break;
+            case AudioCommand::Type::DalekStart: {
+                DalekVoice::Config dalekConfig = DalekVoice::Config::getDefault();
+                dalekConfig.sampleRate = actualI2SFormat_ ? actualI2SFormat_->sample_freq : config_.sampleRate;
+                dalek_.configure(dalekConfig);
+                mic_.skip(mic_.available());   // Start from the newest sample
+                dalekRunning_ = true;
+                if (playbackState_ == PlaybackState::Stopped) {
+                    primed_ = false;
+                    playbackState_ = PlaybackState::Playing;
+                }
+                break;
+            }
+            case AudioCommand::Type::DalekStop:
+                dalekRunning_ = false;
+                break;
+            case AudioCommand::Type::StopAll:
+                mixer_.stopAll();
+                synth_.stopAll();
+                stretch_.reset();
+                dalekRunning_ = false;
+                break;
+        }
+    }
+    activeVoices_ = mixer_.activeVoiceCount() + synth_.activeVoiceCount();
+    publishSynthNotes(started);
+}
+
+void AudioController::fillSilence(audio_buffer_t* buffer) {
+    // Use actual format to determine bytes per sample
+    size_t bytesPerSample = actualI2SFormat_->channel_count * 2; // 2 bytes per 16-bit sample per channel
+    memset(buffer->buffer->bytes, 0, buffer->max_sample_count * bytesPerSample);
+    buffer->sample_count = buffer->max_sample_count;
+    buffer->user_data = packIntensityStamp(0, time_us_32());
+}
+
 size_t AudioController::fillAudioBuffer(audio_buffer_t* buffer) {
-    if (!buffer || playbackState_ != PlaybackState::Playing || !currentAudioData_ || !actualI2SFormat_) {
-        // Fill with silence - use actual format to determine bytes per sample
-        size_t bytesPerSample = actualI2SFormat_->channel_count * 2; // 2 bytes per 16-bit sample per channel
-        memset(buffer->buffer->bytes, 0, buffer->max_sample_count * bytesPerSample);
-        buffer->sample_count = buffer->max_sample_count;
+    // Apply triggers posted since the last fill before mixing
+    processCommands();
+
+    if (!buffer || !actualI2SFormat_) {
+        return 0;
+    }
+
+    if (playbackState_ != PlaybackState::Playing) {
+        fillSilence(buffer);
         return 0;
     }
 
-    size_t samplesRemaining = currentAudioSize_.load() - currentAudioPosition_.load();
-    size_t monoSamplesToRead = std::min(samplesRemaining, static_cast<size_t>(buffer->max_sample_count));
+    const uint32_t fillStart = CycleCounter::now();
+
+    // Mix every active voice into the front of the buffer as mono
+    int16_t* bufferSamples = (int16_t*)buffer->buffer->bytes;
+    size_t monoSamplesMixed = mixSpeech(bufferSamples, buffer->max_sample_count);
     
-    if (monoSamplesToRead == 0) {
-        // End of audio reached
+    // Synthesised effects go onto the same mono bus
+    const uint32_t synthPitch = synthPitch_.load();
+    synth_.setPitchScale(static_cast<SynthEngine::NoteId>(synthPitch >> 16), static_cast<uint16_t>(synthPitch));
+    monoSamplesMixed = std::max(monoSamplesMixed, synth_.render(bufferSamples, buffer->max_sample_count));
+    publishSynthNotes(SynthEngine::NO_NOTE);
+    
+    // The live mic keeps the stream going until stopDalekVoice()
+    if (dalekRunning_) {
+        renderDalekVoice(bufferSamples, buffer->max_sample_count);
+        monoSamplesMixed = buffer->max_sample_count;
+    }
+    activeVoices_ = mixer_.activeVoiceCount() + synth_.activeVoiceCount();
+    
+    if (monoSamplesMixed == 0) {
+        // End of audio reached on every voice
         playbackState_ = PlaybackState::Stopped;
-        size_t bytesPerSample = actualI2SFormat_->channel_count * 2;
-        memset(buffer->buffer->bytes, 0, buffer->max_sample_count * bytesPerSample);
-        buffer->sample_count = buffer->max_sample_count;
-        printf("AudioController: End of audio reached\n");
+        fillSilence(buffer);
+        // Runs in the refill IRQ or on core1: counted, not printed
+        ++playbackEnds_;
         return 0;
     }
 
-    // Convert mono to the actual I2S format
-    int16_t* bufferSamples = (int16_t*)buffer->buffer->bytes;
-    const int16_t* audioSamples = currentAudioData_ + currentAudioPosition_.load();
-    float vol = volume_.load();
-    
-    for (size_t i = 0; i < monoSamplesToRead; ++i) {
-        // Apply volume and clamp to prevent overflow
-        float sample = static_cast<float>(audioSamples[i]) * vol;
-        sample = std::max(-32768.0f, std::min(32767.0f, sample));
-        int16_t outputSample = static_cast<int16_t>(sample);
-        
-        // Duplicate mono sample to all channels based on actual format
-        for (uint16_t ch = 0; ch < actualI2SFormat_->channel_count; ++ch) {
-            bufferSamples[i * actualI2SFormat_->channel_count + ch] = outputSample;
+    // Speaker EQ and dynamics see the full-scale mix; volume only attenuates after
+    if (config_.outputDsp) {
+        outputChain_.process(bufferSamples, bufferSamples, buffer->max_sample_count);
+    }
+
+    // Expand mono to the actual I2S format in place with master volume
+    if (actualI2SFormat_->channel_count == 2) {
+        AudioKernels::monoToStereoQ15(bufferSamples, buffer->max_sample_count, volumeQ15_.load());
+    } else {
+        AudioKernels::monoToInterleavedReference(bufferSamples, buffer->max_sample_count,
+                                                 actualI2SFormat_->channel_count, volume_.load());
+    }
+    
+    buffer->sample_count = buffer->max_sample_count;
+    
+    // LED intensity comes from the clips' precomputed envelopes; it is
+    // carried with the buffer and published when I2S starts playing it
+    buffer->user_data = packIntensityStamp(mixer_.envelopeLevel(), time_us_32());
+
+    // Track fill cost against the per-buffer deadline
+    uint32_t fillCycles = CycleCounter::now() - fillStart;
+    lastFillCycles_ = fillCycles;
+    if (fillCycles > peakFillCycles_.load()) {
+        peakFillCycles_ = fillCycles;
+    }
+    if (fillCycles < minFillCycles_.load()) {
+        minFillCycles_ = fillCycles;
+    }
+    if (fillCycles > fillBudgetCycles_) {
+        ++overruns_;
+    }
+    windowFillCycles_ += fillCycles;
+    ++windowFills_;
+    
+    return monoSamplesMixed;
+}
+
+size_t AudioController::mixSpeech(int16_t* out, size_t count) {
+    // The pitch reaches playing voices at their next mix chunk
+    const uint16_t pitch = speechPitchQ12_.load();
+    mixer_.setSpeechPitch(pitch);
+
+    // Once engaged the stretcher holds buffered audio, so it stays in the
+    // path after the pitch returns to unity until the bus goes quiet
+    const bool stretch = config_.preserveTempo &&
+                         (pitch != AudioMixer::PITCH_UNITY || stretch_.isActive());
+    if (!stretch) {
+        stretching_ = false;
+        return mixer_.mix(out, count);
+    }
+
+    const uint32_t start = CycleCounter::now();
+    stretching_ = true;
+    stretch_.setTempo(static_cast<uint32_t>(
+        (static_cast<uint64_t>(TimeStretch::TEMPO_UNITY) * AudioMixer::PITCH_UNITY) / pitch));
+    const size_t mixed = stretch_.process(out, count, &AudioController::mixerSource, this);
+    stretching_ = stretch_.isActive();
+
+    const uint32_t cycles = CycleCounter::now() - start;
+    lastStretchCycles_ = cycles;
+    if (cycles > peakStretchCycles_.load()) {
+        peakStretchCycles_ = cycles;
+    }
+    return mixed;
+}
+
+size_t AudioController::mixerSource(int16_t* out, size_t count, void* context) {
+    return static_cast<AudioController*>(context)->mixer_.mix(out, count);
+}
+
+void AudioController::renderDalekVoice(int16_t* out, size_t count) {
+    const uint32_t start = CycleCounter::now();
+    const uint32_t sampleRate = actualI2SFormat_->sample_freq;
+
+    // Fills follow buffer releases, so about one buffer of mic samples is
+    // waiting; anything beyond two is backlog that would only add delay
+    size_t backlog = mic_.available();
+    if (backlog > 2 * count) {
+        const size_t drop = backlog - count;
+        mic_.skip(drop);
+        micDroppedSamples_ += static_cast<uint32_t>(drop);
+        backlog = count;
+    }
+
+    // The oldest sample read now reaches the DAC after the fill-to-playout delay
+    const uint32_t latencyUs = static_cast<uint32_t>((static_cast<uint64_t>(backlog) * 1000000) / sampleRate)
+                             + lastFillLeadUs_.load();
+    lastMicLatencyUs_ = latencyUs;
+    if (latencyUs > peakMicLatencyUs_.load()) {
+        peakMicLatencyUs_ = latencyUs;
+    }
+
+    // Capture behind: the missing samples are silence at the start
+    size_t offset = 0;
+    if (backlog < count) {
+        offset = count - backlog;
+        ++micUnderruns_;
+    }
+
+    int16_t chunk[MIC_CHUNK];
+    while (offset < count) {
+        const size_t samples = mic_.read(chunk, std::min(MIC_CHUNK, count - offset));
+        if (samples == 0) {
+            break;
+        }
+        dalek_.process(chunk, chunk, samples);
+        for (size_t i = 0; i < samples; ++i) {
+            const int32_t mixed = static_cast<int32_t>(out[offset + i]) + chunk[i];
+            out[offset + i] = static_cast<int16_t>(std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, mixed)));
         }
+        offset += samples;
     }
+
+    const uint16_t minGain = dalek_.takeMinLimiterGain();
+    if (minGain < dalekMinGain_.load()) {
+        dalekMinGain_ = minGain;
+    }
+    const uint32_t cycles = CycleCounter::now() - start;
+    lastDalekCycles_ = cycles;
+    if (cycles > peakDalekCycles_.load()) {
+        peakDalekCycles_ = cycles;
+    }
+}
+
+void AudioController::prerenderHotStartClips() {
+    const size_t samples = config_.samplesPerBuffer;
+    const size_t clipCount = Audio::getAudioFileCount();
     
-    // Fill remaining buffer with silence if needed
-    if (monoSamplesToRead < buffer->max_sample_count) {
-        size_t remainingSamples = buffer->max_sample_count - monoSamplesToRead;
-        size_t bytesToClear = remainingSamples * actualI2SFormat_->channel_count * 2;
-        memset(&bufferSamples[monoSamplesToRead * actualI2SFormat_->channel_count], 0, bytesToClear);
+    hotStartClips_.reset(new (std::nothrow) int16_t[clipCount * samples]);
+    if (!hotStartClips_) {
+        printf("AudioController: Not enough RAM for hot start buffers\n");
+        return;
     }
     
-    buffer->sample_count = buffer->max_sample_count;
+    // Render at unity gain through the mixer so resampled and compressed
+    // clips continue seamlessly when the voice starts at the same offset
+    for (size_t i = 0; i < clipCount; ++i) {
+        int16_t* out = &hotStartClips_[i * samples];
+        const Audio::AudioFile* file = Audio::getAudioFile(static_cast<Audio::AudioIndex>(i));
+        if (mixer_.startVoice(file, AudioMixer::UNITY_GAIN, AudioMixer::VoicePriority::Speech) < 0) {
+            memset(out, 0, samples * sizeof(int16_t));
+            continue;
+        }
+        mixer_.mix(out, samples);
+        mixer_.stopAll();
+    }
+    hotStartClipCount_ = clipCount;
+    
+    printf("AudioController: Hot start ready - %zu clips, %zu bytes\n",
+           clipCount, clipCount * samples * sizeof(int16_t));
+}
+
+bool AudioController::tryHotStart(Audio::AudioIndex audioIndex, const Audio::AudioFile* file,
+                                  uint16_t gainQ15, AudioMixer::VoicePriority priority) {
+    const size_t clip = static_cast<size_t>(audioIndex);
+    const size_t samples = config_.samplesPerBuffer;
+    if (!hotStartClips_ || clip >= hotStartClipCount_ || directActive_ || !actualI2SFormat_) {
+        return false;
+    }
+    
+    // The I2S DMA IRQ takes buffers off the prepared list under this lock,
+    // and taking it also keeps the refill IRQ (same core) out while the
+    // queued buffer is rewritten and the continuation is posted
+    spin_lock_t* preparedLock = bufferPool_->prepared_list_spin_lock;
+    uint32_t interrupts = spin_lock_blocking(preparedLock);
     
-    // Update position (in mono samples)
-    currentAudioPosition_ = currentAudioPosition_.load() + monoSamplesToRead;
+    // Clips were pre-rendered unbent, and the stretcher may still hold a tail
+    audio_buffer_t* target = hotBuffer_;
+    bool idle = activeVoices_ == 0 && commands_.empty() && !stretching_ &&
+                speechPitchQ12_ == AudioMixer::PITCH_UNITY;
+    if (!target || !idle || target->max_sample_count != samples) {
+        spin_unlock(preparedLock, interrupts);
+        return false;
+    }
+    hotBuffer_ = nullptr;
+    
+    // Only a buffer still waiting on the prepared list can take the clip.
+    // Once I2S has it, it is playing or has played as silence, and may be
+    // back with the producer; the caller then posts a Play from sample 0.
+    bool queued = false;
+    for (audio_buffer_t* buffer = bufferPool_->prepared_list; buffer; buffer = buffer->next) {
+        if (buffer == target) {
+            queued = true;
+            break;
+        }
+    }
+    if (!queued) {
+        spin_unlock(preparedLock, interrupts);
+        return false;
+    }
     
-    // Calculate audio intensity for LED effects (use first channel)
-    updateAudioIntensity(bufferSamples, monoSamplesToRead);
+    // The producer continues the clip after the samples sent here
+    AudioCommand command{AudioCommand::Type::Play, file, gainQ15, priority, static_cast<uint32_t>(samples), nullptr};
+    postCommand(command);
     
-    return monoSamplesToRead;
+    // Same gain, output chain and volume arithmetic as the mixer path, so
+    // the seam is exact; the producer is held off, so the chain is ours
+    const int16_t* source = &hotStartClips_[clip * samples];
+    int16_t* bufferSamples = (int16_t*)target->buffer->bytes;
+    for (size_t i = 0; i < samples; ++i) {
+        bufferSamples[i] = static_cast<int16_t>((static_cast<int32_t>(source[i]) * gainQ15) >> 15);
+    }
+    if (config_.outputDsp) {
+        outputChain_.process(bufferSamples, bufferSamples, samples);
+    }
+    if (actualI2SFormat_->channel_count == 2) {
+        AudioKernels::monoToStereoQ15(bufferSamples, samples, volumeQ15_.load());
+    } else {
+        AudioKernels::monoToInterleavedReference(bufferSamples, samples,
+                                                 actualI2SFormat_->channel_count, volume_.load());
+    }
+    target->sample_count = samples;
+    
+    uint32_t level = (static_cast<uint32_t>(AudioMixer::envelopeAt(file, 0)) * gainQ15) >> 15;
+    target->user_data = packIntensityStamp(static_cast<uint8_t>(std::min<uint32_t>(level, 255)), time_us_32());
+    
+    primed_ = true;
+    playbackState_ = PlaybackState::Playing;
+    ++hotStarts_;
+    
+    spin_unlock(preparedLock, interrupts);
+    return true;
+}
+
+void AudioController::measureTriggerLatency(const audio_buffer_t* buffer) {
+    if (!triggerPending_ || !actualI2SFormat_) {
+        return;
+    }
+    
+    // First non-zero sample in this buffer, converted to its playout time
+    const uint channels = actualI2SFormat_->channel_count;
+    const int16_t* samples = (const int16_t*)buffer->buffer->bytes;
+    const size_t total = buffer->sample_count * channels;
+    for (size_t i = 0; i < total; ++i) {
+        if (samples[i] != 0) {
+            uint32_t offsetUs = static_cast<uint32_t>((i / channels) * 1000000ull / actualI2SFormat_->sample_freq);
+            uint32_t latencyUs = time_us_32() + offsetUs - triggerUs_.load();
+            lastTriggerLatencyUs_ = latencyUs;
+            if (latencyUs > peakTriggerLatencyUs_.load()) {
+                peakTriggerLatencyUs_ = latencyUs;
+            }
+            if (wakePending_.exchange(false)) {
+                lastWakeLatencyUs_ = latencyUs;
+                if (latencyUs > peakWakeLatencyUs_.load()) {
+                    peakWakeLatencyUs_ = latencyUs;
+                }
+            }
+            ++latencySamples_;
+            triggerPending_ = false;
+            return;
+        }
+    }
+}
+
+AudioController::TriggerLatency AudioController::getTriggerLatency() const {
+    return TriggerLatency{
+        lastTriggerLatencyUs_.load(),
+        peakTriggerLatencyUs_.load(),
+        hotStarts_.load(),
+        latencySamples_.load()
+    };
+}
+
+AudioController::AudioStats AudioController::getStats() const {
+    AudioStats stats{};
+    stats.underruns = underruns_.load();
+    stats.overruns = overruns_.load();
+    stats.droppedTriggers = droppedTriggers_.load();
+    stats.decodeErrors = ClipReader::decodeErrorCount();
+    stats.buffersProduced = buffersProduced_.load();
+    stats.buffersPerSecond = buffersPerSecond_.load();
+    stats.playbackEnds = playbackEnds_.load();
+    stats.fillBudgetCycles = fillBudgetCycles_;
+    const uint32_t minFill = minFillCycles_.load();
+    stats.minFillCycles = minFill == UINT32_MAX ? 0 : minFill;
+    stats.avgFillCycles = avgFillCycles_.load();
+    stats.maxFillCycles = peakFillCycles_.load();
+    for (size_t i = 0; i < QUEUE_DEPTH_BINS; ++i) {
+        stats.queueDepth[i] = queueDepth_[i].load();
+    }
+    stats.bufferDepth = producerPool_.getDepth();
+    stats.peakBufferDepth = peakBufferDepth_.load();
+    stats.queueLatencyUs = getQueueLatencyUs();
+    stats.depthGrows = depthGrows_.load();
+    stats.depthShrinks = depthShrinks_.load();
+    stats.triggerLatency = getTriggerLatency();
+    return stats;
+}
+
+void AudioController::resetStats() {
+    underruns_ = 0;
+    overruns_ = 0;
+    droppedTriggers_ = 0;
+    buffersProduced_ = 0;
+    playbackEnds_ = 0;
+    minFillCycles_ = UINT32_MAX;
+    peakFillCycles_ = 0;
+    for (std::atomic<uint32_t>& bin : queueDepth_) {
+        bin = 0;
+    }
+    peakBufferDepth_ = producerPool_.getDepth();
+    depthGrows_ = 0;
+    depthShrinks_ = 0;
+    lastTriggerLatencyUs_ = 0;
+    peakTriggerLatencyUs_ = 0;
+    hotStarts_ = 0;
+    latencySamples_ = 0;
+}
+
+void AudioController::dumpStats() {
+    const AudioStats stats = getStats();
+    printf("AudioController: Stats - %u buffers of %u samples at %u Hz\n",
+           stats.bufferDepth, config_.samplesPerBuffer,
+           actualI2SFormat_ ? actualI2SFormat_->sample_freq : config_.sampleRate);
+    printf("AudioController:   depth        : %u now (%u us), peak %u of %u, %u grows, %u shrinks\n",
+           stats.bufferDepth, stats.queueLatencyUs, stats.peakBufferDepth,
+           std::max(config_.bufferCount, config_.maxBufferCount), stats.depthGrows, stats.depthShrinks);
+    printf("AudioController:   buffers      : %u produced, %u/s, %u playback ends\n",
+           stats.buffersProduced, stats.buffersPerSecond, stats.playbackEnds);
+    printf("AudioController:   underruns    : %u, overruns %u, dropped triggers %u, decode errors %u\n",
+           stats.underruns, stats.overruns, stats.droppedTriggers, stats.decodeErrors);
+    printf("AudioController:   fill cycles  : min %u, avg %u, max %u of %u budget (%u%% peak)\n",
+           stats.minFillCycles, stats.avgFillCycles, stats.maxFillCycles, stats.fillBudgetCycles,
+           stats.fillBudgetCycles ? stats.maxFillCycles * 100 / stats.fillBudgetCycles : 0);
+    printf("AudioController:   queue depth  :");
+    for (size_t i = 0; i < QUEUE_DEPTH_BINS; ++i) {
+        printf(" %zu%s=%u", i, i + 1 == QUEUE_DEPTH_BINS ? "+" : "", stats.queueDepth[i]);
+    }
+    printf("\n");
+    printf("AudioController:   trigger      : last %u us, peak %u us, %u measured, %u hot starts\n",
+           stats.triggerLatency.lastUs, stats.triggerLatency.peakUs,
+           stats.triggerLatency.measured, stats.triggerLatency.hotStarts);
+    const StandbyStats standby = getStandbyStats();
+    printf("AudioController:   standby      : %s, %u entries, %u wakes, wake latency last %u us, peak %u us\n",
+           standby.standby ? "now" : "awake", standby.entries, standby.wakes,
+           standby.lastWakeLatencyUs, standby.peakWakeLatencyUs);
+    const IntensitySkew skew = getIntensitySkew();
+    printf("AudioController:   led skew     : fill lead last %u us, peak %u us, intensity %u us old\n",
+           skew.lastFillLeadUs, skew.peakFillLeadUs, skew.currentAgeUs);
+    if (config_.clipCache) {
+        const ClipCache::Stats cache = getClipCacheStats();
+        printf("AudioController:   clip cache   : %u hits, %u misses, %u fills, %u evictions, %zu clips in %zu of %zu KB\n",
+               cache.hits, cache.misses, cache.fills, cache.evictions, cache.clips,
+               cache.bytesUsed / 1024, cache.capacity / 1024);
+    }
+    if (config_.prefetch) {
+        const ClipPrefetcher::Stats prefetch = getPrefetchStats();
+        printf("AudioController:   prefetch     : %u hits, %u misses, %u stalls (%u cycles), %u transfers, XIP %u/%u hits\n",
+               prefetch.hits, prefetch.misses, prefetch.stalls, prefetch.stallCycles, prefetch.transfers,
+               prefetch.xipHits, prefetch.xipAccesses);
+    }
+    const SynthEngine::Stats synth = getSynthStats();
+    printf("AudioController:   synth        : %u notes, %u steals, render last %u cycles, peak %u\n",
+           synth.notes, synth.steals, synth.lastCycles, synth.peakCycles);
+    const DalekVoiceStats dalek = getDalekVoiceStats();
+    printf("AudioController:   dalek voice  : latency last %u us, peak %u us, %u dropped, %u underruns, %u overruns\n",
+           dalek.lastLatencyUs, dalek.peakLatencyUs, dalek.droppedSamples, dalek.underruns, dalek.overruns);
+    printf("AudioController:   dalek cost   : last %u cycles, peak %u, limiter gain down to %u%%\n",
+           dalek.lastCycles, dalek.peakCycles, dalek.minLimiterGain * 100u / DalekVoice::UNITY_GAIN);
+    const PitchBendStats bend = getPitchBendStats();
+    printf("AudioController:   pitch bend   : %s, %u sequences, stretch last %u cycles, peak %u\n",
+           bend.stretching ? "stretching" : "no stretch", bend.sequences, bend.lastCycles, bend.peakCycles);
+}
+
+AudioController::StandbyStats AudioController::getStandbyStats() const {
+    return StandbyStats{
+        standby_.load(),
+        standbyEntries_.load(),
+        wakes_.load(),
+        lastWakeLatencyUs_.load(),
+        peakWakeLatencyUs_.load()
+    };
+}
+
+bool AudioController::isIdle() const {
+    return playbackState_ == PlaybackState::Stopped && activeVoices_ == 0 && commands_.empty() &&
+           !directActive_ && !dalekActive_ && !stretching_;
+}
+
+void AudioController::startStandbyTimer() {
+    if (config_.standbyMs == 0 || standbyTimerActive_) {
+        return;
+    }
+    standbyTimerActive_ = add_repeating_timer_ms(STANDBY_POLL_MS, &AudioController::standbyTimerCallback,
+                                                 this, &standbyTimer_);
+    if (!standbyTimerActive_) {
+        printf("AudioController: No alarm slots available - standby disabled\n");
+    }
+}
+
+bool AudioController::standbyTimerCallback(repeating_timer_t* timer) {
+    AudioController* controller = static_cast<AudioController*>(timer->user_data);
+    const uint32_t now = time_us_32();
+    if (!controller->isIdle()) {
+        controller->lastActiveUs_ = now;
+        return true;
+    }
+    if (now - controller->lastActiveUs_.load() < controller->config_.standbyMs * 1000u) {
+        return true;
+    }
+    controller->enterStandby();
+    controller->standbyTimerActive_ = false;
+    return false;
+}
+
+void AudioController::enterStandby() {
+    if (standby_ || !initialized_) {
+        return;
+    }
+
+    // Keep-alive silence stops with standby_ set; the queued silent buffer
+    // stays queued, to be played first after a wake, so no hot start may
+    // swap audio into it
+    standby_ = true;
+    hotBuffer_ = nullptr;
+
+    // Stop the PIO clocks and the DMA chain the way direct playback does
+    audio_i2s_set_enabled(false);
+    dma_channel_abort(i2sConfig_.dma_channel);
+    dma_irqn_acknowledge_channel(I2S_DMA_IRQ_INDEX, i2sConfig_.dma_channel);
+    if (config_.ampShutdownPin != NO_PIN) {
+        gpio_put(config_.ampShutdownPin, false);
+    }
+
+    // Runs in the standby timer's IRQ: counted for dumpStats(), not printed
+    ++standbyEntries_;
+}
+
+bool AudioController::wakeFromStandby() {
+    lastActiveUs_ = time_us_32();
+    if (!standby_) {
+        return false;
+    }
+
+    // Serialised with the standby timer, which runs on core0 too
+    uint32_t interrupts = save_and_disable_interrupts();
+    if (!standby_) {
+        restore_interrupts(interrupts);
+        return false;
+    }
+    if (config_.ampShutdownPin != NO_PIN) {
+        gpio_put(config_.ampShutdownPin, true);
+
+        // Buffers shorter than the start-up would clip the first trigger;
+        // the producer queues the rest as silence rather than this caller
+        // (often the BTstack callback) spinning it out
+        const uint32_t startupSamples = static_cast<uint32_t>(
+            (static_cast<uint64_t>(AMP_STARTUP_US) * actualI2SFormat_->sample_freq + 999999) / 1000000);
+        ampWarmupSamples_ = startupSamples > config_.samplesPerBuffer ? startupSamples - config_.samplesPerBuffer : 0;
+    }
+    // I2S restarts on silence: the keep-alive buffer still queued, or
+    // pico-extras' own silence buffer. Audio from this trigger follows it
+    // and any warm-up silence, which covers the amplifier's start-up.
+    audio_i2s_set_enabled(true);
+    standby_ = false;
+    ++wakes_;
+    restore_interrupts(interrupts);
+
+    startStandbyTimer();
+    if (keepAlive()) {
+        requestRefill();
+    }
+    return true;
 }
 
-void AudioController::updateAudioIntensity(const int16_t* samples, size_t monoSampleCount) {
-    if (!samples || monoSampleCount == 0 || !actualI2SFormat_) {
-        audioIntensity_ = 0.0f;
+void AudioController::updateStatsWindow() {
+    ++windowBuffers_;
+    const uint32_t now = time_us_32();
+    const uint32_t elapsed = now - statsWindowStartUs_;
+    if (elapsed < STATS_WINDOW_US) {
+        return;
+    }
+    // The first window after a pause covers idle time; it only under-reads once
+    buffersPerSecond_ = static_cast<uint32_t>((static_cast<uint64_t>(windowBuffers_) * 1000000u) / elapsed);
+    avgFillCycles_ = windowFills_ ? static_cast<uint32_t>(windowFillCycles_ / windowFills_) : 0;
+    statsWindowStartUs_ = now;
+    windowBuffers_ = 0;
+    windowFills_ = 0;
+    windowFillCycles_ = 0;
+}
+
+void AudioController::adaptBufferDepth() {
+    if (config_.maxBufferCount <= config_.bufferCount) {
         return;
     }
     
-    // Calculate RMS (Root Mean Square) for audio intensity
-    // Since we duplicated mono samples to all channels, analyze first channel only
-    float sum = 0.0f;
-    for (size_t i = 0; i < monoSampleCount; ++i) {
-        float sample = static_cast<float>(samples[i * actualI2SFormat_->channel_count]) / 32768.0f;  // First channel, normalize to [-1, 1]
-        sum += sample * sample;
+    // Pressure: I2S ran dry, or the latest fill used most of the time its
+    // buffer plays for (interrupt storms and heavy mixes show up here first)
+    const uint32_t underruns = underruns_.load();
+    const uint32_t fills = buffersProduced_.load();
+    const bool underran = underruns > adaptUnderruns_;
+    const bool tight = fills != adaptFills_ &&
+                       lastFillCycles_.load() > fillBudgetCycles_ / 100 * ADAPT_HEADROOM_PERCENT;
+    adaptUnderruns_ = underruns;
+    adaptFills_ = fills;
+    
+    const uint32_t now = time_us_32();
+    const uint depth = producerPool_.getDepth();
+    if (underran || tight) {
+        adaptPressureUs_ = now;
+        if (depth < config_.maxBufferCount) {
+            producerPool_.setDepth(depth + 1);
+            ++depthGrows_;
+            if (depth + 1 > peakBufferDepth_.load()) {
+                peakBufferDepth_ = depth + 1;
+            }
+        }
+        return;
     }
     
-    float rms = sqrtf(sum / static_cast<float>(monoSampleCount));
+    // Give latency back one buffer per calm spell
+    if (depth > config_.bufferCount && now - adaptPressureUs_ >= ADAPT_SHRINK_US) {
+        adaptPressureUs_ = now;
+        producerPool_.setDepth(depth - 1);
+        ++depthShrinks_;
+    }
+}
+
+void AudioController::publishPlayoutIntensity(uint32_t stamp) {
+    const uint32_t now = time_us_32();
+    const uint32_t leadUs = (now - (stamp >> STAMP_LEVEL_BITS)) & STAMP_TIME_MASK;
     
-    // Apply some smoothing and scaling for LED effects
-    float intensity = std::min(1.0f, rms * 3.0f);  // Scale up for better LED response
+    playoutStartUs_ = now;
+    lastFillLeadUs_ = leadUs;
+    if (leadUs > peakFillLeadUs_.load()) {
+        peakFillLeadUs_ = leadUs;
+    }
+    updateAudioIntensity(static_cast<uint8_t>(stamp));
+}
+
+AudioController::IntensitySkew AudioController::getIntensitySkew() const {
+    return IntensitySkew{
+        lastFillLeadUs_.load(),
+        peakFillLeadUs_.load(),
+        time_us_32() - playoutStartUs_.load()
+    };
+}
+
+void AudioController::updateAudioIntensity(uint8_t envelopeLevel) {
+    // The envelope already holds RMS * 3 per block (see the converter);
+    // apply master volume so the LEDs follow what is actually heard
+    uint32_t scaled = (static_cast<uint32_t>(envelopeLevel) * volumeQ15_.load()) >> 15;
+    float intensity = static_cast<float>(scaled) * (1.0f / 255.0f);
     
     // Simple low-pass filter for smoother LED transitions
     float current = audioIntensity_.load();
@@ -361,7 +1755,7 @@ void AudioController::audioCallback(void* userData) {
     }
     
     // Get a buffer to fill
-    audio_buffer_t* buffer = take_audio_buffer(controller->bufferPool_, false);
+    audio_buffer_t* buffer = controller->producerPool_.take();
     if (buffer) {
         // Fill the buffer with audio data
         controller->fillAudioBuffer(buffer);
@@ -371,13 +1765,61 @@ void AudioController::audioCallback(void* userData) {
     }
 }
 
+bool AudioController::produceBuffers(uint maxBuffers) {
+    // Direct playback owns the PIO FIFO; the pool stays untouched
+    if (directActive_) {
+        serviceDirectPlayback();
+        return true;
+    }
+    
+    adaptBufferDepth();
+    
+    // Try to fill available buffers (non-blocking)
+    for (uint i = 0; i < maxBuffers; ++i) {
+        audio_buffer_t* buffer = producerPool_.take();
+        if (!buffer) {
+            break; // No more buffers available right now
+        }
+        
+        // Still inside the amplifier's start-up after a wake: silence goes
+        // first, and the trigger waits in the ring for the next buffer
+        const uint32_t warmup = ampWarmupSamples_.load();
+        size_t samplesWritten = 0;
+        if (warmup > 0) {
+            fillSilence(buffer);
+            ampWarmupSamples_ = warmup - std::min<uint32_t>(warmup, buffer->sample_count);
+        } else {
+            samplesWritten = fillAudioBuffer(buffer);
+        }
+        
+        // Send filled buffer (or the closing silence) to I2S output
+        give_audio_buffer(bufferPool_, buffer);
+        queuedSamples_ += buffer->sample_count;
+        ++buffersProduced_;
+        updateStatsWindow();
+        
+        // A queued silent buffer is where the next hot start lands
+        hotBuffer_ = (samplesWritten == 0 && warmup == 0 && keepAlive()) ? buffer : nullptr;
+        
+        if (warmup > 0) {
+            continue;
+        }
+        if (samplesWritten == 0) {
+            // No more audio data, end of playback
+            return false;
+        }
+        primed_ = true;
+    }
+    return true;
+}
+
 void AudioController::startTimerBasedAudioStreaming() {
     if (!initialized_ || !bufferPool_) {
         printf("AudioController: Cannot start streaming - not initialized\n");
         return;
     }
     
-    if (!currentAudioData_ || currentAudioSize_ == 0) {
+    if (activeVoices_ == 0 && commands_.empty() && !directActive_ && !dalekActive_) {
         printf("AudioController: Cannot start streaming - no audio data loaded\n");
         return;
     }
@@ -385,42 +1827,201 @@ void AudioController::startTimerBasedAudioStreaming() {
     // Set playback state
     playbackState_ = PlaybackState::Playing;
     
+    // A single timer services every voice
+    if (streamingActive_.exchange(true)) {
+        return;
+    }
+    
     printf("AudioController: Starting timer-based audio streaming...\n");
     
     // Start a timer that fills audio buffers every 5ms
-    // This approaches provides regular buffer filling without multicore conflicts
-    add_repeating_timer_ms(5, [](repeating_timer_t* rt) -> bool {
+    // This approaches provides regular buffer filling without multicore conflicts.
+    // With release-driven refill the timer only catches a missed wakeup.
+    int32_t pollMs = (refillIrq_ >= 0) ? FALLBACK_POLL_MS : STREAM_POLL_MS;
+    bool timerStarted = add_repeating_timer_ms(pollMs, [](repeating_timer_t* rt) -> bool {
+        (void)rt;
         AudioController* controller = AudioController::instance_;
         if (!controller || controller->playbackState_ != PlaybackState::Playing) {
+            if (controller) {
+                controller->streamingActive_ = false;
+            }
             printf("AudioController: Timer-based streaming stopped\n");
             return false; // Stop the timer
         }
         
-        // Try to fill available buffers (non-blocking)
-        for (int i = 0; i < 2; ++i) { // Fill up to 2 buffers per timer tick
-            audio_buffer_t* buffer = take_audio_buffer(controller->bufferPool_, false);
-            if (buffer) {
-                size_t samplesWritten = controller->fillAudioBuffer(buffer);
-                
-                if (samplesWritten > 0) {
-                    // Send filled buffer to I2S output
-                    give_audio_buffer(controller->bufferPool_, buffer);
-                } else {
-                    // No more audio data, end of playback
-                    give_audio_buffer(controller->bufferPool_, buffer);
-                    controller->playbackState_ = PlaybackState::Stopped;
-                    printf("AudioController: Audio playback completed\n");
-                    return false; // Stop the timer
-                }
-            } else {
-                break; // No more buffers available right now
-            }
+        // Top the queue up to its current depth every tick
+        if (!controller->produceBuffers(controller->producerPool_.getDepth())) {
+            controller->playbackState_ = PlaybackState::Stopped;
+            controller->streamingActive_ = false;
+            printf("AudioController: Audio playback completed\n");
+            return false; // Stop the timer
         }
         
         return true; // Keep timer running
     }, nullptr, &audioStreamingTimer_);
     
+    if (!timerStarted) {
+        streamingActive_ = false;
+        printf("AudioController: ERROR - No alarm slots available for streaming timer\n");
+        return;
+    }
+    
     printf("AudioController: Timer-based streaming started\n");
 }
 
+void AudioController::startCore1Engine() {
+    if (core1Running_) {
+        return;
+    }
+    
+    printf("AudioController: Starting core1 audio engine\n");
+    core1Exited_ = false;
+    core1Running_ = true;
+    multicore_launch_core1(&AudioController::core1Entry);
+}
+
+void AudioController::stopCore1Engine() {
+    if (!core1Running_) {
+        return;
+    }
+    
+    core1Running_ = false;
+    while (!core1Exited_) {
+        tight_loop_contents();
+    }
+    multicore_reset_core1();
+    printf("AudioController: Core1 audio engine stopped\n");
+}
+
+void AudioController::core1Entry() {
+    AudioController* controller = AudioController::instance_;
+    if (controller) {
+        controller->core1Loop();
+    }
+}
+
+void AudioController::core1Loop() {
+    // Let core0 pause us while BTstack writes pairing keys to flash
+    multicore_lockout_victim_init();
+    
+    while (core1Running_) {
+        if (playbackState_ == PlaybackState::Playing || !commands_.empty()) {
+            // fillAudioBuffer() marks the end of playback
+            produceBuffers(producerPool_.getDepth());
+        }
+        if (standby_) {
+            // Nothing can need a buffer until a trigger wakes the pipeline (SEV)
+            __wfe();
+            continue;
+        }
+        // Sleep until I2S releases a buffer or a trigger arrives (SEV),
+        // with the poll interval as an upper bound
+        best_effort_wfe_or_timeout(make_timeout_time_us(CORE1_POLL_US));
+    }
+    
+    core1Exited_ = true;
+}
+
+void AudioController::installConnectionHooks() {
+    connection_ = bufferPool_ ? bufferPool_->connection : nullptr;
+    if (!connection_ || s_consumerTake) {
+        return;
+    }
+    
+    // The I2S DMA IRQ takes its next buffer through this callback and
+    // falls back to silence when it returns nullptr. It runs right after
+    // the finished buffer is given back to our pool, so it is also the
+    // refill point. With the pass-through connection the buffer it
+    // returns is one of ours, stamp and all.
+    s_consumerTake = connection_->consumer_pool_take;
+    connection_->consumer_pool_take = &AudioController::consumerTakeHook;
+}
+
+audio_buffer_t* AudioController::consumerTakeHook(audio_connection_t* connection, bool block) {
+    audio_buffer_t* buffer = s_consumerTake(connection, block);
+    
+    AudioController* controller = AudioController::instance_;
+    if (!controller) {
+        return buffer;
+    }
+    if (buffer) {
+        if (buffer == controller->hotBuffer_) {
+            // Already playing; too late to swap into
+            controller->hotBuffer_ = nullptr;
+        }
+        controller->publishPlayoutIntensity(buffer->user_data);
+        controller->measureTriggerLatency(buffer);
+        
+        // Depth as I2S found it, this buffer included, in producer buffers.
+        // Counted in frames, so it stays right whatever size I2S takes.
+        const uint32_t queued = controller->queuedSamples_.load();
+        const uint32_t perBuffer = std::max<uint32_t>(controller->config_.samplesPerBuffer, 1);
+        const uint32_t depth = (queued + perBuffer - 1) / perBuffer;
+        ++controller->queueDepth_[std::min<uint32_t>(std::max<uint32_t>(depth, 1), QUEUE_DEPTH_BINS - 1)];
+        controller->queuedSamples_ -= std::min<uint32_t>(queued, buffer->sample_count);
+    } else if (controller->primed_ &&
+               controller->playbackState_ == PlaybackState::Playing) {
+        ++controller->underruns_;
+        ++controller->queueDepth_[0];
+    }
+    if (controller->playbackState_ == PlaybackState::Playing || controller->keepAlive()) {
+        controller->requestRefill();
+    }
+    return buffer;
+}
+
+void AudioController::setupRefillIrq() {
+    if (refillIrq_ >= 0) {
+        return;
+    }
+    
+    refillIrq_ = user_irq_claim_unused(false);
+    if (refillIrq_ < 0) {
+        printf("AudioController: No free user IRQ - refilling from the %ld ms timer only\n",
+               (long)STREAM_POLL_MS);
+        return;
+    }
+    
+    // Same priority as the timer alarm so the two producers never nest
+    irq_set_exclusive_handler(refillIrq_, &AudioController::refillIrqHandler);
+    irq_set_priority(refillIrq_, PICO_DEFAULT_IRQ_PRIORITY);
+    irq_set_enabled(refillIrq_, true);
+    printf("AudioController: Release-driven refill on IRQ %d\n", refillIrq_);
+}
+
+void AudioController::releaseRefillIrq() {
+    if (refillIrq_ < 0) {
+        return;
+    }
+    
+    irq_set_enabled(refillIrq_, false);
+    irq_remove_handler(refillIrq_, &AudioController::refillIrqHandler);
+    user_irq_unclaim(refillIrq_);
+    refillIrq_ = -1;
+}
+
+void AudioController::refillIrqHandler() {
+    AudioController* controller = AudioController::instance_;
+    if (!controller) {
+        return;
+    }
+    
+    if (controller->playbackState_ == PlaybackState::Playing || !controller->commands_.empty() ||
+        controller->keepAlive()) {
+        // fillAudioBuffer() marks the end of playback; a paused or
+        // keep-alive silent fill must not change the state
+        controller->produceBuffers(controller->producerPool_.getDepth());
+    }
+}
+
+void AudioController::requestRefill() {
+    if (config_.streamingMode == StreamingMode::Core1) {
+        ++refillRequests_;
+        __sev();
+    } else if (refillIrq_ >= 0) {
+        ++refillRequests_;
+        irq_set_pending(refillIrq_);
+    }
+}
+
 } // namespace Exterminate
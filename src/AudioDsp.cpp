@@ -0,0 +1,141 @@
+#include "AudioDsp.h"
+#include <cmath>
+
+namespace Exterminate::AudioDsp {
+
+namespace {
+
+constexpr float PI = 3.14159265f;
+
+inline float dbToLinear(float db) {
+    return std::pow(10.0f, db / 20.0f);
+}
+
+// One-pole smoothing coefficient (Q15) reaching ~63% in @p ms
+inline int32_t smoothingCoeff(float ms, uint32_t sampleRate) {
+    const float samples = std::max(1.0f, ms * sampleRate / 1000.0f);
+    return std::max<int32_t>(1, static_cast<int32_t>((1.0f - std::exp(-1.0f / samples)) * UNITY_Q15));
+}
+
+} // namespace
+
+void DcBlocker::configure(float cornerHz, uint32_t sampleRate) {
+    const float pole = std::exp(-2.0f * PI * cornerHz / std::max<uint32_t>(sampleRate, 1));
+    pole_ = std::min<int32_t>(UNITY_Q15 - 1, static_cast<int32_t>(pole * UNITY_Q15));
+    reset();
+}
+
+void RingModulator::configure(float frequencyHz, uint32_t sampleRate) {
+    step_ = static_cast<uint32_t>(static_cast<double>(frequencyHz) * 4294967296.0 / std::max<uint32_t>(sampleRate, 1));
+    reset();
+}
+
+void Biquad::configure(const Config& config, uint32_t sampleRate) {
+    reset();
+
+    const float rate = static_cast<float>(std::max<uint32_t>(sampleRate, 1));
+    const float frequency = std::min(std::max(config.frequencyHz, 1.0f), rate * 0.45f);
+    const float w0 = 2.0f * PI * frequency / rate;
+    const float cosW0 = std::cos(w0);
+    const float alpha = std::sin(w0) / (2.0f * std::max(config.q, 0.1f));
+    const float amplitude = std::pow(10.0f, config.gainDb / 40.0f);
+
+    float b0 = 1.0f, b1 = 0.0f, b2 = 0.0f, a0 = 1.0f, a1 = 0.0f, a2 = 0.0f;
+    switch (config.type) {
+        case Type::Bypass:
+            break;
+        case Type::LowPass:
+            b0 = (1.0f - cosW0) / 2.0f;
+            b1 = 1.0f - cosW0;
+            b2 = b0;
+            a0 = 1.0f + alpha;
+            a1 = -2.0f * cosW0;
+            a2 = 1.0f - alpha;
+            break;
+        case Type::HighPass:
+            b0 = (1.0f + cosW0) / 2.0f;
+            b1 = -(1.0f + cosW0);
+            b2 = b0;
+            a0 = 1.0f + alpha;
+            a1 = -2.0f * cosW0;
+            a2 = 1.0f - alpha;
+            break;
+        case Type::Peaking:
+            b0 = 1.0f + alpha * amplitude;
+            b1 = -2.0f * cosW0;
+            b2 = 1.0f - alpha * amplitude;
+            a0 = 1.0f + alpha / amplitude;
+            a1 = -2.0f * cosW0;
+            a2 = 1.0f - alpha / amplitude;
+            break;
+        case Type::LowShelf:
+        case Type::HighShelf: {
+            const float sign = config.type == Type::LowShelf ? 1.0f : -1.0f;
+            const float root = 2.0f * std::sqrt(amplitude) * alpha;
+            const float ap = amplitude + 1.0f;
+            const float am = amplitude - 1.0f;
+            b0 = amplitude * (ap - sign * am * cosW0 + root);
+            b1 = sign * 2.0f * amplitude * (am - sign * ap * cosW0);
+            b2 = amplitude * (ap - sign * am * cosW0 - root);
+            a0 = ap + sign * am * cosW0 + root;
+            a1 = -sign * 2.0f * (am + sign * ap * cosW0);
+            a2 = ap + sign * am * cosW0 - root;
+            break;
+        }
+    }
+
+    const float scale = static_cast<float>(1 << COEFF_SHIFT) / a0;
+    b0_ = static_cast<int32_t>(std::lround(b0 * scale));
+    b1_ = static_cast<int32_t>(std::lround(b1 * scale));
+    b2_ = static_cast<int32_t>(std::lround(b2 * scale));
+    a1_ = static_cast<int32_t>(std::lround(a1 * scale));
+    a2_ = static_cast<int32_t>(std::lround(a2 * scale));
+}
+
+void Compressor::configure(const Config& config, uint32_t sampleRate) {
+    thresholdDb_ = config.thresholdDb;
+    slope_ = 1.0f - 1.0f / std::max(config.ratio, 1.0f);
+    makeupDb_ = config.makeupDb;
+    threshold_ = static_cast<int32_t>(dbToLinear(config.thresholdDb) * UNITY_Q15);
+    makeupGain_ = std::min<int32_t>(8 << GAIN_SHIFT, static_cast<int32_t>(dbToLinear(config.makeupDb) * (1 << GAIN_SHIFT)));
+    attack_ = smoothingCoeff(config.attackMs, sampleRate);
+    release_ = smoothingCoeff(config.releaseMs, sampleRate);
+    reset();
+}
+
+void Compressor::reset() {
+    envelope_ = 0;
+    gain_ = makeupGain_;
+    gainStep_ = 0;
+    countdown_ = 0;
+}
+
+void Compressor::updateGain() {
+    countdown_ = CONTROL_SAMPLES;
+
+    // Below the threshold only make-up gain applies, without any float work
+    int32_t target = makeupGain_;
+    if (envelope_ > threshold_) {
+        const float levelDb = 20.0f * std::log10(static_cast<float>(envelope_) / UNITY_Q15);
+        const float gainDb = makeupDb_ - (levelDb - thresholdDb_) * slope_;
+        target = std::min<int32_t>(8 << GAIN_SHIFT, static_cast<int32_t>(dbToLinear(gainDb) * (1 << GAIN_SHIFT)));
+    }
+    gainStep_ = (target - gain_) / static_cast<int32_t>(CONTROL_SAMPLES);
+}
+
+void SoftLimiter::configure(int32_t knee, int32_t ceiling) {
+    ceiling = std::max<int32_t>(1, std::min<int32_t>(INT16_MAX, ceiling));
+    knee_ = std::max<int32_t>(0, std::min(knee, ceiling - 1));
+    room_ = ceiling - knee_;
+}
+
+void PeakLimiter::configure(int32_t ceiling, float releaseMs, uint32_t sampleRate) {
+    ceiling_ = std::max<int32_t>(1, std::min<int32_t>(INT16_MAX, ceiling));
+
+    // Envelope decays by 1/2^shift per sample: time constant ~ 2^shift samples
+    const float releaseSamples = std::max(1.0f, releaseMs * sampleRate / 1000.0f);
+    releaseShift_ = std::max<int32_t>(1, std::min<int32_t>(20, static_cast<int32_t>(std::lround(std::log2(releaseSamples)))));
+    reset();
+}
+
+} // namespace Exterminate::AudioDsp
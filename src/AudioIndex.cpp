@@ -1,31 +1,43 @@
 // Audio index implementations for Exterminate project
-// This file contains the actual definitions for audio file registry
+// The compiled-in registry is constexpr in audio_index.h; these lookups
+// also cover a mounted sound bank
 // 
 // Auto-generated by tools/audio_to_pcm_header.py - DO NOT EDIT MANUALLY
 
-#include "../include/audio/audio_index.h"
+#include <audio/audio_index.h>
 
 namespace Exterminate {
 namespace Audio {
 
-const AudioFile AUDIO_FILES[] = {
-    {"00001.mp3", AUDIO_00001_DATA, AUDIO_00001_SAMPLE_COUNT, AUDIO_00001_BYTE_SIZE,
-     AUDIO_00001_SAMPLE_RATE, AUDIO_00001_CHANNELS, AUDIO_00001_BIT_DEPTH},
-};
+// Registry in use; a mounted sound bank replaces the compiled-in table
+static const AudioFile* activeFiles = AUDIO_FILES;
+static size_t activeFileCount = AUDIO_FILE_COUNT;
 
-const size_t AUDIO_FILE_COUNT = 1;
+void setAudioFileTable(const AudioFile* files, size_t count) {
+    activeFiles = files ? files : AUDIO_FILES;
+    activeFileCount = files ? count : AUDIO_FILE_COUNT;
+}
+
+size_t getAudioFileCount() {
+    return activeFileCount;
+}
 
 const AudioFile* getAudioFile(AudioIndex index) {
-    if (static_cast<size_t>(index) >= AUDIO_FILE_COUNT) {
+    if (static_cast<size_t>(index) >= activeFileCount) {
         return nullptr;
     }
-    return &AUDIO_FILES[static_cast<size_t>(index)];
+    return &activeFiles[static_cast<size_t>(index)];
 }
 
 const AudioFile* getAudioFile(const char* name) {
-    for (size_t i = 0; i < AUDIO_FILE_COUNT; ++i) {
-        if (strcmp(AUDIO_FILES[i].name, name) == 0) {
-            return &AUDIO_FILES[i];
+    // Compiled-in names are perfect-hashed; a bank's names are only known at run time
+    if (activeFiles == AUDIO_FILES) {
+        const AudioIndex index = findAudioIndex(name);
+        return index == AudioIndex::COUNT ? nullptr : &AUDIO_FILES[static_cast<size_t>(index)];
+    }
+    for (size_t i = 0; i < activeFileCount; ++i) {
+        if (strcmp(activeFiles[i].name, name) == 0) {
+            return &activeFiles[i];
         }
     }
     return nullptr;
@@ -0,0 +1,89 @@
+#include "AudioKernels.h"
+#include <algorithm>
+
+#if defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <arm_acle.h>
+#define EXTERMINATE_AUDIO_DSP 1
+#else
+#define EXTERMINATE_AUDIO_DSP 0
+#endif
+
+namespace Exterminate::AudioKernels {
+
+namespace {
+
+// Word-sized view of the sample buffer; may alias the int16_t samples
+typedef uint32_t __attribute__((__may_alias__)) SampleWord;
+
+#if EXTERMINATE_AUDIO_DSP
+inline uint32_t scaleToFrame(int32_t sample, int32_t volumeQ16) {
+    int32_t scaled = __ssat(__smulwb(volumeQ16, sample), 16);
+    return __pkhbt(scaled, scaled, 16);
+}
+#else
+inline uint32_t scaleToFrame(int32_t sample, int32_t volumeQ16) {
+    int32_t scaled = static_cast<int32_t>((static_cast<int64_t>(sample) * volumeQ16) >> 16);
+    scaled = std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, scaled));
+    uint32_t half = static_cast<uint16_t>(scaled);
+    return half | (half << 16);
+}
+#endif
+
+} // namespace
+
+uint16_t volumeToQ15(float volume) {
+    volume = std::max(0.0f, std::min(1.0f, volume));
+    return static_cast<uint16_t>(volume * 32768.0f);
+}
+
+void monoToInterleavedReference(int16_t* samples, size_t count, uint16_t channels, float volume) {
+    for (size_t i = count; i-- > 0;) {
+        // Apply volume and clamp to prevent overflow
+        float sample = static_cast<float>(samples[i]) * volume;
+        sample = std::max(-32768.0f, std::min(32767.0f, sample));
+        int16_t outputSample = static_cast<int16_t>(sample);
+
+        // Duplicate mono sample to all channels
+        for (uint16_t ch = 0; ch < channels; ++ch) {
+            samples[i * channels + ch] = outputSample;
+        }
+    }
+}
+
+void monoToStereoQ15(int16_t* samples, size_t count, uint16_t volumeQ15) {
+    // SMULW multiplies by a 32-bit operand and keeps the top 48 bits, so
+    // the Q15 volume is promoted to Q16 (65536 = unity)
+    const int32_t volumeQ16 = static_cast<int32_t>(volumeQ15) << 1;
+    SampleWord* frames = reinterpret_cast<SampleWord*>(samples);
+    const SampleWord* pairs = reinterpret_cast<const SampleWord*>(samples);
+
+    // Work back to front so stereo writes never overtake unread mono input
+    size_t i = count;
+    if (i & 1) {
+        --i;
+        frames[i] = scaleToFrame(samples[i], volumeQ16);
+    }
+
+    while (i >= 2) {
+        i -= 2;
+        // One load fetches two mono samples (little-endian: low half first)
+        uint32_t pair = pairs[i >> 1];
+#if EXTERMINATE_AUDIO_DSP
+        int32_t low = __ssat(__smulwb(volumeQ16, pair), 16);
+        int32_t high = __ssat(__smulwt(volumeQ16, pair), 16);
+        frames[i + 1] = __pkhbt(high, high, 16);
+        frames[i] = __pkhbt(low, low, 16);
+#else
+        int16_t low = static_cast<int16_t>(pair & 0xFFFFu);
+        int16_t high = static_cast<int16_t>(pair >> 16);
+        frames[i + 1] = scaleToFrame(high, volumeQ16);
+        frames[i] = scaleToFrame(low, volumeQ16);
+#endif
+    }
+}
+
+bool hasDspExtension() {
+    return EXTERMINATE_AUDIO_DSP != 0;
+}
+
+} // namespace Exterminate::AudioKernels
@@ -0,0 +1,342 @@
+#include "AudioMixer.h"
+#include <algorithm>
+
+namespace Exterminate {
+
+namespace {
+
+static_assert(AudioMixer::MAX_VOICES <= ClipPrefetcher::MAX_STREAMS, "Each voice needs its own clip stream");
+
+inline int16_t saturate16(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(value);
+}
+
+} // namespace
+
+AudioMixer::AudioMixer()
+    : voices_{}
+    , accumulator_{}
+    , decodeBuffer_{}
+    , startCounter_(0)
+    , outputRate_(Audio::AUDIO_SAMPLE_RATE)
+    , speechPitch_(PITCH_UNITY)
+    , releaseCallback_(nullptr)
+    , releaseContext_(nullptr)
+    , prefetcher_(nullptr)
+{
+}
+
+void AudioMixer::setReleaseCallback(ReleaseCallback callback, void* context) {
+    releaseCallback_ = callback;
+    releaseContext_ = context;
+}
+
+void AudioMixer::setPrefetcher(ClipPrefetcher* prefetcher) {
+    prefetcher_ = prefetcher;
+}
+
+void AudioMixer::setOutputRate(uint32_t sampleRate) {
+    if (sampleRate > 0) {
+        outputRate_ = sampleRate;
+    }
+}
+
+void AudioMixer::setSpeechPitch(uint16_t scaleQ12) {
+    speechPitch_ = scaleQ12;
+}
+
+uint32_t AudioMixer::effectiveStep(const Voice& voice) const {
+    if (voice.priority != VoicePriority::Speech || speechPitch_ == PITCH_UNITY) {
+        return voice.phaseStep;
+    }
+    const uint64_t step = (static_cast<uint64_t>(voice.phaseStep) * speechPitch_) >> 12;
+    return static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(step, PHASE_ONE * MAX_RATE_RATIO)));
+}
+
+void AudioMixer::primeInterpolator(Voice& voice) {
+    int16_t first[2] = {0, 0};
+    const size_t primed = readClip(voice, first, 2);
+    voice.current = first[0];
+    voice.next = first[1];
+    voice.nextValid = primed == 2;
+    voice.phase = 0;
+    voice.interpolating = true;
+}
+
+uint32_t AudioMixer::phaseStepFor(const Audio::AudioFile* file) const {
+    // Clips without a rate are assumed to match the bus
+    const uint32_t clipRate = file->sample_rate ? file->sample_rate : outputRate_;
+    if (clipRate > outputRate_ * MAX_RATE_RATIO) {
+        return 0;
+    }
+    return static_cast<uint32_t>((static_cast<uint64_t>(clipRate) << 16) / outputRate_);
+}
+
+int AudioMixer::startVoice(const Audio::AudioFile* file, uint16_t gain, VoicePriority priority,
+                           size_t skipSamples) {
+    ClipReader reader;
+    if (!reader.open(file)) {
+        return -1;
+    }
+
+    const uint32_t phaseStep = phaseStepFor(file);
+    if (phaseStep == 0) {
+        return -1;
+    }
+
+    int slot = findVoiceSlot(priority);
+    if (slot < 0) {
+        return -1;
+    }
+
+    Voice& voice = voices_[slot];
+    releaseVoice(voice);
+    voice.reader = reader;
+    if (prefetcher_) {
+        voice.reader.setStream(prefetcher_->stream(static_cast<size_t>(slot)));
+    }
+    voice.gain = gain;
+    voice.priority = priority;
+    voice.startOrder = startCounter_++;
+    voice.active = true;
+    voice.phaseStep = phaseStep;
+    voice.interpolating = false;
+    voice.phase = 0;
+    voice.current = 0;
+    voice.next = 0;
+    voice.nextValid = false;
+
+    const uint32_t step = effectiveStep(voice);
+    if (step != PHASE_ONE) {
+        primeInterpolator(voice);
+    }
+
+    if (skipSamples > 0) {
+        bool playing = true;
+        if (!voice.interpolating) {
+            voice.reader.skip(skipSamples);
+            playing = !voice.reader.atEnd();
+        } else {
+            // The converter state only advances by producing output
+            while (skipSamples > 0 && playing) {
+                const size_t chunk = std::min(MIX_CHUNK, skipSamples);
+                playing = readResampled(voice, decodeBuffer_, chunk, step) == chunk;
+                skipSamples -= chunk;
+            }
+        }
+        if (!playing) {
+            releaseVoice(voice);
+        }
+    }
+    return slot;
+}
+
+int AudioMixer::queueVoice(const Audio::AudioFile* file, uint16_t gain, VoicePriority priority) {
+    // Chain onto the most recently started voice
+    int newest = -1;
+    for (size_t i = 0; i < MAX_VOICES; ++i) {
+        const Voice& voice = voices_[i];
+        if (voice.active && (newest < 0 ||
+                             static_cast<int32_t>(voice.startOrder - voices_[newest].startOrder) > 0)) {
+            newest = static_cast<int>(i);
+        }
+    }
+    if (newest < 0) {
+        return startVoice(file, gain, priority);
+    }
+
+    // The interpolator carries straight across the seam, so the step must match
+    Voice& voice = voices_[newest];
+    if (!file || phaseStepFor(file) != voice.phaseStep || !voice.reader.setNext(file)) {
+        return -1;
+    }
+    return newest;
+}
+
+void AudioMixer::stopVoice(int voice) {
+    if (voice >= 0 && static_cast<size_t>(voice) < MAX_VOICES) {
+        releaseVoice(voices_[voice]);
+    }
+}
+
+void AudioMixer::stopAll() {
+    for (Voice& voice : voices_) {
+        releaseVoice(voice);
+    }
+}
+
+void AudioMixer::releaseVoice(Voice& voice) {
+    if (!voice.active) {
+        return;
+    }
+    voice.active = false;
+    if (releaseCallback_) {
+        if (voice.reader.file()) {
+            releaseCallback_(voice.reader.file(), releaseContext_);
+        }
+        if (voice.reader.next()) {
+            releaseCallback_(voice.reader.next(), releaseContext_);
+        }
+    }
+}
+
+size_t AudioMixer::readClip(Voice& voice, int16_t* out, size_t count) {
+    const Audio::AudioFile* file = voice.reader.file();
+    const size_t read = voice.reader.read(out, count);
+
+    // The reader moved on to its chained clip; the finished one is free
+    if (voice.reader.file() != file && releaseCallback_) {
+        releaseCallback_(file, releaseContext_);
+    }
+    return read;
+}
+
+size_t AudioMixer::activeVoiceCount() const {
+    size_t count = 0;
+    for (const Voice& voice : voices_) {
+        if (voice.active) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+uint8_t AudioMixer::envelopeAt(const Audio::AudioFile* file, size_t position) {
+    if (!file || !file->envelope || file->sample_count == 0) {
+        return 0;
+    }
+    // A finished reader sits at sample_count, which may be one block past the table
+    const size_t blocks = (file->sample_count + Audio::ENVELOPE_BLOCK_SAMPLES - 1) / Audio::ENVELOPE_BLOCK_SAMPLES;
+    return file->envelope[std::min(position / Audio::ENVELOPE_BLOCK_SAMPLES, blocks - 1)];
+}
+
+uint8_t AudioMixer::envelopeLevel() const {
+    uint32_t level = 0;
+    for (const Voice& voice : voices_) {
+        if (!voice.active) {
+            continue;
+        }
+        const uint32_t envelope = envelopeAt(voice.reader.file(), voice.reader.position());
+        level = std::max(level, (envelope * voice.gain) >> 15);
+    }
+    return static_cast<uint8_t>(std::min<uint32_t>(level, 255));
+}
+
+int AudioMixer::findVoiceSlot(VoicePriority priority) const {
+    int victim = -1;
+    for (size_t i = 0; i < MAX_VOICES; ++i) {
+        const Voice& voice = voices_[i];
+        if (!voice.active) {
+            return static_cast<int>(i);
+        }
+        // Only steal voices at or below the requested priority; among
+        // those prefer the lowest priority, then the oldest start
+        if (voice.priority > priority) {
+            continue;
+        }
+        if (victim < 0) {
+            victim = static_cast<int>(i);
+            continue;
+        }
+        const Voice& current = voices_[victim];
+        if (voice.priority < current.priority ||
+            (voice.priority == current.priority &&
+             static_cast<int32_t>(voice.startOrder - current.startOrder) < 0)) {
+            victim = static_cast<int>(i);
+        }
+    }
+    return victim;
+}
+
+size_t AudioMixer::mix(int16_t* out, size_t sampleCount) {
+    size_t produced = 0;
+
+    for (size_t offset = 0; offset < sampleCount; offset += MIX_CHUNK) {
+        const size_t chunk = std::min(MIX_CHUNK, sampleCount - offset);
+        std::fill(accumulator_, accumulator_ + chunk, 0);
+
+        for (Voice& voice : voices_) {
+            if (!voice.active) {
+                continue;
+            }
+
+            // Decode (or copy) this voice's next chunk, then accumulate.
+            // A native voice joins the converter the first time its pitch bends.
+            const uint32_t step = effectiveStep(voice);
+            const bool native = step == PHASE_ONE && !voice.interpolating;
+            if (!native && !voice.interpolating) {
+                primeInterpolator(voice);
+            }
+            const size_t count = native ? readClip(voice, decodeBuffer_, chunk)
+                                        : readResampled(voice, decodeBuffer_, chunk, step);
+            const int32_t gain = voice.gain;
+
+            for (size_t i = 0; i < count; ++i) {
+                accumulator_[i] += (static_cast<int32_t>(decodeBuffer_[i]) * gain) >> 15;
+            }
+
+            produced = std::max(produced, offset + count);
+            if (native ? voice.reader.atEnd() : count < chunk) {
+                releaseVoice(voice);
+            }
+        }
+
+        for (size_t i = 0; i < chunk; ++i) {
+            out[offset + i] = saturate16(accumulator_[i]);
+        }
+    }
+
+    return produced;
+}
+
+size_t AudioMixer::readResampled(Voice& voice, int16_t* out, size_t count, uint32_t step) {
+    // Fetch every clip sample this run will step over in one read, into
+    // the tail of decodeBuffer_ so output can overwrite it from the front
+    const uint32_t advances = (voice.phase + step * static_cast<uint32_t>(count)) >> 16;
+    int16_t* input = decodeBuffer_ + (sizeof(decodeBuffer_) / sizeof(decodeBuffer_[0])) - advances;
+    const size_t fetched = readClip(voice, input, advances);
+
+    uint32_t phase = voice.phase;
+    int32_t current = voice.current;
+    int32_t next = voice.next;
+    bool nextValid = voice.nextValid;
+    size_t consumed = 0;
+    size_t written = 0;
+
+    while (written < count) {
+        // Linear interpolation on the top 15 fraction bits keeps the
+        // product inside 32 bits
+        const int32_t fraction = static_cast<int32_t>(phase >> 1);
+        out[written++] = static_cast<int16_t>(current + (((next - current) * fraction) >> 15));
+
+        phase += step;
+        bool ended = false;
+        while (phase >= PHASE_ONE) {
+            phase -= PHASE_ONE;
+            if (!nextValid) {
+                ended = true;
+                break;
+            }
+            current = next;
+            if (consumed < fetched) {
+                next = input[consumed++];
+            } else {
+                next = 0;
+                nextValid = false;
+            }
+        }
+        if (ended) {
+            break;
+        }
+    }
+
+    voice.phase = phase;
+    voice.current = static_cast<int16_t>(current);
+    voice.next = static_cast<int16_t>(next);
+    voice.nextValid = nextValid;
+    return written;
+}
+
+} // namespace Exterminate
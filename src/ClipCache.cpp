@@ -0,0 +1,224 @@
+#include "ClipCache.h"
+#include <algorithm>
+#include <cstring>
+#include <stdio.h>
+
+namespace Exterminate {
+
+ClipCache::ClipCache()
+    : heap_(nullptr)
+    , useClock_(0)
+    , pending_(nullptr)
+    , filling_(nullptr)
+    , fillBuffer_{}
+    , hits_(0)
+    , misses_(0)
+    , fills_(0)
+    , evictions_(0)
+{
+    for (Entry& entry : entries_) {
+        entry.source = nullptr;
+        entry.samples = nullptr;
+        entry.filled = 0;
+        entry.lastUse = 0;
+        entry.users = 0;
+        entry.ready = false;
+    }
+}
+
+ClipCache::~ClipCache() {
+    end();
+}
+
+bool ClipCache::begin(PsramAllocator* heap) {
+    if (!heap || !heap->isReady()) {
+        return false;
+    }
+    heap_ = heap;
+    printf("ClipCache: %u KB of PSRAM for decoded clips\n",
+           static_cast<unsigned>(heap_->capacity() / 1024));
+    return true;
+}
+
+void ClipCache::end() {
+    if (!heap_) {
+        return;
+    }
+    for (Entry& entry : entries_) {
+        if (entry.source) {
+            heap_->free(entry.samples);
+            entry.source = nullptr;
+            entry.samples = nullptr;
+            entry.ready = false;
+            entry.users = 0;
+        }
+    }
+    fillReader_.close();
+    pending_ = nullptr;
+    filling_ = nullptr;
+    heap_ = nullptr;
+}
+
+const Audio::AudioFile* ClipCache::acquire(const Audio::AudioFile* source) {
+    if (!heap_ || !source) {
+        return source;
+    }
+
+    Entry* entry = find(source);
+    if (entry && entry->ready) {
+        ++entry->users;
+        entry->lastUse = ++useClock_;
+        ++hits_;
+        return &entry->file;
+    }
+
+    // Play from flash this time; decode it for next time
+    ++misses_;
+    if (!entry && !pending_) {
+        pending_ = source;
+    }
+    return source;
+}
+
+void ClipCache::release(const Audio::AudioFile* file) {
+    for (Entry& entry : entries_) {
+        if (&entry.file == file) {
+            uint16_t users = entry.users.load();
+            while (users > 0 && !entry.users.compare_exchange_weak(users, users - 1)) {
+            }
+            return;
+        }
+    }
+}
+
+void ClipCache::service(size_t maxSamples) {
+    if (!heap_) {
+        return;
+    }
+
+    if (!filling_) {
+        const Audio::AudioFile* source = pending_;
+        pending_ = nullptr;
+        if (!source || find(source)) {
+            return;
+        }
+        filling_ = reserve(source);
+        if (!filling_) {
+            return;
+        }
+        fillReader_.open(source);
+        fillReader_.endLoop();  // The copy holds the whole clip once
+    }
+
+    Entry& entry = *filling_;
+    const size_t total = entry.source->sample_count;
+    while (maxSamples > 0 && entry.filled < total) {
+        const size_t count = std::min({FILL_SLICE, maxSamples, total - entry.filled});
+        const size_t decoded = fillReader_.read(fillBuffer_, count);
+        if (decoded == 0) {
+            printf("ClipCache: ERROR - '%s' ended after %zu of %zu samples\n",
+                   entry.source->name, entry.filled, total);
+            evict(entry);
+            fillReader_.close();
+            filling_ = nullptr;
+            return;
+        }
+        memcpy(entry.samples + entry.filled, fillBuffer_, decoded * sizeof(int16_t));
+        entry.filled += decoded;
+        maxSamples -= decoded;
+    }
+
+    if (entry.filled == total) {
+        entry.ready = true;
+        ++fills_;
+        fillReader_.close();
+        filling_ = nullptr;
+    }
+}
+
+ClipCache::Stats ClipCache::getStats() const {
+    Stats stats{hits_, misses_, fills_, evictions_, 0, 0, 0};
+    if (heap_) {
+        stats.bytesUsed = heap_->bytesUsed();
+        stats.capacity = heap_->capacity();
+    }
+    for (const Entry& entry : entries_) {
+        if (entry.ready) {
+            ++stats.clips;
+        }
+    }
+    return stats;
+}
+
+ClipCache::Entry* ClipCache::find(const Audio::AudioFile* source) {
+    for (Entry& entry : entries_) {
+        if (entry.source == source) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
+
+ClipCache::Entry* ClipCache::reserve(const Audio::AudioFile* source) {
+    const size_t bytes = source->sample_count * sizeof(int16_t);
+    if (bytes == 0 || bytes > heap_->capacity()) {
+        return nullptr;
+    }
+
+    Entry* slot = nullptr;
+    void* samples = nullptr;
+    for (;;) {
+        if (!slot) {
+            slot = find(nullptr);
+        }
+        if (slot && !samples) {
+            samples = heap_->allocate(bytes);
+        }
+        if (slot && samples) {
+            break;
+        }
+
+        // Make room: least recently used clip that no voice is playing
+        Entry* victim = nullptr;
+        for (Entry& entry : entries_) {
+            if (entry.ready && entry.users == 0 &&
+                (!victim || static_cast<int32_t>(entry.lastUse - victim->lastUse) < 0)) {
+                victim = &entry;
+            }
+        }
+        if (!victim) {
+            heap_->free(samples);
+            return nullptr;
+        }
+        evict(*victim);
+    }
+
+    Entry& entry = *slot;
+    entry.source = source;
+    entry.file = *source;
+    entry.file.data = static_cast<const int16_t*>(samples);
+    entry.file.byte_size = bytes;
+    entry.file.channels = 1;
+    entry.file.bit_depth = 16;
+    entry.file.codec = Audio::AudioCodec::PCM16;
+    entry.file.encoded = nullptr;
+    entry.samples = static_cast<int16_t*>(samples);
+    entry.filled = 0;
+    entry.lastUse = ++useClock_;
+    entry.users = 0;
+    entry.ready = false;
+    return &entry;
+}
+
+void ClipCache::evict(Entry& entry) {
+    if (entry.ready) {
+        ++evictions_;
+    }
+    heap_->free(entry.samples);
+    entry.source = nullptr;
+    entry.samples = nullptr;
+    entry.filled = 0;
+    entry.ready = false;
+}
+
+} // namespace Exterminate
@@ -0,0 +1,256 @@
+#include "ClipPrefetcher.h"
+#include "CycleCounter.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/structs/xip_ctrl.h"
+#include <algorithm>
+#include <stdio.h>
+
+namespace Exterminate {
+
+namespace {
+
+// Flash (QMI window 0) and PSRAM (window 1) in the cached XIP alias
+constexpr uintptr_t XIP_WINDOWS_BYTES = 0x02000000u;
+
+inline uintptr_t dmaAlias(const uint8_t* source) {
+    // DMA reads through the uncached, non-allocating alias so prefetching
+    // never evicts the flash code other masters are executing
+    const uintptr_t address = reinterpret_cast<uintptr_t>(source);
+    if (address >= XIP_BASE && address < XIP_BASE + XIP_WINDOWS_BYTES) {
+        return address - XIP_BASE + XIP_NOCACHE_NOALLOC_BASE;
+    }
+    return address;
+}
+
+} // namespace
+
+ClipStream::ClipStream()
+    : owner_(nullptr)
+    , source_(nullptr)
+    , dmaSource_(0)
+    , bytes_(0)
+    , window_{NO_WINDOW, NO_WINDOW}
+    , loading_{false, false}
+    , wantedWindow_(NO_WINDOW)
+    , wantedHalf_(0)
+    , loopFrom_(NO_WINDOW)
+    , loopTo_(NO_WINDOW)
+    , buffer_{}
+{
+}
+
+void ClipStream::open(const uint8_t* source, size_t bytes) {
+    close();
+    source_ = source;
+    dmaSource_ = dmaAlias(source);
+    bytes_ = bytes;
+
+    // Start on the first window now; the first fetch waits for it at most
+    if (source_ && bytes_ > 0) {
+        prefetch(0, 0);
+    }
+}
+
+void ClipStream::close() {
+    if (owner_ && owner_->busyStream_ == this) {
+        while (!owner_->retire()) {
+            tight_loop_contents();
+        }
+    }
+    source_ = nullptr;
+    bytes_ = 0;
+    window_[0] = window_[1] = NO_WINDOW;
+    loading_[0] = loading_[1] = false;
+    wantedWindow_ = NO_WINDOW;
+    clearLoop();
+}
+
+void ClipStream::setLoop(size_t fromOffset, size_t toOffset) {
+    loopFrom_ = static_cast<uint32_t>(fromOffset / WINDOW_BYTES);
+    loopTo_ = static_cast<uint32_t>(toOffset / WINDOW_BYTES);
+}
+
+void ClipStream::clearLoop() {
+    loopFrom_ = loopTo_ = NO_WINDOW;
+}
+
+const uint8_t* ClipStream::fetch(size_t offset, size_t* available) {
+    const uint32_t window = static_cast<uint32_t>(offset / WINDOW_BYTES);
+    const size_t windowStart = static_cast<size_t>(window) * WINDOW_BYTES;
+    const size_t end = std::min(windowStart + WINDOW_BYTES, bytes_);
+    *available = offset < end ? end - offset : 0;
+
+    // Keep the channel busy with any prefetch that found it taken
+    owner_->startWanted();
+
+    for (uint8_t half = 0; half < 2; ++half) {
+        if (window_[half] != window) {
+            continue;
+        }
+        if (loading_[half]) {
+            owner_->waitFor(*this);
+        }
+        ++owner_->hits_;
+        prefetch(following(window), half ^ 1);
+        return buffer_[half] + (offset - windowStart);
+    }
+
+    // Not resident (seek, or DMA fell behind): read XIP and get ahead again
+    ++owner_->misses_;
+    prefetch(following(window), loading_[0] ? 1 : 0);
+    return source_ + offset;
+}
+
+void ClipStream::prefetch(uint32_t window, uint8_t half) {
+    const bool pastEnd = static_cast<size_t>(window) * WINDOW_BYTES >= bytes_;
+    if (pastEnd || window_[0] == window || window_[1] == window) {
+        if (wantedWindow_ == window || pastEnd) {
+            wantedWindow_ = NO_WINDOW;
+        }
+        return;
+    }
+
+    if (loading_[half] || !owner_ || !owner_->startLoad(*this, half, window)) {
+        wantedWindow_ = window;
+        wantedHalf_ = half;
+        return;
+    }
+    wantedWindow_ = NO_WINDOW;
+}
+
+ClipPrefetcher::ClipPrefetcher()
+    : channel_(-1)
+    , busyStream_(nullptr)
+    , busyHalf_(0)
+    , hits_(0)
+    , misses_(0)
+    , stalls_(0)
+    , stallCycles_(0)
+    , transfers_(0)
+{
+    for (ClipStream& stream : streams_) {
+        stream.owner_ = this;
+    }
+}
+
+ClipPrefetcher::~ClipPrefetcher() {
+    end();
+}
+
+bool ClipPrefetcher::begin() {
+    if (channel_ >= 0) {
+        return true;
+    }
+
+    channel_ = dma_claim_unused_channel(false);
+    if (channel_ < 0) {
+        printf("ClipPrefetcher: ERROR - No free DMA channel, clips read from XIP\n");
+        return false;
+    }
+
+    resetStats();
+    printf("ClipPrefetcher: DMA %d prefetching %u-byte windows for %u streams\n",
+           channel_, static_cast<unsigned>(ClipStream::WINDOW_BYTES), static_cast<unsigned>(MAX_STREAMS));
+    return true;
+}
+
+void ClipPrefetcher::end() {
+    if (channel_ < 0) {
+        return;
+    }
+
+    for (ClipStream& stream : streams_) {
+        stream.close();
+    }
+    dma_channel_unclaim(channel_);
+    channel_ = -1;
+}
+
+ClipStream* ClipPrefetcher::stream(size_t index) {
+    return (channel_ >= 0 && index < MAX_STREAMS) ? &streams_[index] : nullptr;
+}
+
+ClipPrefetcher::Stats ClipPrefetcher::getStats() const {
+    return Stats{hits_, misses_, stalls_, stallCycles_, transfers_,
+                 xip_ctrl_hw->ctr_acc, xip_ctrl_hw->ctr_hit};
+}
+
+void ClipPrefetcher::resetStats() {
+    hits_ = 0;
+    misses_ = 0;
+    stalls_ = 0;
+    stallCycles_ = 0;
+    transfers_ = 0;
+
+    // Any write clears the XIP cache counters
+    xip_ctrl_hw->ctr_acc = 0;
+    xip_ctrl_hw->ctr_hit = 0;
+}
+
+bool ClipPrefetcher::retire() {
+    if (channel_ < 0 || dma_channel_is_busy(channel_)) {
+        return false;
+    }
+    if (busyStream_) {
+        busyStream_->loading_[busyHalf_] = false;
+        busyStream_ = nullptr;
+    }
+    return true;
+}
+
+bool ClipPrefetcher::startLoad(ClipStream& stream, uint8_t half, uint32_t window) {
+    if (!retire()) {
+        return false;
+    }
+
+    const size_t offset = static_cast<size_t>(window) * ClipStream::WINDOW_BYTES;
+    const size_t length = std::min(ClipStream::WINDOW_BYTES, stream.bytes_ - offset);
+    const uintptr_t source = stream.dmaSource_ + offset;
+
+    // Word transfers when the clip allows it; the last word may read up to
+    // three bytes past the clip, which stay inside the window buffer
+    const bool aligned = (source & 3u) == 0;
+    dma_channel_config config = dma_channel_get_default_config(channel_);
+    channel_config_set_transfer_data_size(&config, aligned ? DMA_SIZE_32 : DMA_SIZE_8);
+    channel_config_set_read_increment(&config, true);
+    channel_config_set_write_increment(&config, true);
+
+    stream.window_[half] = window;
+    stream.loading_[half] = true;
+    busyStream_ = &stream;
+    busyHalf_ = half;
+    ++transfers_;
+
+    dma_channel_configure(channel_, &config, stream.buffer_[half],
+                          reinterpret_cast<const void*>(source),
+                          aligned ? (length + 3) / 4 : length, true);
+    return true;
+}
+
+void ClipPrefetcher::startWanted() {
+    if (!retire()) {
+        return;
+    }
+    for (ClipStream& stream : streams_) {
+        if (stream.wantedWindow_ != ClipStream::NO_WINDOW) {
+            stream.prefetch(stream.wantedWindow_, stream.wantedHalf_);
+            return;
+        }
+    }
+}
+
+void ClipPrefetcher::waitFor(ClipStream& stream) {
+    if (busyStream_ != &stream || retire()) {
+        return;
+    }
+
+    const uint32_t start = CycleCounter::now();
+    while (!retire()) {
+        tight_loop_contents();
+    }
+    ++stalls_;
+    stallCycles_ += CycleCounter::now() - start;
+}
+
+} // namespace Exterminate
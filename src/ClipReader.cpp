@@ -0,0 +1,361 @@
+#include "ClipReader.h"
+#include "ClipPrefetcher.h"
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+namespace Exterminate {
+
+namespace {
+
+// IMA-ADPCM quantiser step sizes and index adjustments
+constexpr int16_t ADPCM_STEP_TABLE[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+};
+
+constexpr int8_t ADPCM_INDEX_TABLE[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+constexpr int32_t ADPCM_MAX_STEP_INDEX = 88;
+
+constexpr int16_t muLawToLinear(uint8_t value) {
+    value = static_cast<uint8_t>(~value);
+    int32_t exponent = (value >> 4) & 0x07;
+    int32_t mantissa = value & 0x0F;
+    int32_t magnitude = (((mantissa << 3) + 0x84) << exponent) - 0x84;
+    return static_cast<int16_t>((value & 0x80) ? -magnitude : magnitude);
+}
+
+constexpr std::array<int16_t, 256> makeMuLawTable() {
+    std::array<int16_t, 256> table{};
+    for (size_t i = 0; i < table.size(); ++i) {
+        table[i] = muLawToLinear(static_cast<uint8_t>(i));
+    }
+    return table;
+}
+
+constexpr std::array<int16_t, 256> MU_LAW_TABLE = makeMuLawTable();
+
+inline bool hasSamples(const Audio::AudioFile* file) {
+    if (!file || file->sample_count == 0) {
+        return false;
+    }
+    return (file->codec == Audio::AudioCodec::PCM16) ? file->data != nullptr : file->encoded != nullptr;
+}
+
+} // namespace
+
+ClipReader::ClipReader()
+    : file_(nullptr)
+    , next_(nullptr)
+    , position_(0)
+    , stored_(nullptr)
+    , storedBytes_(0)
+    , stream_(nullptr)
+    , loopStart_(0)
+    , loopEnd_(0)
+    , looping_(false)
+    , adpcmPredictor_(0)
+    , adpcmStepIndex_(0)
+    , loopStateValid_(false)
+    , loopPredictor_(0)
+    , loopStepIndex_(0)
+{
+}
+
+bool ClipReader::open(const Audio::AudioFile* file) {
+    next_ = nullptr;
+    if (!attach(file)) {
+        return false;
+    }
+    stream_ = nullptr;
+    return true;
+}
+
+bool ClipReader::attach(const Audio::AudioFile* file) {
+    file_ = nullptr;
+    position_ = 0;
+    looping_ = false;
+    adpcmPredictor_ = 0;
+    adpcmStepIndex_ = 0;
+    loopStateValid_ = false;
+
+    if (!hasSamples(file)) {
+        return false;
+    }
+
+    file_ = file;
+    if (file->codec == Audio::AudioCodec::PCM16) {
+        stored_ = reinterpret_cast<const uint8_t*>(file->data);
+        storedBytes_ = file->sample_count * sizeof(int16_t);
+    } else {
+        stored_ = file->encoded;
+        storedBytes_ = (file->codec == Audio::AudioCodec::MU_LAW) ? file->sample_count : file->byte_size;
+    }
+
+    // Loop points outside the clip play it once
+    looping_ = file->loop_end > file->loop_start && file->loop_end <= file->sample_count;
+    loopStart_ = looping_ ? file->loop_start : 0;
+    loopEnd_ = looping_ ? file->loop_end : 0;
+    return true;
+}
+
+void ClipReader::close() {
+    if (stream_) {
+        stream_->close();
+        stream_ = nullptr;
+    }
+    file_ = nullptr;
+    next_ = nullptr;
+    looping_ = false;
+    position_ = 0;
+}
+
+void ClipReader::setStream(ClipStream* stream) {
+    stream_ = file_ ? stream : nullptr;
+    if (stream_) {
+        stream_->open(stored_, storedBytes_);
+        if (looping_) {
+            stream_->setLoop(storedOffset(loopEnd_ - 1), storedOffset(loopStart_));
+        }
+    }
+}
+
+bool ClipReader::setNext(const Audio::AudioFile* next) {
+    if (!file_ || next_ || !hasSamples(next)) {
+        return false;
+    }
+    next_ = next;
+    endLoop();
+    return true;
+}
+
+void ClipReader::endLoop() {
+    looping_ = false;
+    if (stream_) {
+        stream_->clearLoop();
+    }
+}
+
+bool ClipReader::continueAtEnd() {
+    if (looping_) {
+        // The first wrap decodes into an ADPCM block; later ones restore it
+        if (loopStateValid_) {
+            position_ = loopStart_;
+            adpcmPredictor_ = loopPredictor_;
+            adpcmStepIndex_ = loopStepIndex_;
+        } else {
+            seek(loopStart_);
+            loopPredictor_ = adpcmPredictor_;
+            loopStepIndex_ = adpcmStepIndex_;
+            loopStateValid_ = true;
+        }
+        return true;
+    }
+
+    const Audio::AudioFile* next = next_;
+    next_ = nullptr;
+    if (!next || !attach(next)) {
+        return false;
+    }
+    if (stream_) {
+        setStream(stream_);
+    }
+    return true;
+}
+
+size_t ClipReader::storedOffset(size_t sample) const {
+    switch (file_->codec) {
+        case Audio::AudioCodec::PCM16:
+            return sample * sizeof(int16_t);
+        case Audio::AudioCodec::MU_LAW:
+            return sample;
+        case Audio::AudioCodec::IMA_ADPCM:
+            return (sample / Audio::ADPCM_BLOCK_SAMPLES) * Audio::ADPCM_BLOCK_BYTES;
+    }
+    return 0;
+}
+
+std::atomic<uint32_t> ClipReader::s_decodeErrors{0};
+
+const uint8_t* ClipReader::fetch(size_t offset, size_t* available) {
+    if (stream_) {
+        return stream_->fetch(offset, available);
+    }
+    *available = offset < storedBytes_ ? storedBytes_ - offset : 0;
+    return stored_ + offset;
+}
+
+void ClipReader::failDecode() {
+    ++s_decodeErrors;
+    // Play on to a chained clip, if any, as at a normal end
+    endLoop();
+    position_ = file_->sample_count;
+}
+
+int16_t ClipReader::decodeMuLaw(uint8_t value) {
+    return MU_LAW_TABLE[value];
+}
+
+size_t ClipReader::read(int16_t* out, size_t count) {
+    size_t written = 0;
+    while (written < count && file_) {
+        if (position_ >= segmentEnd() && !continueAtEnd()) {
+            break;
+        }
+        const size_t run = std::min(count - written, segmentEnd() - position_);
+        const size_t decoded = decode(out + written, run);
+        written += decoded;
+        if (decoded < run) {
+            failDecode();
+        }
+    }
+    return written;
+}
+
+size_t ClipReader::skip(size_t count) {
+    size_t skipped = 0;
+    while (skipped < count && file_) {
+        if (position_ >= segmentEnd() && !continueAtEnd()) {
+            break;
+        }
+        const size_t run = std::min(count - skipped, segmentEnd() - position_);
+        seek(position_ + run);
+        skipped += run;
+    }
+    return skipped;
+}
+
+size_t ClipReader::decode(int16_t* out, size_t count) {
+    switch (file_->codec) {
+        case Audio::AudioCodec::PCM16:
+            return readPcm16(out, count);
+        case Audio::AudioCodec::MU_LAW:
+            return readMuLaw(out, count);
+        case Audio::AudioCodec::IMA_ADPCM:
+            return readAdpcm(out, count);
+    }
+    return 0;
+}
+
+void ClipReader::seek(size_t position) {
+    if (!file_) {
+        return;
+    }
+
+    position = std::min(position, file_->sample_count);
+    if (file_->codec != Audio::AudioCodec::IMA_ADPCM) {
+        position_ = position;
+        return;
+    }
+
+    // ADPCM state only exists at block starts; decode forward from there
+    position_ = (position / Audio::ADPCM_BLOCK_SAMPLES) * Audio::ADPCM_BLOCK_SAMPLES;
+    int16_t discard[32];
+    while (position_ < position) {
+        const size_t run = std::min(sizeof(discard) / sizeof(discard[0]), position - position_);
+        if (readAdpcm(discard, run) < run) {
+            failDecode();
+            return;
+        }
+    }
+}
+
+size_t ClipReader::readPcm16(int16_t* out, size_t count) {
+    size_t written = 0;
+    while (written < count) {
+        size_t available = 0;
+        const uint8_t* src = fetch(position_ * sizeof(int16_t), &available);
+        const size_t run = std::min(count - written, available / sizeof(int16_t));
+        if (run == 0) {
+            break;
+        }
+        memcpy(out + written, src, run * sizeof(int16_t));
+        written += run;
+        position_ += run;
+    }
+    return written;
+}
+
+size_t ClipReader::readMuLaw(int16_t* out, size_t count) {
+    size_t written = 0;
+    while (written < count) {
+        size_t available = 0;
+        const uint8_t* src = fetch(position_, &available);
+        const size_t run = std::min(count - written, available);
+        if (run == 0) {
+            break;
+        }
+        for (size_t i = 0; i < run; ++i) {
+            out[written + i] = MU_LAW_TABLE[src[i]];
+        }
+        written += run;
+        position_ += run;
+    }
+    return written;
+}
+
+size_t ClipReader::readAdpcm(int16_t* out, size_t count) {
+    size_t written = 0;
+
+    while (written < count) {
+        const size_t block = position_ / Audio::ADPCM_BLOCK_SAMPLES;
+        const size_t offset = position_ - block * Audio::ADPCM_BLOCK_SAMPLES;
+        // Stream windows are block aligned, so a block is always contiguous
+        size_t available = 0;
+        const uint8_t* blockData = fetch(block * Audio::ADPCM_BLOCK_BYTES, &available);
+        if (available < Audio::ADPCM_BLOCK_BYTES) {
+            break;
+        }
+
+        if (offset == 0) {
+            // Block header: first sample verbatim, then the step index
+            adpcmPredictor_ = static_cast<int16_t>(blockData[0] | (blockData[1] << 8));
+            adpcmStepIndex_ = std::min<int32_t>(blockData[2], ADPCM_MAX_STEP_INDEX);
+            out[written++] = static_cast<int16_t>(adpcmPredictor_);
+            ++position_;
+            continue;
+        }
+
+        const size_t run = std::min(count - written, Audio::ADPCM_BLOCK_SAMPLES - offset);
+        const uint8_t* nibbles = blockData + Audio::ADPCM_HEADER_BYTES;
+        int32_t predictor = adpcmPredictor_;
+        int32_t stepIndex = adpcmStepIndex_;
+
+        for (size_t i = 0; i < run; ++i) {
+            // Nibbles are packed low half first
+            const size_t k = offset - 1 + i;
+            const uint8_t byte = nibbles[k >> 1];
+            const uint8_t code = (k & 1) ? (byte >> 4) : (byte & 0x0F);
+
+            const int32_t step = ADPCM_STEP_TABLE[stepIndex];
+            int32_t diff = step >> 3;
+            if (code & 1) diff += step >> 2;
+            if (code & 2) diff += step >> 1;
+            if (code & 4) diff += step;
+            predictor += (code & 8) ? -diff : diff;
+            predictor = std::max<int32_t>(INT16_MIN, std::min<int32_t>(INT16_MAX, predictor));
+
+            stepIndex += ADPCM_INDEX_TABLE[code];
+            stepIndex = std::max<int32_t>(0, std::min(ADPCM_MAX_STEP_INDEX, stepIndex));
+
+            out[written + i] = static_cast<int16_t>(predictor);
+        }
+
+        adpcmPredictor_ = predictor;
+        adpcmStepIndex_ = stepIndex;
+        written += run;
+        position_ += run;
+    }
+
+    return written;
+}
+
+} // namespace Exterminate
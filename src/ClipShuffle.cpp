@@ -0,0 +1,127 @@
+#include "ClipShuffle.h"
+#include <algorithm>
+
+namespace Exterminate {
+
+ClipShuffle::ClipShuffle()
+    : table_{}
+    , tap_(0)
+    , order_{}
+    , start_{}
+    , count_{}
+    , dealt_{}
+    , clipCount_(0)
+    , last_(-1)
+{
+    seed(1);
+}
+
+void ClipShuffle::seed(uint32_t seed) {
+    // Fill the lag table from a 32-bit LCG; an odd entry keeps the
+    // generator's full period
+    uint32_t state = seed;
+    for (size_t i = 0; i < LONG_LAG; ++i) {
+        state = state * 1664525u + 1013904223u;
+        table_[i] = state;
+    }
+    table_[0] |= 1;
+    tap_ = 0;
+
+    // Discard the LCG's correlation
+    for (size_t i = 0; i < 4 * LONG_LAG; ++i) {
+        random();
+    }
+}
+
+uint32_t ClipShuffle::random() {
+    // x[n-55] sits at tap_, x[n-24] 31 entries later
+    size_t shortTap = tap_ + (LONG_LAG - SHORT_LAG);
+    if (shortTap >= LONG_LAG) {
+        shortTap -= LONG_LAG;
+    }
+    const uint32_t value = table_[tap_] + table_[shortTap];
+    table_[tap_] = value;
+    if (++tap_ == LONG_LAG) {
+        tap_ = 0;
+    }
+    return value;
+}
+
+uint32_t ClipShuffle::below(uint32_t bound) {
+    return static_cast<uint32_t>((static_cast<uint64_t>(random()) * bound) >> 32);
+}
+
+void ClipShuffle::configure(size_t clipCount) {
+    clipCount_ = clipCount;
+    last_ = -1;
+    const size_t dealt = std::min(clipCount, MAX_CLIPS);
+
+    // Counting sort of the clip indices by category
+    uint16_t fill[CATEGORY_COUNT] = {};
+    for (size_t i = 0; i < dealt; ++i) {
+        ++fill[static_cast<size_t>(Audio::getAudioCategory(i))];
+    }
+    uint16_t offset = 0;
+    for (size_t category = 0; category < CATEGORY_COUNT; ++category) {
+        start_[category] = offset;
+        count_[category] = fill[category];
+        offset += fill[category];
+        fill[category] = start_[category];
+    }
+    for (size_t i = 0; i < dealt; ++i) {
+        order_[fill[static_cast<size_t>(Audio::getAudioCategory(i))]++] = static_cast<uint8_t>(i);
+    }
+
+    for (size_t category = 0; category < CATEGORY_COUNT; ++category) {
+        shuffle(category);
+    }
+}
+
+void ClipShuffle::shuffle(size_t category) {
+    uint8_t* deck = order_ + start_[category];
+    const uint32_t count = count_[category];
+    for (uint32_t i = count; i > 1; --i) {
+        std::swap(deck[i - 1], deck[below(i)]);
+    }
+    // Keep the previous pick from leading the new pass
+    if (count > 1 && deck[0] == last_) {
+        std::swap(deck[0], deck[1 + below(count - 1)]);
+    }
+    dealt_[category] = 0;
+}
+
+bool ClipShuffle::next(Audio::AudioIndex* index) {
+    uint32_t total = 0;
+    for (size_t category = 0; category < CATEGORY_COUNT; ++category) {
+        if (count_[category] > 0) {
+            total += Audio::AUDIO_CATEGORY_WEIGHTS[category];
+        }
+    }
+    if (total == 0) {
+        return false;
+    }
+
+    // Weighted draw over the non-empty categories
+    uint32_t ticket = below(total);
+    size_t category = 0;
+    for (;; ++category) {
+        if (count_[category] == 0) {
+            continue;
+        }
+        const uint32_t weight = Audio::AUDIO_CATEGORY_WEIGHTS[category];
+        if (ticket < weight) {
+            break;
+        }
+        ticket -= weight;
+    }
+
+    if (dealt_[category] == count_[category]) {
+        shuffle(category);
+    }
+    const uint8_t clip = order_[start_[category] + dealt_[category]++];
+    last_ = clip;
+    *index = static_cast<Audio::AudioIndex>(clip);
+    return true;
+}
+
+} // namespace Exterminate
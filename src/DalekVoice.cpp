@@ -0,0 +1,55 @@
+#include "DalekVoice.h"
+#include <algorithm>
+
+namespace Exterminate {
+
+namespace {
+
+constexpr float DC_CORNER_HZ = 35.0f;
+constexpr float BUTTERWORTH_Q = 0.70710678f;
+
+// Chain stage order
+enum Stage : size_t {
+    DC_BLOCKER,
+    INPUT_GAIN,
+    RING_MODULATOR,
+    HIGH_PASS,
+    LOW_PASS,
+    LIMITER
+};
+
+} // namespace
+
+DalekVoice::DalekVoice()
+    : config_(Config::getDefault())
+{
+    configure(config_);
+}
+
+void DalekVoice::configure(const Config& config) {
+    config_ = config;
+    const uint32_t rate = std::max<uint32_t>(config.sampleRate, 1);
+
+    chain_.stage<DC_BLOCKER>().configure(DC_CORNER_HZ, rate);
+    chain_.stage<INPUT_GAIN>().configure(config.inputGain);
+    chain_.stage<RING_MODULATOR>().configure(config.ringHz, rate);
+    chain_.stage<HIGH_PASS>().configure({AudioDsp::Biquad::Type::HighPass, static_cast<float>(config.lowHz), BUTTERWORTH_Q, 0.0f}, rate);
+    chain_.stage<LOW_PASS>().configure({AudioDsp::Biquad::Type::LowPass, static_cast<float>(config.highHz), BUTTERWORTH_Q, 0.0f}, rate);
+    chain_.stage<LIMITER>().configure(config.ceiling, config.releaseMs, rate);
+
+    reset();
+}
+
+void DalekVoice::reset() {
+    chain_.reset();
+}
+
+void DalekVoice::process(const int16_t* in, int16_t* out, size_t count) {
+    chain_.process(in, out, count);
+}
+
+uint16_t DalekVoice::takeMinLimiterGain() {
+    return chain_.stage<LIMITER>().takeMinGain();
+}
+
+} // namespace Exterminate
@@ -0,0 +1,161 @@
+#include "DirectPlayback.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include <stdio.h>
+
+namespace Exterminate {
+
+namespace {
+
+// pico-extras audio_i2s completes its buffers on DMA_IRQ_0
+constexpr uint DIRECT_DMA_IRQ_INDEX = 1;
+constexpr uint DIRECT_DMA_IRQ = DMA_IRQ_1;
+
+} // namespace
+
+DirectPlayback* DirectPlayback::instance_ = nullptr;
+
+DirectPlayback::DirectPlayback()
+    : pio_(nullptr)
+    , sm_(0)
+    , dataChannel_(-1)
+    , controlChannel_(-1)
+    , onComplete_(nullptr)
+    , active_(false)
+    , blocks_{}
+{
+}
+
+DirectPlayback::~DirectPlayback() {
+    end();
+}
+
+bool DirectPlayback::canStream(const Audio::AudioFile* file) {
+    return file && file->codec == Audio::AudioCodec::PCM16 &&
+           file->data != nullptr && file->sample_count > 0;
+}
+
+bool DirectPlayback::begin(PIO pio, uint sm, CompletionCallback onComplete) {
+    if (dataChannel_ >= 0) {
+        return true;
+    }
+
+    int dataChannel = dma_claim_unused_channel(false);
+    int controlChannel = dma_claim_unused_channel(false);
+    if (dataChannel < 0 || controlChannel < 0) {
+        printf("DirectPlayback: ERROR - Need two free DMA channels\n");
+        if (dataChannel >= 0) dma_channel_unclaim(dataChannel);
+        if (controlChannel >= 0) dma_channel_unclaim(controlChannel);
+        return false;
+    }
+
+    pio_ = pio;
+    sm_ = sm;
+    dataChannel_ = dataChannel;
+    controlChannel_ = controlChannel;
+    onComplete_ = onComplete;
+    instance_ = this;
+
+    // Data channel: one sample per PIO TX request; the halfword write is
+    // replicated into both I2S slots. IRQ_QUIET limits the IRQ to the
+    // null trigger at the end of the block list.
+    dma_channel_config dataConfig = dma_channel_get_default_config(dataChannel_);
+    channel_config_set_transfer_data_size(&dataConfig, DMA_SIZE_16);
+    channel_config_set_read_increment(&dataConfig, true);
+    channel_config_set_write_increment(&dataConfig, false);
+    channel_config_set_dreq(&dataConfig, pio_get_dreq(pio_, sm_, true));
+    channel_config_set_chain_to(&dataConfig, controlChannel_);
+    channel_config_set_irq_quiet(&dataConfig, true);
+    dma_channel_configure(dataChannel_, &dataConfig, &pio_->txf[sm_], nullptr, 0, false);
+
+    // Control channel: copy one block into TRANS_COUNT / READ_ADDR_TRIG
+    // per run, wrapping the write address over those two registers
+    dma_channel_config controlConfig = dma_channel_get_default_config(controlChannel_);
+    channel_config_set_transfer_data_size(&controlConfig, DMA_SIZE_32);
+    channel_config_set_read_increment(&controlConfig, true);
+    channel_config_set_write_increment(&controlConfig, true);
+    channel_config_set_ring(&controlConfig, true, 3);
+    dma_channel_configure(controlChannel_, &controlConfig,
+                          &dma_hw->ch[dataChannel_].al3_transfer_count, blocks_, 2, false);
+
+    dma_irqn_set_channel_enabled(DIRECT_DMA_IRQ_INDEX, dataChannel_, true);
+    irq_add_shared_handler(DIRECT_DMA_IRQ, &DirectPlayback::dmaIrqHandler,
+                           PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(DIRECT_DMA_IRQ, true);
+
+    printf("DirectPlayback: Ready - data DMA %d, control DMA %d\n", dataChannel_, controlChannel_);
+    return true;
+}
+
+void DirectPlayback::end() {
+    if (dataChannel_ < 0) {
+        return;
+    }
+
+    stop();
+    dma_irqn_set_channel_enabled(DIRECT_DMA_IRQ_INDEX, dataChannel_, false);
+    irq_remove_handler(DIRECT_DMA_IRQ, &DirectPlayback::dmaIrqHandler);
+    dma_channel_unclaim(dataChannel_);
+    dma_channel_unclaim(controlChannel_);
+    dataChannel_ = -1;
+    controlChannel_ = -1;
+    instance_ = nullptr;
+}
+
+bool DirectPlayback::start(const Audio::AudioFile* const* files, size_t count) {
+    if (dataChannel_ < 0 || active_ || count == 0 || count > MAX_SEGMENTS) {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!canStream(files[i])) {
+            return false;
+        }
+        blocks_[i] = {static_cast<uint32_t>(files[i]->sample_count), files[i]->data};
+    }
+    blocks_[count] = {0, nullptr};
+
+    active_ = true;
+    dma_channel_set_read_addr(controlChannel_, blocks_, true);
+    pio_sm_set_enabled(pio_, sm_, true);
+    return true;
+}
+
+void DirectPlayback::stop() {
+    if (dataChannel_ < 0) {
+        return;
+    }
+
+    // Stop the reloader first so it cannot retrigger the data channel
+    dma_channel_abort(controlChannel_);
+    dma_channel_abort(dataChannel_);
+    dma_irqn_acknowledge_channel(DIRECT_DMA_IRQ_INDEX, dataChannel_);
+    active_ = false;
+}
+
+size_t DirectPlayback::peek(const int16_t** samples) const {
+    if (!active_ || dataChannel_ < 0) {
+        *samples = nullptr;
+        return 0;
+    }
+
+    const dma_channel_hw_t* channel = &dma_hw->ch[dataChannel_];
+    *samples = reinterpret_cast<const int16_t*>(channel->read_addr);
+    // Low 28 bits hold the count; the top bits select the trigger mode
+    return channel->transfer_count & 0x0FFFFFFFu;
+}
+
+void DirectPlayback::dmaIrqHandler() {
+    DirectPlayback* self = instance_;
+    if (!self || self->dataChannel_ < 0 ||
+        !dma_irqn_get_channel_status(DIRECT_DMA_IRQ_INDEX, self->dataChannel_)) {
+        return;
+    }
+
+    dma_irqn_acknowledge_channel(DIRECT_DMA_IRQ_INDEX, self->dataChannel_);
+    if (self->active_.exchange(false) && self->onComplete_) {
+        self->onComplete_();
+    }
+}
+
+} // namespace Exterminate
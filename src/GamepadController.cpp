@@ -408,6 +408,22 @@ void GamepadController::processTankSteering(const uni_gamepad_t* gp) {
     // Apply tank steering to motors
     m_motorController->setDifferentialDrive(normalizedThrottle, normalizedSteering);
     
+    // Motor hum: synthesised while driving, pitch rising with throttle
+    if (m_audioController && m_audioController->isInitialized()) {
+        // Only the hum's own note: a ZAP or another effect is left alone
+        static SynthEngine::NoteId humNote = SynthEngine::NO_NOTE;
+        bool driving = throttle != 0 || steering != 0;
+        // The hum ends by itself if a newer effect steals its voice
+        bool humming = m_audioController->isSynthPlaying(humNote);
+        if (driving && !humming) {
+            humNote = m_audioController->playSynth(SynthPatches::MOTOR_HUM, 0.5f);
+        } else if (!driving && humming) {
+            m_audioController->releaseSynth(humNote);
+            humNote = SynthEngine::NO_NOTE;
+        }
+        m_audioController->setSynthPitch(humNote, 1.0f + std::fabs(normalizedThrottle));
+    }
+    
     // Optional: Log motor commands when there's significant input
     if (abs(throttle) > DEADZONE || abs(steering) > DEADZONE) {
         printf("TankSteering: Raw(X=%d,Y=%d) -> Throttle=%.2f Steering=%.2f\n", 
@@ -450,6 +466,50 @@ void GamepadController::processAudioControls(const uni_gamepad_t* gp) {
     
     // Update previous button state
     previousAButton = currentAButton;
+    
+    // B button fires a synthesised zap
+    static bool previousBButton = false;
+    bool currentBButton = (gp->buttons & BUTTON_B) != 0;
+    if (currentBButton && !previousBButton) {
+        printf("B button pressed - zap!\n");
+        m_audioController->playSynth(SynthPatches::ZAP);
+    }
+    previousBButton = currentBButton;
+    
+    // X button toggles the live microphone through the Dalek voice
+    static bool previousXButton = false;
+    bool currentXButton = (gp->buttons & BUTTON_X) != 0;
+    if (currentXButton && !previousXButton) {
+        if (m_audioController->isDalekVoiceActive()) {
+            printf("X button pressed - Dalek voice off\n");
+            m_audioController->stopDalekVoice();
+        } else {
+            printf("X button pressed - Dalek voice on\n");
+            m_audioController->startDalekVoice();
+        }
+    }
+    previousXButton = currentXButton;
+
+    // Analog triggers bend speech pitch every update: R2 up to an octave
+    // higher, L2 down to an octave lower, both held cancel out
+    static constexpr int32_t TRIGGER_MAX = 1023;
+    static constexpr int32_t TRIGGER_DEADZONE = 10;
+    int32_t bend = static_cast<int32_t>(gp->throttle) - static_cast<int32_t>(gp->brake);
+    if (abs(bend) <= TRIGGER_DEADZONE) {
+        bend = 0;
+    }
+    m_audioController->setSpeechPitch(std::exp2(static_cast<float>(bend) / TRIGGER_MAX));
+
+    // SELECT dumps the audio pipeline and motor control loop stats
+    static bool previousSelectButton = false;
+    bool currentSelectButton = (gp->misc_buttons & MISC_BUTTON_SELECT) != 0;
+    if (currentSelectButton && !previousSelectButton) {
+        m_audioController->dumpStats();
+        if (m_motorController) {
+            m_motorController->dumpControlStats();
+        }
+    }
+    previousSelectButton = currentSelectButton;
 }
 
 void GamepadController::processMosfetControls(const uni_gamepad_t* gp) {
@@ -0,0 +1,150 @@
+#include "MicCapture.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include <algorithm>
+#include <stdio.h>
+
+namespace Exterminate {
+
+namespace {
+
+constexpr uint RING_BITS = 11;   // log2 of the ring size in bytes
+constexpr size_t RING_BYTES = size_t(1) << RING_BITS;
+static_assert(MicCapture::RING_SAMPLES * sizeof(uint16_t) == RING_BYTES, "DMA ring size");
+
+// The DMA write ring wraps on address bits, so the ring must be aligned to its size
+alignas(RING_BYTES) uint16_t s_ring[MicCapture::RING_SAMPLES];
+
+// The ADC runs from the 48 MHz USB PLL, one conversion every 96 cycles at least
+constexpr uint32_t ADC_CLOCK_HZ = 48000000;
+constexpr uint32_t ADC_MIN_CYCLES = 96;
+
+inline int16_t toPcm16(uint16_t raw) {
+    // 12-bit unsigned around mid-scale to signed 16-bit
+    return static_cast<int16_t>((static_cast<int32_t>(raw & 0x0FFFu) - 2048) << 4);
+}
+
+} // namespace
+
+MicCapture::MicCapture()
+    : channel_(-1)
+    , adcInput_(0)
+    , readIndex_(0)
+    , overruns_(0)
+{
+}
+
+MicCapture::~MicCapture() {
+    end();
+}
+
+bool MicCapture::begin(uint8_t gpio, uint32_t sampleRate) {
+    if (channel_ >= 0) {
+        return true;
+    }
+
+    if (gpio < ADC_BASE_PIN || gpio >= ADC_BASE_PIN + NUM_ADC_CHANNELS - 1) {
+        // The last channel is the internal temperature sensor
+        printf("MicCapture: ERROR - GPIO %u has no ADC input\n", gpio);
+        return false;
+    }
+    if (sampleRate == 0 || sampleRate > ADC_CLOCK_HZ / ADC_MIN_CYCLES) {
+        printf("MicCapture: ERROR - %u Hz is outside the ADC range\n", static_cast<unsigned>(sampleRate));
+        return false;
+    }
+
+    const int channel = dma_claim_unused_channel(false);
+    if (channel < 0) {
+        printf("MicCapture: ERROR - No free DMA channel\n");
+        return false;
+    }
+
+    adcInput_ = static_cast<uint8_t>(gpio - ADC_BASE_PIN);
+    adc_init();
+    adc_gpio_init(gpio);
+    adc_select_input(adcInput_);
+    // FIFO with DREQ at one sample; 16-bit results, no error flag
+    adc_fifo_setup(true, true, 1, false, false);
+    adc_set_clkdiv(static_cast<float>(ADC_CLOCK_HZ) / sampleRate - 1.0f);
+    adc_fifo_drain();
+
+    dma_channel_config config = dma_channel_get_default_config(channel);
+    channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+    channel_config_set_read_increment(&config, false);
+    channel_config_set_write_increment(&config, true);
+    channel_config_set_ring(&config, true, RING_BITS);
+    channel_config_set_dreq(&config, DREQ_ADC);
+    dma_channel_configure(channel, &config, s_ring, &adc_hw->fifo,
+                          dma_encode_endless_transfer_count(), true);
+
+    // Published last: the reader treats channel_ >= 0 as a running ring
+    readIndex_ = 0;
+    overruns_ = 0;
+    channel_ = channel;
+    adc_run(true);
+
+    printf("MicCapture: ADC%u (GPIO %u) at %u Hz into a %u-sample ring on DMA %d\n",
+           adcInput_, gpio, static_cast<unsigned>(sampleRate),
+           static_cast<unsigned>(RING_SAMPLES), channel);
+    return true;
+}
+
+void MicCapture::end() {
+    if (channel_ < 0) {
+        return;
+    }
+
+    const int channel = channel_;
+    channel_ = -1;
+    adc_run(false);
+    dma_channel_abort(channel);
+    dma_channel_unclaim(channel);
+    adc_fifo_drain();
+}
+
+uint32_t MicCapture::writeIndex(int channel) const {
+    // Only the ring position is known from the write address; combine it
+    // with the reader's lap so the difference is the unread count
+    const uintptr_t address = dma_hw->ch[channel].write_addr;
+    const uint32_t slot = static_cast<uint32_t>((address - reinterpret_cast<uintptr_t>(s_ring)) / sizeof(uint16_t));
+    const uint32_t lap = readIndex_ & ~static_cast<uint32_t>(RING_SAMPLES - 1);
+    uint32_t index = lap | (slot & (RING_SAMPLES - 1));
+    if (index < readIndex_) {
+        index += RING_SAMPLES;
+    }
+    return index;
+}
+
+size_t MicCapture::available() {
+    // end() may run between the check and the register read
+    const int channel = channel_;
+    if (channel < 0) {
+        return 0;
+    }
+
+    // A full lap is indistinguishable from an empty ring, so treat a
+    // nearly full one as overrun and keep the newest half
+    size_t unread = writeIndex(channel) - readIndex_;
+    if (unread > RING_SAMPLES - RING_SAMPLES / 8) {
+        ++overruns_;
+        readIndex_ += static_cast<uint32_t>(unread - RING_SAMPLES / 2);
+        unread = RING_SAMPLES / 2;
+    }
+    return unread;
+}
+
+size_t MicCapture::read(int16_t* out, size_t count) {
+    count = std::min(count, available());
+    for (size_t i = 0; i < count; ++i) {
+        out[i] = toPcm16(s_ring[(readIndex_ + i) & (RING_SAMPLES - 1)]);
+    }
+    readIndex_ += static_cast<uint32_t>(count);
+    return count;
+}
+
+void MicCapture::skip(size_t count) {
+    readIndex_ += static_cast<uint32_t>(std::min(count, available()));
+}
+
+} // namespace Exterminate
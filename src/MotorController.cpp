@@ -1,10 +1,20 @@
 #include "MotorController.h"
+#include "CycleCounter.h"
+#include "hardware/clocks.h"
 #include <algorithm>
 #include <cmath>
 #include <cstdio>
 
 namespace Exterminate {
 
+namespace {
+
+constexpr float SPEED_SCALE = 32767.0f;     // Q15 packing of speeds and targets
+constexpr uint32_t MIN_CONTROL_RATE_HZ = 50;
+constexpr uint32_t MAX_CONTROL_RATE_HZ = 5000;
+
+} // namespace
+
 MotorController::MotorController(const Config& config)
     : config_(config)
     , initialized_(false)
@@ -14,6 +24,24 @@ MotorController::MotorController(const Config& config)
     , leftPwmChannelB_(0)
     , rightPwmChannelA_(0)
     , rightPwmChannelB_(0)
+    , pwmWrap_(65535)
+    , controlTimer_{}
+    , controlLoopActive_(false)
+    , controlPeriodUs_(0)
+    , controlPeriodS_(0.0f)
+    , targets_(0)
+    , stopRequested_(false)
+    , speed_{}
+    , acceleration_{}
+    , outputs_(0)
+    , lastTickUs_(0)
+    , ticks_(0)
+    , lastJitterUs_(0)
+    , jitterSumUs_(0)
+    , peakJitterUs_(0)
+    , lateTicks_(0)
+    , slewTicks_(0)
+    , peakTickCycles_(0)
 {
     // Constructor only stores configuration - actual initialization happens in initialize()
 }
@@ -21,6 +49,10 @@ MotorController::MotorController(const Config& config)
 MotorController::~MotorController()
 {
     if (initialized_) {
+        if (controlLoopActive_) {
+            cancel_repeating_timer(&controlTimer_);
+            controlLoopActive_ = false;
+        }
         stopAllMotors();
         
         // Disable PWM slices
@@ -73,13 +105,14 @@ bool MotorController::initialize()
 
     // Set PWM to requested frequency: f = sys_clk / (clkdiv * (wrap + 1))
     // Prefer clkdiv = 1 for maximum resolution and compute wrap accordingly
-    constexpr uint32_t sys_clk_hz = 125000000; // 125 MHz default
+    const uint32_t sys_clk_hz = clock_get_hz(clk_sys);
     uint32_t target = config_.pwmFrequency == 0 ? 20000 : config_.pwmFrequency; // default 20kHz
     if (target < 100) target = 100; // avoid extremely low frequencies
     uint32_t wrap = (sys_clk_hz / target);
     if (wrap == 0) wrap = 1;
     if (wrap > 0) wrap -= 1;
     if (wrap > 65535u) wrap = 65535u;
+    pwmWrap_ = static_cast<uint16_t>(wrap);
 
         printf("DEBUG: PWM setup - Target freq: %uHz, Wrap: %u\n", target, wrap);
 
@@ -97,6 +130,9 @@ bool MotorController::initialize()
         stopAllMotors();
 
         initialized_ = true;
+        if (config_.controlRateHz > 0 && !startControlLoop()) {
+            printf("MotorController: No alarm slots available - applying commands directly\n");
+        }
         printf("DEBUG: MotorController initialization successful!\n");
         return true;
     }
@@ -120,43 +156,39 @@ void MotorController::setMotorSpeed(Motor motor, float speed)
     // Constrain speed to valid range
     speed = constrain(speed, -1.0f, 1.0f);
 
-    uint8_t pin1, pin2;
-    
-    if (motor == Motor::LEFT) {
-        pin1 = config_.leftMotorPin1;
-        pin2 = config_.leftMotorPin2;
-        printf("DEBUG: Left motor pins - Pin1=%u (GPIO%u), Pin2=%u (GPIO%u)\n", pin1, pin1, pin2, pin2);
-    } else {
-        pin1 = config_.rightMotorPin1;
-        pin2 = config_.rightMotorPin2;
-        printf("DEBUG: Right motor pins - Pin1=%u (GPIO%u), Pin2=%u (GPIO%u)\n", pin1, pin1, pin2, pin2);
+    if (controlLoopActive_) {
+        storeSpeed(targets_, motor, speed);
+        return;
     }
+    storeSpeed(outputs_, motor, speed);
+    applyMotorSpeed(motor, speed);
+}
+
+void MotorController::applyMotorSpeed(Motor motor, float speed)
+{
+    const uint8_t pin1 = motor == Motor::LEFT ? config_.leftMotorPin1 : config_.rightMotorPin1;
+    const uint8_t pin2 = motor == Motor::LEFT ? config_.leftMotorPin2 : config_.rightMotorPin2;
 
     if (speed > 0.0f) {
         // Forward direction (now both motors use what was previously 'reverse' logic)
         if (motor == Motor::LEFT) {
-            printf("DEBUG: Motor forward (LEFT now reverse logic) - GPIO%u=%.3f, GPIO%u=0.0\n", pin1, speed, pin2);
             setPwmDutyCycle(pin1, speed);
             setPwmDutyCycle(pin2, 0.0f);
         } else {
-            printf("DEBUG: Motor forward (RIGHT now reverse logic) - GPIO%u=0.0, GPIO%u=%.3f\n", pin1, pin2, speed);
             setPwmDutyCycle(pin1, 0.0f);
             setPwmDutyCycle(pin2, speed);
         }
     } else if (speed < 0.0f) {
         // Reverse direction (now both motors use what was previously 'forward' logic)
         if (motor == Motor::LEFT) {
-            printf("DEBUG: Motor reverse (LEFT now forward logic) - GPIO%u=0.0, GPIO%u=%.3f\n", pin1, pin2, -speed);
             setPwmDutyCycle(pin1, 0.0f);
             setPwmDutyCycle(pin2, -speed);
         } else {
-            printf("DEBUG: Motor reverse (RIGHT now forward logic) - GPIO%u=%.3f, GPIO%u=0.0\n", pin1, -speed, pin2);
             setPwmDutyCycle(pin1, -speed);
             setPwmDutyCycle(pin2, 0.0f);
         }
     } else {
-        // Stop (brake)
-        printf("DEBUG: Motor stop - GPIO%u=0.0, GPIO%u=0.0\n", pin1, pin2);
+        // Stop (coast)
         setPwmDutyCycle(pin1, 0.0f);
         setPwmDutyCycle(pin2, 0.0f);
     }
@@ -194,7 +226,11 @@ void MotorController::setDifferentialDrive(float forward, float turn)
     // Debug: Log calculated motor speeds
     printf("DEBUG: Motor speeds - Left=%.3f, Right=%.3f\n", leftSpeed, rightSpeed);
 
-    // Set motor speeds
+    // Hand both targets to the control loop at once, or set the motors now
+    if (controlLoopActive_) {
+        targets_ = packSpeeds(leftSpeed, rightSpeed);
+        return;
+    }
     setMotorSpeed(Motor::LEFT, leftSpeed);
     setMotorSpeed(Motor::RIGHT, rightSpeed);
 }
@@ -205,8 +241,197 @@ void MotorController::stopAllMotors()
         return;
     }
 
-    setMotorSpeed(Motor::LEFT, 0.0f);
-    setMotorSpeed(Motor::RIGHT, 0.0f);
+    // The tick that runs next drops its ramp state instead of resuming it
+    targets_ = packSpeeds(0.0f, 0.0f);
+    stopRequested_ = true;
+    outputs_ = packSpeeds(0.0f, 0.0f);
+    applyMotorSpeed(Motor::LEFT, 0.0f);
+    applyMotorSpeed(Motor::RIGHT, 0.0f);
+}
+
+float MotorController::getMotorSpeed(Motor motor) const
+{
+    return unpackSpeed(outputs_.load(), motor);
+}
+
+bool MotorController::startControlLoop()
+{
+    const uint32_t rate = std::max(MIN_CONTROL_RATE_HZ, std::min(config_.controlRateHz, MAX_CONTROL_RATE_HZ));
+    const uint32_t periodUs = (1000000u + rate / 2) / rate;
+    controlPeriodUs_ = periodUs;
+    controlPeriodS_ = static_cast<float>(periodUs) * 1e-6f;
+    CycleCounter::enable();
+    resetControlStats();
+
+    // A negative delay schedules each tick from the previous one's due time, not its end
+    controlLoopActive_ = add_repeating_timer_us(-static_cast<int64_t>(periodUs),
+                                                &MotorController::controlTimerCallback, this, &controlTimer_);
+    if (controlLoopActive_) {
+        printf("MotorController: Control loop at %u Hz, acceleration %.1f/s, jerk %.1f/s^2\n",
+               1000000u / periodUs, config_.maxAcceleration, config_.maxJerk);
+    }
+    return controlLoopActive_;
+}
+
+bool MotorController::controlTimerCallback(repeating_timer_t* timer)
+{
+    static_cast<MotorController*>(timer->user_data)->controlTick();
+    return true;
+}
+
+void MotorController::controlTick()
+{
+    const uint32_t startCycles = CycleCounter::now();
+    const uint32_t now = time_us_32();
+
+    // Jitter of the interval since the previous tick
+    const uint32_t periodUs = controlPeriodUs_;
+    const uint32_t ticks = ticks_.load();
+    if (ticks > 0) {
+        const uint32_t interval = now - lastTickUs_;
+        const uint32_t jitter = interval > periodUs ? interval - periodUs : periodUs - interval;
+        lastJitterUs_ = jitter;
+        jitterSumUs_ += jitter;
+        if (jitter > peakJitterUs_.load()) {
+            peakJitterUs_ = jitter;
+        }
+        if (interval >= 2 * periodUs) {
+            ++lateTicks_;
+        }
+    }
+    lastTickUs_ = now;
+    ticks_ = ticks + 1;
+
+    if (stopRequested_.exchange(false)) {
+        speed_[0] = speed_[1] = 0.0f;
+        acceleration_[0] = acceleration_[1] = 0.0f;
+    }
+
+    const uint32_t targets = targets_.load();
+    const float left = unpackSpeed(targets, Motor::LEFT);
+    const float right = unpackSpeed(targets, Motor::RIGHT);
+    slew(0, left);
+    slew(1, right);
+    if (speed_[0] != left || speed_[1] != right) {
+        ++slewTicks_;
+    }
+
+    // Only touch the PWM when a level can have changed
+    const uint32_t outputs = packSpeeds(speed_[0], speed_[1]);
+    if (outputs != outputs_.load()) {
+        outputs_ = outputs;
+        applyMotorSpeed(Motor::LEFT, speed_[0]);
+        applyMotorSpeed(Motor::RIGHT, speed_[1]);
+    }
+
+    const uint32_t cycles = CycleCounter::now() - startCycles;
+    if (cycles > peakTickCycles_.load()) {
+        peakTickCycles_ = cycles;
+    }
+}
+
+void MotorController::slew(size_t motor, float target)
+{
+    float& speed = speed_[motor];
+    float& acceleration = acceleration_[motor];
+    const float maxAcceleration = config_.maxAcceleration;
+    const float maxJerk = config_.maxJerk;
+
+    const float error = target - speed;
+    if (maxAcceleration <= 0.0f || (error == 0.0f && acceleration == 0.0f)) {
+        speed = target;
+        acceleration = 0.0f;
+        return;
+    }
+
+    // Head for full acceleration, easing off in time to arrive with none:
+    // ramping it down at maxJerk covers a^2 / (2 * maxJerk) of speed
+    float desired = std::copysign(maxAcceleration, error);
+    if (maxJerk > 0.0f) {
+        const float arriving = std::sqrt(2.0f * maxJerk * std::fabs(error));
+        if (arriving < maxAcceleration) {
+            desired = std::copysign(arriving, error);
+        }
+        const float step = maxJerk * controlPeriodS_;
+        acceleration += constrain(desired - acceleration, -step, step);
+    } else {
+        acceleration = desired;
+    }
+
+    // Land on the target rather than oscillate around it
+    const float next = speed + acceleration * controlPeriodS_;
+    if ((target - next) * error <= 0.0f) {
+        speed = target;
+        acceleration = 0.0f;
+    } else {
+        speed = constrain(next, -1.0f, 1.0f);
+    }
+}
+
+MotorController::ControlStats MotorController::getControlStats() const
+{
+    const uint32_t ticks = ticks_.load();
+    return ControlStats{
+        ticks,
+        controlLoopActive_ ? controlPeriodUs_ : 0,
+        lastJitterUs_.load(),
+        ticks > 1 ? jitterSumUs_.load() / (ticks - 1) : 0,
+        peakJitterUs_.load(),
+        lateTicks_.load(),
+        slewTicks_.load(),
+        peakTickCycles_.load()
+    };
+}
+
+void MotorController::resetControlStats()
+{
+    ticks_ = 0;
+    lastJitterUs_ = 0;
+    jitterSumUs_ = 0;
+    peakJitterUs_ = 0;
+    lateTicks_ = 0;
+    slewTicks_ = 0;
+    peakTickCycles_ = 0;
+}
+
+void MotorController::dumpControlStats() const
+{
+    const ControlStats stats = getControlStats();
+    if (stats.periodUs == 0) {
+        printf("MotorController: Control loop not running - commands applied directly\n");
+        return;
+    }
+    printf("MotorController: Control loop - %u us period, %u ticks\n", stats.periodUs, stats.ticks);
+    printf("MotorController:   jitter       : last %u us, avg %u us, peak %u us, %u late ticks\n",
+           stats.lastJitterUs, stats.avgJitterUs, stats.peakJitterUs, stats.lateTicks);
+    printf("MotorController:   slew         : %u ticks ramping, peak tick %u cycles\n",
+           stats.slewTicks, stats.peakTickCycles);
+    printf("MotorController:   speed        : left %.3f, right %.3f\n",
+           getMotorSpeed(Motor::LEFT), getMotorSpeed(Motor::RIGHT));
+}
+
+uint32_t MotorController::packSpeeds(float left, float right)
+{
+    const auto q15 = [](float speed) {
+        return static_cast<uint16_t>(static_cast<int16_t>(std::lround(constrain(speed, -1.0f, 1.0f) * SPEED_SCALE)));
+    };
+    return q15(left) | (static_cast<uint32_t>(q15(right)) << 16);
+}
+
+float MotorController::unpackSpeed(uint32_t packed, Motor motor)
+{
+    const uint16_t half = static_cast<uint16_t>(motor == Motor::LEFT ? packed : packed >> 16);
+    return static_cast<int16_t>(half) / SPEED_SCALE;
+}
+
+void MotorController::storeSpeed(std::atomic<uint32_t>& packed, Motor motor, float speed)
+{
+    uint32_t current = packed.load();
+    uint32_t next;
+    do {
+        next = motor == Motor::LEFT ? packSpeeds(speed, unpackSpeed(current, Motor::RIGHT))
+                                    : packSpeeds(unpackSpeed(current, Motor::LEFT), speed);
+    } while (!packed.compare_exchange_weak(current, next));
 }
 
 uint8_t MotorController::configurePwmPin(uint8_t pin)
@@ -230,19 +455,14 @@ uint8_t MotorController::configurePwmPin(uint8_t pin)
 
 void MotorController::setPwmDutyCycle(uint8_t pin, float dutyCycle)
 {
-    // Debug: Log PWM commands
-    printf("DEBUG: setPwmDutyCycle - GPIO%u, DutyCycle=%.3f", pin, dutyCycle);
-    
     // Constrain duty cycle
     dutyCycle = constrain(dutyCycle, 0.0f, 1.0f);
     
-    // Calculate PWM level (0-65535)
-    uint16_t level = static_cast<uint16_t>(dutyCycle * 65535);
-    
-    printf(" -> PWM Level=%u\n", level);
+    // Calculate PWM level (0 to wrap + 1, where wrap + 1 holds the pin high)
+    uint32_t level = static_cast<uint32_t>(dutyCycle * (pwmWrap_ + 1u) + 0.5f);
     
-    // Set PWM level
-    pwm_set_gpio_level(pin, level);
+    // Set PWM level; no logging, this runs in the control loop's IRQ
+    pwm_set_gpio_level(pin, static_cast<uint16_t>(std::min<uint32_t>(level, 65535u)));
 }
 
 float MotorController::constrain(float value, float min, float max)
@@ -0,0 +1,248 @@
+#include "PsramAllocator.h"
+#include "pico/stdlib.h"
+#include "hardware/clocks.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+#include "hardware/structs/qmi.h"
+#include "hardware/structs/xip_ctrl.h"
+#include <stdio.h>
+
+namespace Exterminate {
+
+namespace {
+
+// QMI window 1 sits 16 MB into each XIP alias; the uncached one bypasses the XIP cache
+constexpr uintptr_t PSRAM_WINDOW_OFFSET = 0x01000000u;
+constexpr uintptr_t PSRAM_NOCACHE_BASE = XIP_NOCACHE_NOALLOC_BASE + PSRAM_WINDOW_OFFSET;
+
+// APS6404 commands
+constexpr uint8_t CMD_READ_ID = 0x9F;
+constexpr uint8_t CMD_RESET_ENABLE = 0x66;
+constexpr uint8_t CMD_RESET = 0x99;
+constexpr uint8_t CMD_ENTER_QPI = 0x35;
+constexpr uint8_t CMD_EXIT_QPI = 0xF5;
+constexpr uint8_t CMD_QPI_FAST_READ = 0xEB;
+constexpr uint8_t CMD_QPI_WRITE = 0x38;
+constexpr uint8_t KNOWN_GOOD_DIE = 0x5D;
+
+constexpr uint32_t PSRAM_MAX_HZ = 133000000;
+
+inline void waitDirectIdle() {
+    while (qmi_hw->direct_csr & QMI_DIRECT_CSR_BUSY_BITS) {
+    }
+}
+
+} // namespace
+
+PsramAllocator::PsramAllocator()
+    : base_(nullptr)
+    , capacity_(0)
+    , used_(0)
+    , blocks_{}
+    , blockCount_(0)
+{
+}
+
+bool PsramAllocator::begin() {
+    if (capacity_ > 0) {
+        return true;
+    }
+
+    const size_t size = setupHardware();
+    if (size == 0) {
+        printf("PsramAllocator: No PSRAM found on GPIO %u\n", PSRAM_CS_PIN);
+        return false;
+    }
+
+    base_ = reinterpret_cast<uint8_t*>(PSRAM_NOCACHE_BASE);
+    capacity_ = size;
+    used_ = 0;
+    blocks_[0] = {0, static_cast<uint32_t>(size), false};
+    blockCount_ = 1;
+
+    printf("PsramAllocator: %u KB PSRAM mapped at 0x%08lx\n",
+           static_cast<unsigned>(size / 1024), (unsigned long)PSRAM_NOCACHE_BASE);
+    return true;
+}
+
+void* PsramAllocator::allocate(size_t bytes) {
+    if (bytes == 0 || capacity_ == 0) {
+        return nullptr;
+    }
+    const uint32_t size = static_cast<uint32_t>((bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1));
+
+    for (size_t i = 0; i < blockCount_; ++i) {
+        Block& block = blocks_[i];
+        if (block.used || block.size < size) {
+            continue;
+        }
+
+        // Split off the remainder when there is room to track it
+        if (block.size > size && blockCount_ < MAX_BLOCKS) {
+            for (size_t j = blockCount_; j > i + 1; --j) {
+                blocks_[j] = blocks_[j - 1];
+            }
+            blocks_[i + 1] = {block.offset + size, block.size - size, false};
+            block.size = size;
+            ++blockCount_;
+        }
+
+        block.used = true;
+        used_ += block.size;
+        return base_ + block.offset;
+    }
+    return nullptr;
+}
+
+void PsramAllocator::free(void* pointer) {
+    if (!pointer || capacity_ == 0) {
+        return;
+    }
+    const uint32_t offset = static_cast<uint32_t>(static_cast<uint8_t*>(pointer) - base_);
+
+    for (size_t i = 0; i < blockCount_; ++i) {
+        if (blocks_[i].offset != offset || !blocks_[i].used) {
+            continue;
+        }
+
+        blocks_[i].used = false;
+        used_ -= blocks_[i].size;
+
+        // Merge with the following, then the preceding free block
+        if (i + 1 < blockCount_ && !blocks_[i + 1].used) {
+            blocks_[i].size += blocks_[i + 1].size;
+            removeBlock(i + 1);
+        }
+        if (i > 0 && !blocks_[i - 1].used) {
+            blocks_[i - 1].size += blocks_[i].size;
+            removeBlock(i);
+        }
+        return;
+    }
+    printf("PsramAllocator: ERROR - free of unknown block %p\n", pointer);
+}
+
+size_t PsramAllocator::largestFreeBlock() const {
+    size_t largest = 0;
+    for (size_t i = 0; i < blockCount_; ++i) {
+        if (!blocks_[i].used && blocks_[i].size > largest) {
+            largest = blocks_[i].size;
+        }
+    }
+    return largest;
+}
+
+void PsramAllocator::removeBlock(size_t index) {
+    for (size_t i = index; i + 1 < blockCount_; ++i) {
+        blocks_[i] = blocks_[i + 1];
+    }
+    --blockCount_;
+}
+
+// Runs from SRAM: flash XIP is unavailable while QMI is in direct mode
+size_t __no_inline_not_in_flash_func(PsramAllocator::setupHardware)() {
+    gpio_set_function(PSRAM_CS_PIN, GPIO_FUNC_XIP_CS1);
+
+    const uint32_t interrupts = save_and_disable_interrupts();
+
+    // Leave QPI in case a previous boot enabled it, then read the ID in SPI mode
+    qmi_hw->direct_csr = 10 << QMI_DIRECT_CSR_CLKDIV_LSB | QMI_DIRECT_CSR_EN_BITS |
+                         QMI_DIRECT_CSR_AUTO_CS1N_BITS;
+    waitDirectIdle();
+    qmi_hw->direct_tx = QMI_DIRECT_TX_OE_BITS | QMI_DIRECT_TX_IWIDTH_VALUE_Q << QMI_DIRECT_TX_IWIDTH_LSB |
+                        CMD_EXIT_QPI;
+    waitDirectIdle();
+    (void)qmi_hw->direct_rx;
+    qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_AUTO_CS1N_BITS;
+
+    // 0x9F, three address bytes, manufacturer ID, known-good-die, density
+    qmi_hw->direct_csr |= QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+    uint8_t knownGoodDie = 0;
+    uint8_t density = 0;
+    for (int i = 0; i < 7; ++i) {
+        qmi_hw->direct_tx = (i == 0) ? CMD_READ_ID : 0xFF;
+        while ((qmi_hw->direct_csr & QMI_DIRECT_CSR_TXEMPTY_BITS) == 0) {
+        }
+        waitDirectIdle();
+        const uint8_t value = static_cast<uint8_t>(qmi_hw->direct_rx);
+        if (i == 5) {
+            knownGoodDie = value;
+        } else if (i == 6) {
+            density = value;
+        }
+    }
+    qmi_hw->direct_csr &= ~(QMI_DIRECT_CSR_ASSERT_CS1N_BITS | QMI_DIRECT_CSR_EN_BITS);
+
+    if (knownGoodDie != KNOWN_GOOD_DIE) {
+        restore_interrupts(interrupts);
+        return 0;
+    }
+
+    size_t size = 2u * 1024 * 1024;
+    const uint8_t densityId = density >> 5;
+    if (density == 0x26 || densityId == 2) {
+        size = 8u * 1024 * 1024;
+    } else if (densityId == 1) {
+        size = 4u * 1024 * 1024;
+    }
+
+    // Reset, then enter QPI mode
+    qmi_hw->direct_csr = 30 << QMI_DIRECT_CSR_CLKDIV_LSB | QMI_DIRECT_CSR_EN_BITS;
+    waitDirectIdle();
+    const uint8_t sequence[] = {CMD_RESET_ENABLE, CMD_RESET, CMD_ENTER_QPI};
+    for (uint8_t command : sequence) {
+        qmi_hw->direct_csr |= QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+        qmi_hw->direct_tx = command;
+        waitDirectIdle();
+        qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_ASSERT_CS1N_BITS;
+        busy_wait_at_least_cycles(20);
+        (void)qmi_hw->direct_rx;
+    }
+    qmi_hw->direct_csr &= ~QMI_DIRECT_CSR_EN_BITS;
+
+    // Window 1 timing: stay under 133 MHz, respect the 8 us CE# low limit
+    // (tCEM, in units of 64 system clocks) and the 18 ns deselect time
+    const uint32_t sysHz = clock_get_hz(clk_sys);
+    uint32_t divisor = (sysHz + PSRAM_MAX_HZ - 1) / PSRAM_MAX_HZ;
+    if (divisor == 1 && sysHz > 100000000) {
+        divisor = 2;
+    }
+    uint32_t rxDelay = divisor;
+    if (sysHz / divisor > 100000000) {
+        rxDelay += 1;
+    }
+    const uint64_t periodFs = 1000000000000000ull / sysHz;
+    const uint32_t maxSelect = static_cast<uint32_t>(125000000ull / periodFs);
+    const uint32_t minDeselect = static_cast<uint32_t>((18000000ull + periodFs - 1) / periodFs) -
+                                 (divisor + 1) / 2;
+
+    qmi_hw->m[1].timing = 1 << QMI_M1_TIMING_COOLDOWN_LSB |
+                          QMI_M1_TIMING_PAGEBREAK_VALUE_1024 << QMI_M1_TIMING_PAGEBREAK_LSB |
+                          maxSelect << QMI_M1_TIMING_MAX_SELECT_LSB |
+                          minDeselect << QMI_M1_TIMING_MIN_DESELECT_LSB |
+                          rxDelay << QMI_M1_TIMING_RXDELAY_LSB |
+                          divisor << QMI_M1_TIMING_CLKDIV_LSB;
+    qmi_hw->m[1].rfmt = QMI_M1_RFMT_PREFIX_WIDTH_VALUE_Q << QMI_M1_RFMT_PREFIX_WIDTH_LSB |
+                        QMI_M1_RFMT_ADDR_WIDTH_VALUE_Q << QMI_M1_RFMT_ADDR_WIDTH_LSB |
+                        QMI_M1_RFMT_SUFFIX_WIDTH_VALUE_Q << QMI_M1_RFMT_SUFFIX_WIDTH_LSB |
+                        QMI_M1_RFMT_DUMMY_WIDTH_VALUE_Q << QMI_M1_RFMT_DUMMY_WIDTH_LSB |
+                        QMI_M1_RFMT_DATA_WIDTH_VALUE_Q << QMI_M1_RFMT_DATA_WIDTH_LSB |
+                        QMI_M1_RFMT_PREFIX_LEN_VALUE_8 << QMI_M1_RFMT_PREFIX_LEN_LSB |
+                        QMI_M1_RFMT_DUMMY_LEN_VALUE_24 << QMI_M1_RFMT_DUMMY_LEN_LSB;
+    qmi_hw->m[1].rcmd = CMD_QPI_FAST_READ;
+    qmi_hw->m[1].wfmt = QMI_M1_WFMT_PREFIX_WIDTH_VALUE_Q << QMI_M1_WFMT_PREFIX_WIDTH_LSB |
+                        QMI_M1_WFMT_ADDR_WIDTH_VALUE_Q << QMI_M1_WFMT_ADDR_WIDTH_LSB |
+                        QMI_M1_WFMT_SUFFIX_WIDTH_VALUE_Q << QMI_M1_WFMT_SUFFIX_WIDTH_LSB |
+                        QMI_M1_WFMT_DUMMY_WIDTH_VALUE_Q << QMI_M1_WFMT_DUMMY_WIDTH_LSB |
+                        QMI_M1_WFMT_DATA_WIDTH_VALUE_Q << QMI_M1_WFMT_DATA_WIDTH_LSB |
+                        QMI_M1_WFMT_PREFIX_LEN_VALUE_8 << QMI_M1_WFMT_PREFIX_LEN_LSB;
+    qmi_hw->m[1].wcmd = CMD_QPI_WRITE;
+
+    // Allow writes through the XIP window
+    xip_ctrl_hw->ctrl |= XIP_CTRL_WRITABLE_M1_BITS;
+
+    restore_interrupts(interrupts);
+    return size;
+}
+
+} // namespace Exterminate
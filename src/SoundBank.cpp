@@ -0,0 +1,124 @@
+#include "SoundBank.h"
+#include "pico/stdlib.h"
+#include <stdio.h>
+#if __has_include("pico/btstack_flash_bank.h")
+#include "pico/btstack_flash_bank.h"
+#endif
+
+namespace Exterminate {
+
+// The packer writes index entries with this exact 32-bit layout
+#if defined(__arm__)
+static_assert(sizeof(Audio::AudioFile) == 40, "AudioFile layout must match tools/pack_sound_bank.py");
+#endif
+static_assert(sizeof(SoundBank::Header) == 32, "SoundBank header must match tools/pack_sound_bank.py");
+
+// BTstack keeps its pairing keys at the end of flash; the bank must stop short of them
+#ifdef PICO_FLASH_BANK_STORAGE_OFFSET
+static_assert(SOUND_BANK_FLASH_OFFSET + SOUND_BANK_SIZE_BYTES <= PICO_FLASH_BANK_STORAGE_OFFSET,
+              "Sound bank partition overlaps BTstack's flash bank storage");
+#endif
+
+const SoundBank::Header* SoundBank::header_ = nullptr;
+
+uintptr_t SoundBank::defaultXipBase() {
+    return XIP_BASE + SOUND_BANK_FLASH_OFFSET;
+}
+
+uint32_t SoundBank::crc32(const uint8_t* data, size_t length) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+bool SoundBank::validateEntry(const Audio::AudioFile& file, uintptr_t base, size_t totalBytes) {
+    const uintptr_t end = base + totalBytes;
+    auto inside = [&](const void* pointer, size_t bytes) {
+        const uintptr_t address = reinterpret_cast<uintptr_t>(pointer);
+        return address >= base && address <= end && bytes <= end - address;
+    };
+
+    const void* payload = (file.codec == Audio::AudioCodec::PCM16)
+        ? static_cast<const void*>(file.data) : static_cast<const void*>(file.encoded);
+    if (!payload || !inside(payload, file.byte_size) ||
+        (reinterpret_cast<uintptr_t>(payload) - base) % PAYLOAD_ALIGN != 0) {
+        return false;
+    }
+    if (!file.name || !inside(file.name, 1)) {
+        return false;
+    }
+
+    // The payload must hold every sample the reader will be asked for
+    size_t neededBytes = 0;
+    switch (file.codec) {
+        case Audio::AudioCodec::PCM16:
+            neededBytes = static_cast<size_t>(file.sample_count) * sizeof(int16_t);
+            break;
+        case Audio::AudioCodec::MU_LAW:
+            neededBytes = file.sample_count;
+            break;
+        case Audio::AudioCodec::IMA_ADPCM:
+            neededBytes = (file.sample_count + Audio::ADPCM_BLOCK_SAMPLES - 1) / Audio::ADPCM_BLOCK_SAMPLES
+                        * Audio::ADPCM_BLOCK_BYTES;
+            break;
+        default:
+            return false;
+    }
+    if (file.byte_size < neededBytes) {
+        return false;
+    }
+    const size_t envelopeBytes = (file.sample_count + Audio::ENVELOPE_BLOCK_SAMPLES - 1) / Audio::ENVELOPE_BLOCK_SAMPLES;
+    return !file.envelope || inside(file.envelope, envelopeBytes);
+}
+
+bool SoundBank::mount(uintptr_t xipBase, size_t partitionBytes) {
+    const Header* header = reinterpret_cast<const Header*>(xipBase);
+
+    if (header->magic != MAGIC) {
+        printf("SoundBank: No bank at 0x%08lx - using compiled-in clips\n", (unsigned long)xipBase);
+        return false;
+    }
+
+    const uint32_t crc = crc32(reinterpret_cast<const uint8_t*>(header), offsetof(Header, headerCrc));
+    if (crc != header->headerCrc || header->version != VERSION) {
+        printf("SoundBank: ERROR - Bad header (version %u, crc 0x%08lx)\n",
+               header->version, (unsigned long)crc);
+        return false;
+    }
+
+    // Pointers in the index are absolute, so the bank must sit where it was packed for
+    const size_t indexBytes = header->clipCount * sizeof(Audio::AudioFile);
+    if (header->xipBase != xipBase || header->totalBytes > partitionBytes ||
+        header->clipCount == 0 || header->clipCount > MAX_CLIPS ||
+        header->indexOffset < sizeof(Header) || header->indexOffset + indexBytes > header->dataOffset ||
+        header->dataOffset % PAYLOAD_ALIGN != 0 || header->dataOffset > header->totalBytes) {
+        printf("SoundBank: ERROR - Bank layout does not fit partition at 0x%08lx\n", (unsigned long)xipBase);
+        return false;
+    }
+
+    const Audio::AudioFile* files = reinterpret_cast<const Audio::AudioFile*>(xipBase + header->indexOffset);
+    for (size_t i = 0; i < header->clipCount; ++i) {
+        if (!validateEntry(files[i], xipBase, header->totalBytes)) {
+            printf("SoundBank: ERROR - Clip %zu points outside the bank\n", i);
+            return false;
+        }
+    }
+
+    header_ = header;
+    Audio::setAudioFileTable(files, header->clipCount);
+    printf("SoundBank: Mounted %u clips, %lu bytes at 0x%08lx\n",
+           header->clipCount, (unsigned long)header->totalBytes, (unsigned long)xipBase);
+    return true;
+}
+
+void SoundBank::unmount() {
+    header_ = nullptr;
+    Audio::setAudioFileTable(nullptr, 0);
+}
+
+} // namespace Exterminate
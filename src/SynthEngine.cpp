@@ -0,0 +1,295 @@
+#include "SynthEngine.h"
+#include <audio/audio_index.h>
+#include "CycleCounter.h"
+#include "SineTable.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Exterminate {
+
+namespace {
+
+constexpr int32_t LEVEL_ONE = 1 << 16;        // Q16 envelope full scale
+constexpr int32_t FILTER_BYPASS = 32767;      // Q15 coefficient that passes the input
+constexpr uint16_t LFSR_TAPS = 0xB400;        // x^16 + x^14 + x^13 + x^11 + 1
+constexpr uint32_t MAX_PHASE_STEP = 0x7FFFFFFFu;  // Nyquist
+
+inline int16_t saturate16(int32_t value) {
+    if (value > INT16_MAX) return INT16_MAX;
+    if (value < INT16_MIN) return INT16_MIN;
+    return static_cast<int16_t>(value);
+}
+
+inline int32_t oscillator(SynthPatch::Waveform waveform, uint32_t phase) {
+    switch (waveform) {
+        case SynthPatch::Waveform::Sine:
+            return SineTable::lookup(phase);
+        case SynthPatch::Waveform::Square:
+            return (phase & 0x80000000u) ? -32767 : 32767;
+        case SynthPatch::Waveform::Saw:
+            return static_cast<int32_t>(phase >> 16) - 32768;
+        case SynthPatch::Waveform::Triangle: {
+            const int32_t saw = static_cast<int32_t>(phase >> 16) - 32768;
+            return 2 * (saw < 0 ? -saw : saw) - 32768;
+        }
+    }
+    return 0;
+}
+
+} // namespace
+
+SynthEngine::SynthEngine()
+    : voices_{}
+    , accumulator_{}
+    , sampleRate_(Audio::AUDIO_SAMPLE_RATE)
+    , startCounter_(0)
+    , nextNote_(NO_NOTE)
+    , lastCycles_(0)
+    , peakCycles_(0)
+    , notes_(0)
+    , steals_(0)
+{
+}
+
+void SynthEngine::setSampleRate(uint32_t sampleRate) {
+    if (sampleRate > 0) {
+        sampleRate_ = sampleRate;
+    }
+}
+
+void SynthEngine::setPitchScale(NoteId note, uint16_t scaleQ12) {
+    if (Voice* voice = findVoice(note)) {
+        voice->pitchScale = scaleQ12;
+    }
+}
+
+const SynthEngine::Voice* SynthEngine::findVoice(NoteId note) const {
+    if (note == NO_NOTE) {
+        return nullptr;
+    }
+    for (const Voice& voice : voices_) {
+        if (voice.stage != Stage::Off && voice.note == note) {
+            return &voice;
+        }
+    }
+    return nullptr;
+}
+
+SynthEngine::Voice* SynthEngine::findVoice(NoteId note) {
+    return const_cast<Voice*>(static_cast<const SynthEngine*>(this)->findVoice(note));
+}
+
+int32_t SynthEngine::stepForMs(uint32_t ms) const {
+    const uint32_t samples = std::max<uint32_t>(1, static_cast<uint32_t>(
+        (static_cast<uint64_t>(ms) * sampleRate_) / 1000));
+    return static_cast<int32_t>((LEVEL_ONE + samples - 1) / samples);
+}
+
+SynthEngine::NoteId SynthEngine::noteOn(const SynthPatch* patch, uint16_t gain, NoteId note) {
+    if (!patch || patch->pitchHz == 0 || patch->pitchHz * 2u >= sampleRate_) {
+        return NO_NOTE;
+    }
+    if (note == NO_NOTE) {
+        note = ++nextNote_;
+        if (note == NO_NOTE) {
+            note = ++nextNote_;
+        }
+    }
+
+    // Free voice first, otherwise the oldest note
+    int slot = 0;
+    for (size_t i = 0; i < MAX_VOICES; ++i) {
+        if (voices_[i].stage == Stage::Off) {
+            slot = static_cast<int>(i);
+            break;
+        }
+        if (static_cast<int32_t>(voices_[i].startOrder - voices_[slot].startOrder) < 0) {
+            slot = static_cast<int>(i);
+        }
+    }
+    Voice& voice = voices_[slot];
+    if (voice.stage != Stage::Off) {
+        ++steals_;
+    }
+
+    // Everything the per-sample loop needs is fixed here
+    const float rate = static_cast<float>(sampleRate_);
+    voice.patch = patch;
+    voice.stage = Stage::Attack;
+    voice.startOrder = startCounter_++;
+    voice.note = note;
+    voice.pitchScale = PITCH_UNITY;
+    voice.phase = 0;
+    voice.baseStep = static_cast<uint32_t>((static_cast<uint64_t>(patch->pitchHz) << 32) / sampleRate_);
+    voice.sweepFactor = static_cast<uint32_t>(
+        65536.0f * std::exp2(patch->sweep / 12.0f * CONTROL_SAMPLES / rate) + 0.5f);
+
+    voice.lfsr = static_cast<uint16_t>(0xACE1u ^ (voice.startOrder * 0x9E37u));
+    if (voice.lfsr == 0) {
+        voice.lfsr = 1;
+    }
+    voice.noiseMix = patch->noise + (patch->noise >> 7);  // 255 -> 256, all noise
+    if (patch->cutoffHz == 0 || patch->cutoffHz * 2u >= sampleRate_) {
+        voice.filterCoeff = FILTER_BYPASS;
+    } else {
+        const float coeff = 1.0f - std::exp(-2.0f * 3.14159265f * patch->cutoffHz / rate);
+        voice.filterCoeff = std::max<int32_t>(1, std::min<int32_t>(FILTER_BYPASS,
+                                                                   static_cast<int32_t>(coeff * 32768.0f)));
+    }
+    voice.filterState = 0;
+
+    voice.level = 0;
+    voice.attackStep = stepForMs(patch->attackMs);
+    voice.decayStep = stepForMs(patch->decayMs);
+    voice.sustainLevel = patch->sustain * 257;
+    voice.releaseStep = stepForMs(patch->releaseMs);
+    voice.holdSamples = patch->holdMs
+        ? std::max<uint32_t>(1, static_cast<uint32_t>((static_cast<uint64_t>(patch->holdMs) * sampleRate_) / 1000))
+        : 0;
+    voice.gain = gain;
+
+    ++notes_;
+    return note;
+}
+
+void SynthEngine::release(NoteId note) {
+    if (Voice* voice = findVoice(note)) {
+        voice->stage = Stage::Release;
+    }
+}
+
+void SynthEngine::stopAll() {
+    for (Voice& voice : voices_) {
+        voice.stage = Stage::Off;
+    }
+}
+
+size_t SynthEngine::activeVoiceCount() const {
+    size_t count = 0;
+    for (const Voice& voice : voices_) {
+        if (voice.stage != Stage::Off) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+SynthEngine::NoteId SynthEngine::voiceNote(size_t voice) const {
+    if (voice >= MAX_VOICES || voices_[voice].stage == Stage::Off) {
+        return NO_NOTE;
+    }
+    return voices_[voice].note;
+}
+
+size_t SynthEngine::render(int16_t* out, size_t count) {
+    const uint32_t start = CycleCounter::now();
+    bool sounded = false;
+
+    for (size_t offset = 0; offset < count; offset += CONTROL_SAMPLES) {
+        const size_t block = std::min(CONTROL_SAMPLES, count - offset);
+        std::fill(accumulator_, accumulator_ + block, 0);
+
+        bool sounding = false;
+        for (Voice& voice : voices_) {
+            if (voice.stage != Stage::Off) {
+                renderVoice(voice, accumulator_, block);
+                sounding = true;
+            }
+        }
+        if (!sounding) {
+            break;
+        }
+
+        sounded = true;
+        for (size_t i = 0; i < block; ++i) {
+            out[offset + i] = saturate16(out[offset + i] + accumulator_[i]);
+        }
+    }
+
+    lastCycles_ = CycleCounter::now() - start;
+    peakCycles_ = std::max(peakCycles_, lastCycles_);
+    return sounded ? count : 0;
+}
+
+void SynthEngine::renderVoice(Voice& voice, int32_t* accumulator, size_t count) {
+    const SynthPatch::Waveform waveform = voice.patch->waveform;
+
+    // Pitch is constant across the block
+    uint64_t step = voice.baseStep;
+    if (voice.patch->tracksPitch) {
+        step = (step * voice.pitchScale) >> 12;
+    }
+    const uint32_t phaseStep = static_cast<uint32_t>(std::min<uint64_t>(step, MAX_PHASE_STEP));
+
+    uint32_t phase = voice.phase;
+    uint16_t lfsr = voice.lfsr;
+    int32_t filterState = voice.filterState;
+    int32_t level = voice.level;
+    const int32_t noiseMix = voice.noiseMix;
+    const int32_t filterCoeff = voice.filterCoeff;
+    const uint32_t gain = voice.gain;
+
+    for (size_t i = 0; i < count; ++i) {
+        int32_t sample = oscillator(waveform, phase);
+        phase += phaseStep;
+
+        // Galois LFSR: one shift per sample, full-scale white noise
+        lfsr = static_cast<uint16_t>((lfsr >> 1) ^ (-(lfsr & 1u) & LFSR_TAPS));
+        const int32_t noise = static_cast<int16_t>(lfsr);
+        sample += ((noise - sample) * noiseMix) >> 8;
+
+        filterState += ((sample - filterState) * filterCoeff) >> 15;
+
+        switch (voice.stage) {
+            case Stage::Attack:
+                level += voice.attackStep;
+                if (level >= LEVEL_ONE) {
+                    level = LEVEL_ONE;
+                    voice.stage = Stage::Decay;
+                }
+                break;
+            case Stage::Decay:
+                level -= voice.decayStep;
+                if (level <= voice.sustainLevel) {
+                    level = voice.sustainLevel;
+                    voice.stage = level > 0 ? Stage::Sustain : Stage::Off;
+                }
+                break;
+            case Stage::Sustain:
+                if (voice.holdSamples > 0 && --voice.holdSamples == 0) {
+                    voice.stage = Stage::Release;
+                }
+                break;
+            case Stage::Release:
+                level -= voice.releaseStep;
+                if (level <= 0) {
+                    level = 0;
+                    voice.stage = Stage::Off;
+                }
+                break;
+            case Stage::Off:
+                break;
+        }
+
+        // Q16 level x Q15 gain -> Q15 amplitude
+        const int32_t amplitude = static_cast<int32_t>((static_cast<uint32_t>(level) * gain) >> 16);
+        accumulator[i] += (filterState * amplitude) >> 15;
+
+        if (voice.stage == Stage::Off) {
+            break;
+        }
+    }
+
+    voice.phase = phase;
+    voice.lfsr = lfsr;
+    voice.filterState = filterState;
+    voice.level = level;
+
+    // Glide once per block
+    if (voice.sweepFactor != 65536) {
+        const uint64_t swept = (static_cast<uint64_t>(voice.baseStep) * voice.sweepFactor) >> 16;
+        voice.baseStep = static_cast<uint32_t>(std::max<uint64_t>(1, std::min<uint64_t>(swept, MAX_PHASE_STEP)));
+    }
+}
+
+} // namespace Exterminate
@@ -0,0 +1,184 @@
+#include "TimeStretch.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Exterminate {
+
+TimeStretch::TimeStretch()
+    : input_{}
+    , output_{}
+    , tail_{}
+    , sequence_(0)
+    , seek_(0)
+    , overlap_(0)
+    , tempo_(TEMPO_UNITY)
+    , skipFraction_(0)
+    , inputCount_(0)
+    , audioCount_(0)
+    , outputRead_(0)
+    , outputCount_(0)
+    , haveTail_(false)
+    , sequences_(0)
+{
+    configure(44100);
+}
+
+void TimeStretch::configure(uint32_t sampleRate) {
+    const uint32_t rate = std::max<uint32_t>(1000, std::min(sampleRate, MAX_SAMPLE_RATE));
+    sequence_ = rate * SEQUENCE_MS / 1000;
+    seek_ = rate * SEEK_MS / 1000;
+    overlap_ = rate * OVERLAP_MS / 1000;
+    sequences_ = 0;
+    reset();
+}
+
+void TimeStretch::reset() {
+    skipFraction_ = 0;
+    inputCount_ = 0;
+    audioCount_ = 0;
+    outputRead_ = 0;
+    outputCount_ = 0;
+    haveTail_ = false;
+}
+
+void TimeStretch::setTempo(uint32_t tempoQ16) {
+    tempo_ = std::max(MIN_TEMPO, std::min(MAX_TEMPO, tempoQ16));
+}
+
+size_t TimeStretch::inputNeeded() const {
+    const uint64_t advance = skipFraction_ + static_cast<uint64_t>(tempo_) * (sequence_ - overlap_);
+    return std::max(seek_ + sequence_, static_cast<size_t>(advance >> 16));
+}
+
+void TimeStretch::pull(size_t count, Source source, void* context) {
+    count = std::min(count, INPUT_CAPACITY - inputCount_);
+    if (count == 0) {
+        return;
+    }
+    const size_t audio = source(input_ + inputCount_, count, context);
+    if (audio > 0) {
+        audioCount_ = inputCount_ + audio;
+    }
+    inputCount_ += count;
+}
+
+size_t TimeStretch::process(int16_t* out, size_t count, Source source, void* context) {
+    // Read ahead a little every call, so the mixer's work is spread over
+    // the buffers instead of landing on the one that starts a sequence
+    const size_t needed = inputNeeded();
+    if (inputCount_ < needed) {
+        pull(std::min(needed - inputCount_, 2 * count), source, context);
+    }
+
+    size_t written = 0;
+    while (written < count) {
+        if (outputCount_ == 0 && !nextSequence(source, context)) {
+            break;
+        }
+        const size_t samples = std::min(count - written, outputCount_);
+        memcpy(out + written, output_ + outputRead_, samples * sizeof(int16_t));
+        outputRead_ += samples;
+        outputCount_ -= samples;
+        written += samples;
+    }
+
+    if (written < count) {
+        memset(out + written, 0, (count - written) * sizeof(int16_t));
+    }
+    if (written == 0) {
+        reset();
+    }
+    return written;
+}
+
+bool TimeStretch::nextSequence(Source source, void* context) {
+    const size_t needed = inputNeeded();
+    if (inputCount_ < needed) {
+        pull(needed - inputCount_, source, context);
+    }
+    if (audioCount_ == 0) {
+        return false;
+    }
+    if (inputCount_ < needed) {
+        // Source ended: the last sequence reads silence past the audio
+        memset(input_ + inputCount_, 0, (needed - inputCount_) * sizeof(int16_t));
+        inputCount_ = needed;
+    }
+
+    const size_t offset = haveTail_ ? bestOffset() : 0;
+    const int16_t* in = input_ + offset;
+    const size_t length = sequence_ - overlap_;
+    size_t i = 0;
+
+    // Fade from the previous sequence's tail into this one
+    if (haveTail_) {
+        const int32_t fadeStep = static_cast<int32_t>(32768 / overlap_);
+        int32_t fade = 0;
+        for (; i < overlap_; ++i) {
+            const int32_t from = tail_[i];
+            output_[i] = static_cast<int16_t>(from + (((in[i] - from) * fade) >> 15));
+            fade += fadeStep;
+        }
+    }
+    memcpy(output_ + i, in + i, (length - i) * sizeof(int16_t));
+    memcpy(tail_, in + length, overlap_ * sizeof(int16_t));
+    haveTail_ = true;
+    outputRead_ = 0;
+    outputCount_ = length;
+
+    // Advance the input by tempo times the output just made
+    const uint64_t advance = skipFraction_ + static_cast<uint64_t>(tempo_) * length;
+    const size_t skip = static_cast<size_t>(advance >> 16);
+    skipFraction_ = static_cast<uint32_t>(advance & 0xFFFFu);
+    memmove(input_, input_ + skip, (inputCount_ - skip) * sizeof(int16_t));
+    inputCount_ -= skip;
+    audioCount_ = audioCount_ > skip ? audioCount_ - skip : 0;
+
+    ++sequences_;
+    return true;
+}
+
+size_t TimeStretch::bestOffset() const {
+    // Coarse pass over the seek window, then every offset around the winner
+    size_t best = 0;
+    float bestScore = matchScore(0);
+    for (size_t offset = COARSE_STEP; offset < seek_; offset += COARSE_STEP) {
+        const float score = matchScore(offset);
+        if (score > bestScore) {
+            bestScore = score;
+            best = offset;
+        }
+    }
+
+    const size_t first = best >= COARSE_STEP - 1 ? best - (COARSE_STEP - 1) : 0;
+    const size_t last = std::min(best + COARSE_STEP - 1, seek_ - 1);
+    const size_t coarse = best;
+    for (size_t offset = first; offset <= last; ++offset) {
+        if (offset == coarse) {
+            continue;
+        }
+        const float score = matchScore(offset);
+        if (score > bestScore) {
+            bestScore = score;
+            best = offset;
+        }
+    }
+    return best;
+}
+
+float TimeStretch::matchScore(size_t offset) const {
+    // Every other sample is plenty for the speech band and halves the cost
+    const int16_t* in = input_ + offset;
+    int64_t correlation = 0;
+    int64_t energy = 0;
+    for (size_t i = 0; i < overlap_; i += 2) {
+        correlation += static_cast<int32_t>(tail_[i]) * in[i];
+        energy += static_cast<int32_t>(in[i]) * in[i];
+    }
+
+    // corr * |corr| / energy ranks like corr / sqrt(energy) without the root
+    const float c = static_cast<float>(correlation);
+    return c * (c < 0.0f ? -c : c) / (static_cast<float>(energy) + 1.0f);
+}
+
+} // namespace Exterminate
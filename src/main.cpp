@@ -6,8 +6,9 @@
 #include "AudioController.h"
 #include "SimpleLED.h"
 #include "MotorController.h"
-#include "audio/00001.h"  // Boot sound
+#include <audio/00001.h>  // Boot sound
 #include "MosfetDriver.h"
+#include "SoundBank.h"
 
 // Guard optional CYW43 include so builds succeed even if headers aren't present
 #if defined(__has_include)
@@ -64,11 +65,18 @@ int main() {
 
     printf("GamepadController initialized successfully.\n");
     
+    // Use the flash sound bank when one has been loaded; otherwise the
+    // clips compiled into the firmware stay active
+    SoundBank::mount();
+
     // Initialize and test audio system
-    AudioController audio;
+    static AudioController audio;
     if (audio.initialize()) {
         printf("Audio initialized successfully\n");
         
+        // Report the cost of the sample path against the buffer deadline
+        audio.benchmarkSamplePaths();
+        
         // Set the audio controller for gamepad button controls after audio init
         gamepadController.setAudioController(&audio);
         
@@ -135,7 +143,10 @@ int main() {
         .leftMotorPin2 = 7,  // AIN2
         .rightMotorPin1 = 27, // BIN1
         .rightMotorPin2 = 26, // BIN2
-        .pwmFrequency = 20000 // 20 kHz
+        .pwmFrequency = 20000, // 20 kHz
+        .controlRateHz = 1000, // Fixed-rate slew loop, independent of gamepad reports
+        .maxAcceleration = 4.0f, // Full speed in 250 ms
+        .maxJerk = 40.0f // Acceleration eases in and out over 100 ms
     };
 
     static MotorController motorController(motorConfig);
@@ -181,6 +192,10 @@ int main() {
     printf("2. All gamepad inputs will be logged to this UART console\n");
     printf("3. Audio Controls:\n");
     printf("   - A Button: Trigger sound bite\n");
+    printf("   - B Button: Synthesised zap (driving hums, pitch follows throttle)\n");
+    printf("   - X Button: Toggle Dalek voice (live microphone on GPIO 40)\n");
+    printf("   - L2/R2 Triggers: Bend speech pitch down/up an octave\n");
+    printf("   - SELECT: Print audio pipeline and motor loop stats\n");
     printf("   - Red LEDs will react to audio playback\n");
     printf("4. Use Ctrl+C to stop the program if needed\n");
     printf("\n");
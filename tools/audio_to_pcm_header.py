@@ -14,11 +14,46 @@ To update audio files:
 2. Run: python tools/audio_to_pcm_header.py misc include/audio --pattern "*.mp3"
 3. Commit the generated .h files to git
 4. The MP3 files are excluded by .gitignore
+
+COMPRESSED STORAGE:
+Pass --codec adpcm (IMA-ADPCM, 4:1) or --codec mulaw (G.711 mu-law, 2:1) to
+store clips compressed. AudioController decodes them block by block while it
+fills I2S buffers, so no RAM copy of the clip is needed.
+
+PER-CLIP SAMPLE RATES:
+Pass --auto-rate to store each clip at the lowest of 16, 22.05, 32 or 44.1 kHz
+that still holds 99.5% of its spectral energy (never above --sample-rate).
+The mixer converts clips to the I2S rate on the fly.
+
+LOOP POINTS:
+WAV files carrying a sampler ('smpl') loop play their first loop forever.
+Pass --loop NAME:START:END (source file samples, END exclusive, repeatable)
+to set or override a clip's loop. Positions are rescaled to the stored rate.
+
+BINARY BLOBS:
+Pass --blob-dir DIR to write each clip as raw little-endian DIR/NNNNN.bin
+(plus NNNNN.env, its loudness envelope) and an AudioData.S that links them
+with .incbin, instead of AudioData.cpp with every sample as C source text.
+The CMake build does this at build time for clips in misc/, with the
+headers (output_dir) and AudioIndex.cpp (--source-dir) also generated in
+its build tree, so the checkout is never written. DIR also holds
+audio_manifest.json, with a SHA-256 of each source file and its options.
+Clips whose hash and blobs are unchanged are not decoded again. The rest
+are converted in parallel (--jobs, default one per core).
+
+REGISTRY:
+audio_index.h holds the whole registry as constexpr tables: clip metadata,
+categories (--category NAME:CATEGORY, default phrase) and a perfect hash of
+the clip names, so clips resolve by AudioIndex or by name at compile time.
 """
 
 import os
 import sys
 import argparse
+import hashlib
+import json
+import struct
+from concurrent.futures import ProcessPoolExecutor
 from pathlib import Path
 import numpy as np
 
@@ -33,6 +68,282 @@ except ImportError:
     print("Install with: pip install librosa soundfile")
     print("Falling back to basic file reading (for pre-converted PCM files only)")
 
+# Codec names accepted on the command line -> Audio::AudioCodec enumerators
+CODECS = {
+    'pcm16': 'PCM16',
+    'adpcm': 'IMA_ADPCM',
+    'mulaw': 'MU_LAW',
+}
+
+# Clip categories accepted by --category -> (Audio::AudioCategory enumerator,
+# weight playRandomAudio() gives the category)
+CATEGORIES = {
+    'phrase': ('Phrase', 4),
+    'effect': ('Effect', 2),
+    'ambient': ('Ambient', 1),
+}
+DEFAULT_CATEGORY = 'phrase'
+
+# Must match hashAudioName() in audio_index.h (32-bit FNV-1a, seeded basis)
+FNV_OFFSET_BASIS = 2166136261
+FNV_PRIME = 16777619
+
+# Bump when the blob layout or conversion changes, to invalidate cached blobs
+BLOB_FORMAT_VERSION = 1
+MANIFEST_NAME = 'audio_manifest.json'
+
+# Candidate storage rates for --auto-rate, lowest first
+AUTO_RATES = (16000, 22050, 32000, 44100)
+# Fraction of spectral energy that must sit below 0.45 * rate
+AUTO_RATE_ENERGY = 0.995
+
+# Must match ENVELOPE_BLOCK_SAMPLES in audio_index.h
+ENVELOPE_BLOCK_SAMPLES = 256
+# RMS gain applied before quantising the envelope (full scale at RMS 1/3)
+ENVELOPE_GAIN = 3.0
+
+# Must match ADPCM_* constants in audio_index.h
+ADPCM_BLOCK_BYTES = 256
+ADPCM_HEADER_BYTES = 4
+ADPCM_BLOCK_SAMPLES = 1 + (ADPCM_BLOCK_BYTES - ADPCM_HEADER_BYTES) * 2
+
+ADPCM_STEP_TABLE = [
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+    34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+    157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+    724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+    3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+]
+
+ADPCM_INDEX_TABLE = [-1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8]
+
+def encode_mulaw(pcm_data):
+    """Encode 16-bit PCM to G.711 mu-law bytes (decoded by ClipReader::decodeMuLaw)."""
+    bias = 0x84
+    clip = 32635
+    samples = pcm_data.astype(np.int32)
+    sign = np.where(samples < 0, 0x80, 0x00)
+    magnitude = np.minimum(np.abs(samples), clip) + bias
+    exponent = np.floor(np.log2(magnitude >> 7)).astype(np.int32)
+    mantissa = (magnitude >> (exponent + 3)) & 0x0F
+    return (~(sign | (exponent << 4) | mantissa) & 0xFF).astype(np.uint8)
+
+def encode_ima_adpcm(pcm_data):
+    """
+    Encode 16-bit PCM to IMA-ADPCM blocks.
+
+    Each ADPCM_BLOCK_BYTES block starts with the first sample verbatim and the
+    step index, so the decoder can start (or seek) at any block boundary.
+    The encoder tracks the decoder's predictor exactly to avoid drift.
+    """
+    samples = [int(x) for x in pcm_data]
+    out = bytearray()
+    step_index = 0
+
+    for block_start in range(0, len(samples), ADPCM_BLOCK_SAMPLES):
+        block = samples[block_start:block_start + ADPCM_BLOCK_SAMPLES]
+        predictor = block[0]
+        header = bytearray(ADPCM_BLOCK_BYTES)
+        header[0] = predictor & 0xFF
+        header[1] = (predictor >> 8) & 0xFF
+        header[2] = step_index
+        header[3] = 0
+
+        for k, sample in enumerate(block[1:]):
+            step = ADPCM_STEP_TABLE[step_index]
+            diff = sample - predictor
+            code = 0
+            if diff < 0:
+                code = 8
+                diff = -diff
+            if diff >= step:
+                code |= 4
+                diff -= step
+            if diff >= step >> 1:
+                code |= 2
+                diff -= step >> 1
+            if diff >= step >> 2:
+                code |= 1
+
+            # Reconstruct exactly as ClipReader::readAdpcm() does
+            delta = step >> 3
+            if code & 1:
+                delta += step >> 2
+            if code & 2:
+                delta += step >> 1
+            if code & 4:
+                delta += step
+            predictor = predictor - delta if code & 8 else predictor + delta
+            predictor = max(-32768, min(32767, predictor))
+            step_index = max(0, min(88, step_index + ADPCM_INDEX_TABLE[code]))
+
+            byte_pos = ADPCM_HEADER_BYTES + (k >> 1)
+            if k & 1:
+                header[byte_pos] |= code << 4
+            else:
+                header[byte_pos] |= code
+
+        # The final block only stores the bytes it uses
+        used = ADPCM_HEADER_BYTES + len(block) // 2
+        out += header if len(block) == ADPCM_BLOCK_SAMPLES else header[:used]
+
+    return np.frombuffer(bytes(out), dtype=np.uint8)
+
+def encode_clip(pcm_data, codec):
+    """Return the encoded byte payload for a clip, or None for raw PCM16."""
+    if codec == 'mulaw':
+        return encode_mulaw(pcm_data)
+    if codec == 'adpcm':
+        return encode_ima_adpcm(pcm_data)
+    return None
+
+def pick_sample_rate(samples, sample_rate):
+    """Return the lowest AUTO_RATES entry that keeps AUTO_RATE_ENERGY of the clip."""
+    spectrum = np.abs(np.fft.rfft(samples.astype(np.float64))) ** 2
+    total = spectrum.sum()
+    if total <= 0:
+        return min(AUTO_RATES[0], sample_rate)
+
+    freqs = np.fft.rfftfreq(len(samples), 1.0 / sample_rate)
+    cumulative = np.cumsum(spectrum) / total
+    cutoff = freqs[min(np.searchsorted(cumulative, AUTO_RATE_ENERGY), len(freqs) - 1)]
+
+    # Leave 10% of Nyquist for the resampling filters' transition band
+    for rate in AUTO_RATES:
+        if rate <= sample_rate and cutoff <= 0.45 * rate:
+            return rate
+    return sample_rate
+
+def compute_envelope(pcm_data):
+    """Return one uint8 loudness value per ENVELOPE_BLOCK_SAMPLES samples."""
+    samples = pcm_data.astype(np.float64) / 32768.0
+    if samples.ndim > 1:
+        samples = samples.mean(axis=1)
+    blocks = -(-len(samples) // ENVELOPE_BLOCK_SAMPLES)
+    padded = np.zeros(blocks * ENVELOPE_BLOCK_SAMPLES)
+    padded[:len(samples)] = samples
+    rms = np.sqrt(np.mean(padded.reshape(blocks, ENVELOPE_BLOCK_SAMPLES) ** 2, axis=1))
+    return np.round(np.clip(rms * ENVELOPE_GAIN, 0.0, 1.0) * 255).astype(np.uint8)
+
+def read_wav_loop(audio_path):
+    """Return (start, end, sample_rate) of a WAV file's first smpl loop, or None.
+
+    end is exclusive; the smpl chunk stores the last looped sample.
+    """
+    if Path(audio_path).suffix.lower() != '.wav':
+        return None
+    with open(audio_path, 'rb') as f:
+        data = f.read()
+    if len(data) < 12 or data[0:4] != b'RIFF' or data[8:12] != b'WAVE':
+        return None
+
+    sample_rate = None
+    loop = None
+    offset = 12
+    while offset + 8 <= len(data):
+        chunk_id, chunk_size = struct.unpack_from('<4sI', data, offset)
+        body = offset + 8
+        if chunk_id == b'fmt ' and chunk_size >= 8:
+            sample_rate = struct.unpack_from('<I', data, body + 4)[0]
+        elif chunk_id == b'smpl' and chunk_size >= 36 + 24:
+            # 36-byte header (loop count at +28), then 24 bytes per loop
+            if struct.unpack_from('<I', data, body + 28)[0] > 0:
+                start, last = struct.unpack_from('<II', data, body + 36 + 8)
+                loop = (start, last + 1)
+        offset = body + chunk_size + (chunk_size & 1)
+
+    if loop is None or sample_rate is None:
+        return None
+    return loop[0], loop[1], sample_rate
+
+def parse_loop_option(value):
+    """Parse a --loop NAME:START:END argument."""
+    try:
+        name, start, end = value.rsplit(':', 2)
+        return name, int(start), int(end)
+    except ValueError:
+        raise argparse.ArgumentTypeError(f"expected NAME:START:END, got '{value}'")
+
+def resolve_loop(audio_path, loop, sample_rate, sample_count):
+    """Return a clip's (loop_start, loop_end) at the stored rate; (0, 0) plays once.
+
+    loop is (start, end) in source file samples and wins over a WAV smpl chunk.
+    """
+    wav_loop = read_wav_loop(audio_path)
+    if loop is None and wav_loop is None:
+        return 0, 0
+    if loop is None:
+        loop = (wav_loop[0], wav_loop[1])
+    source_rate = wav_loop[2] if wav_loop else librosa.get_samplerate(str(audio_path))
+    loop_points = scale_loop(loop, source_rate, sample_rate, sample_count)
+    if loop_points[1]:
+        print(f"Loop: samples {loop_points[0]}-{loop_points[1]} at {sample_rate}Hz")
+    return loop_points
+
+def scale_loop(loop, source_rate, sample_rate, sample_count):
+    """Rescale (start, end) to the stored rate; returns (0, 0) if it does not fit."""
+    start, end = loop
+    if source_rate and source_rate != sample_rate:
+        start = int(round(start * sample_rate / source_rate))
+        end = int(round(end * sample_rate / source_rate))
+    end = min(end, sample_count)
+    if start < 0 or start >= end:
+        print(f"Warning: loop {loop} is empty after conversion - clip plays once")
+        return 0, 0
+    return start, end
+
+def parse_category_option(value):
+    """Parse --category NAME:CATEGORY."""
+    name, sep, category = value.rpartition(':')
+    if not sep or not name or category not in CATEGORIES:
+        raise argparse.ArgumentTypeError(f"expected NAME:{{{','.join(CATEGORIES)}}}, got '{value}'")
+    return name, category
+
+def hash_name(name, seed):
+    """Seeded FNV-1a of a clip name, as hashAudioName() computes it."""
+    value = FNV_OFFSET_BASIS ^ seed
+    for byte in name.encode('utf-8'):
+        value = ((value ^ byte) * FNV_PRIME) & 0xFFFFFFFF
+    return value
+
+def build_name_hash(names):
+    """Hash-and-displace perfect hash of the clip names.
+
+    Names fall into buckets by their seed-0 hash; each bucket, largest
+    first, gets the first seed that puts all its names into free slots.
+    Returns (seed per bucket, clip index per slot or None).
+    """
+    slot_count = 1
+    while slot_count < len(names):
+        slot_count *= 2
+    bucket_count = max(1, slot_count // 2)
+    buckets = [[] for _ in range(bucket_count)]
+    for index, name in enumerate(names):
+        buckets[hash_name(name, 0) & (bucket_count - 1)].append(index)
+
+    seeds = [0] * bucket_count
+    slots = [None] * slot_count
+    for bucket in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+        members = buckets[bucket]
+        if not members:
+            continue
+        for seed in range(1, 0x10000):
+            taken = [hash_name(names[i], seed) & (slot_count - 1) for i in members]
+            if len(set(taken)) == len(taken) and all(slots[slot] is None for slot in taken):
+                break
+        else:
+            raise RuntimeError(f"no perfect hash seed for {[names[i] for i in members]}")
+        seeds[bucket] = seed
+        for index, slot in zip(members, taken):
+            slots[slot] = index
+    return seeds, slots
+
+def format_table(values, per_line=16):
+    """Comma-separated table rows for a generated array initialiser."""
+    rows = [', '.join(str(v) for v in values[i:i + per_line]) for i in range(0, len(values), per_line)]
+    return ',\n'.join(f"    {row}" for row in rows)
+
 def sanitize_variable_name(filename):
     """Convert filename to a valid C++ variable name."""
     # Remove extension and convert to valid identifier
@@ -96,13 +407,21 @@ def audio_to_pcm(audio_path, sample_rate=44100, channels=1, bit_depth=16):
         print(f"Error converting {audio_path}: {e}")
         return None
 
-def pcm_to_header(audio_path, output_dir, sample_rate=44100, channels=1, bit_depth=16):
-    """Convert an audio file to a C++ header file with PCM data declarations only."""
+def convert_clip(audio_path, sample_rate=44100, channels=1, bit_depth=16, codec='pcm16',
+                 auto_rate=False, loop=None, category=DEFAULT_CATEGORY):
+    """Decode and encode one audio file; returns its samples and metadata (None on failure)."""
     audio_file = Path(audio_path)
     if not audio_file.exists():
         print(f"Error: {audio_path} does not exist")
         return None
     
+    # Analyse at the full rate, then convert once at the chosen rate
+    if auto_rate and AUDIO_LIBS_AVAILABLE:
+        y, _ = librosa.load(audio_path, sr=sample_rate, mono=True)
+        chosen = pick_sample_rate(y, sample_rate)
+        print(f"Auto rate: {chosen}Hz (from {sample_rate}Hz)")
+        sample_rate = chosen
+    
     # Convert audio to PCM
     result = audio_to_pcm(audio_path, sample_rate, channels, bit_depth)
     if result is None:
@@ -110,20 +429,71 @@ def pcm_to_header(audio_path, output_dir, sample_rate=44100, channels=1, bit_dep
     
     pcm_data, dtype_name = result
     
-    # Generate variable name
-    var_name = sanitize_variable_name(audio_file.name)
+    loop_points = resolve_loop(audio_path, loop, sample_rate, len(pcm_data))
+    
+    # Compressed clips are stored as bytes; only mono 16-bit input is supported
+    encoded = None
+    if codec != 'pcm16':
+        if channels != 1 or bit_depth != 16:
+            print(f"Error: --codec {codec} requires mono 16-bit PCM")
+            return None
+        encoded = encode_clip(pcm_data, codec)
+        dtype_name = "uint8_t"
     
-    # Create header filename
-    header_name = f"{audio_file.stem}.h"
-    header_path = Path(output_dir) / header_name
+    bytes_per_sample = bit_depth // 8
+    total_bytes = len(pcm_data) * bytes_per_sample if encoded is None else len(encoded)
+    
+    return {
+        'var_name': sanitize_variable_name(audio_file.name),
+        'pcm_data': pcm_data,
+        'encoded': encoded,
+        'codec': codec,
+        'sample_count': len(pcm_data),
+        'dtype_name': dtype_name,
+        'total_bytes': total_bytes,
+        'sample_rate': sample_rate,
+        'channels': channels,
+        'bit_depth': bit_depth,
+        'envelope': compute_envelope(pcm_data),
+        'loop': loop_points,
+        'category': category,
+        'audio_file': audio_file
+    }
+
+def write_if_changed(path, content):
+    """Write a generated file only if its content differs, so unchanged
+    outputs keep their timestamps and trigger no rebuild."""
+    path = Path(path)
+    mode = 'b' if isinstance(content, bytes) else ''
+    if path.exists():
+        with open(path, 'r' + mode) as f:
+            if f.read() == content:
+                return False
+    path.parent.mkdir(parents=True, exist_ok=True)
+    with open(path, 'w' + mode) as f:
+        f.write(content)
+    return True
+
+def write_clip_header(audio_data, output_dir):
+    """Write a clip's C++ header: data declarations and constexpr metadata."""
+    audio_file = audio_data['audio_file']
+    var_name = audio_data['var_name']
+    sample_count = audio_data['sample_count']
+    sample_rate = audio_data['sample_rate']
+    channels = audio_data['channels']
+    bit_depth = audio_data['bit_depth']
+    total_bytes = audio_data['total_bytes']
+    loop_points = audio_data['loop']
     
-    # Ensure output directory exists
-    header_path.parent.mkdir(parents=True, exist_ok=True)
+    header_path = Path(output_dir) / f"{audio_file.stem}.h"
     
     # Calculate audio metadata
-    duration_ms = int((len(pcm_data) / sample_rate) * 1000)
+    duration_ms = int((sample_count / sample_rate) * 1000)
     bytes_per_sample = bit_depth // 8
-    total_bytes = len(pcm_data) * bytes_per_sample
+    format_name = (f"{bit_depth}-bit PCM" if audio_data['codec'] == 'pcm16'
+                   else f"{CODECS[audio_data['codec']]} ({sample_count * bytes_per_sample / total_bytes:.1f}:1)")
+    
+    loop_comment = f"// Loop: samples {loop_points[0]:,}-{loop_points[1]:,}\n" if loop_points[1] else ""
     
     # Generate C++ header content (declarations only)
     header_content = f"""#pragma once
@@ -138,47 +508,142 @@ namespace Exterminate {{
 namespace Audio {{
 
 // PCM audio data for {audio_file.name}
-// Format: {sample_rate}Hz, {channels} channel(s), {bit_depth}-bit PCM
-// Duration: {duration_ms}ms ({len(pcm_data):,} samples)
-extern const {dtype_name} {var_name}_DATA[];
-extern const size_t {var_name}_SAMPLE_COUNT;
-extern const size_t {var_name}_BYTE_SIZE;
-extern const uint32_t {var_name}_SAMPLE_RATE;
-extern const uint8_t {var_name}_CHANNELS;
-extern const uint8_t {var_name}_BIT_DEPTH;
+// Format: {sample_rate}Hz, {channels} channel(s), {format_name}
+// Duration: {duration_ms}ms ({sample_count:,} samples)
+{loop_comment}extern const {audio_data['dtype_name']} {var_name}_DATA[];
+constexpr size_t {var_name}_SAMPLE_COUNT = {sample_count};
+constexpr size_t {var_name}_BYTE_SIZE = {total_bytes};
+constexpr uint32_t {var_name}_SAMPLE_RATE = {sample_rate};
+constexpr uint8_t {var_name}_CHANNELS = {channels};
+constexpr uint8_t {var_name}_BIT_DEPTH = {bit_depth};
+extern const uint8_t {var_name}_ENVELOPE[];
 
 }} // namespace Audio
 }} // namespace Exterminate
 """
     
-    # Write header file
-    with open(header_path, 'w') as f:
-        f.write(header_content)
+    if write_if_changed(header_path, header_content):
+        print(f"Generated: {header_path} (declarations only)")
+
+def conversion_hash(audio_file, args, loop, category):
+    """SHA-256 of a source file's content and every option that shapes its conversion."""
+    digest = hashlib.sha256()
+    with open(audio_file, 'rb') as f:
+        for chunk in iter(lambda: f.read(1 << 20), b''):
+            digest.update(chunk)
+    options = (BLOB_FORMAT_VERSION, args.sample_rate, args.channels, args.bit_depth, args.codec,
+               args.auto_rate, loop, category)
+    digest.update(repr(options).encode('utf-8'))
+    return digest.hexdigest()
+
+def clip_symbol(name):
+    """Itanium-mangled name of Exterminate::Audio::<name>, for the assembler."""
+    return f"_ZN11Exterminate5Audio{len(name)}{name}E"
+
+def write_clip_blobs(audio_data, blob_dir):
+    """Write a clip's stored bytes and its envelope as raw little-endian blobs."""
+    stem = audio_data['audio_file'].stem
+    encoded = audio_data['encoded']
+    if encoded is None:
+        dtype = '<i2' if audio_data['bit_depth'] == 16 else '<i4'
+        payload = np.ascontiguousarray(audio_data['pcm_data'], dtype=dtype).tobytes()
+    else:
+        payload = bytes(encoded)
+    write_if_changed(Path(blob_dir) / f"{stem}.bin", payload)
+    write_if_changed(Path(blob_dir) / f"{stem}.env", bytes(int(level) for level in audio_data['envelope']))
+
+def generate_audio_data_asm(audio_data_list, blob_dir):
+    """Generate AudioData.S, which links the clip blobs into flash with .incbin."""
+    blob_dir = Path(blob_dir)
+    asm_path = blob_dir / "AudioData.S"
+    
+    content = """/*
+ * Audio data definitions for Exterminate project
+ * Links the raw clip blobs next to this file under the symbols the clip
+ * headers declare; no sample goes through the C++ compiler
+ *
+ * Auto-generated by tools/audio_to_pcm_header.py - DO NOT EDIT MANUALLY
+ */
+"""
+    
+    for audio_data in audio_data_list:
+        stem = audio_data['audio_file'].stem
+        var_name = audio_data['var_name']
+        for suffix, extension in (('DATA', 'bin'), ('ENVELOPE', 'env')):
+            symbol = clip_symbol(f"{var_name}_{suffix}")
+            blob = (blob_dir / f"{stem}.{extension}").resolve().as_posix()
+            content += f"""
+    .section .rodata.{var_name}_{suffix}, "a", %progbits
+    .balign 4
+    .global {symbol}
+    .type {symbol}, %object
+{symbol}:
+    .incbin "{blob}"
+    .size {symbol}, . - {symbol}
+"""
+    
+    # Data only: no executable stack for hosted linkers
+    content += """
+    .section .note.GNU-stack, "", %progbits
+"""
     
-    print(f"Generated: {header_path} (declarations only)")
+    # Rewritten on every run so the build sees the conversion as done
+    asm_path.parent.mkdir(parents=True, exist_ok=True)
+    with open(asm_path, 'w') as f:
+        f.write(content)
     
-    # Return the data for source file generation
+    print(f"Generated: {asm_path}")
+    return asm_path
+
+def load_manifest(blob_dir):
+    """Previous conversions by source file name, from the blob directory's manifest."""
+    path = Path(blob_dir) / MANIFEST_NAME
+    try:
+        with open(path) as f:
+            return json.load(f)
+    except (OSError, ValueError):
+        return {}
+
+def manifest_entry(audio_data, source_hash):
+    """Everything write_clip_header() and the index need, without the samples."""
     return {
-        'var_name': var_name,
-        'pcm_data': pcm_data,
-        'dtype_name': dtype_name,
-        'total_bytes': total_bytes,
-        'sample_rate': sample_rate,
-        'channels': channels,
-        'bit_depth': bit_depth,
-        'audio_file': audio_file
+        'hash': source_hash,
+        'var_name': audio_data['var_name'],
+        'codec': audio_data['codec'],
+        'sample_count': audio_data['sample_count'],
+        'dtype_name': audio_data['dtype_name'],
+        'total_bytes': audio_data['total_bytes'],
+        'sample_rate': audio_data['sample_rate'],
+        'channels': audio_data['channels'],
+        'bit_depth': audio_data['bit_depth'],
+        'loop': list(audio_data['loop']),
+        'category': audio_data['category'],
     }
 
-def generate_audio_data_source(audio_data_list, output_dir):
+def cached_clip(audio_file, entry, blob_dir):
+    """Rebuild a clip's metadata from its manifest entry if its blobs are still there."""
+    if not all((Path(blob_dir) / f"{audio_file.stem}.{extension}").exists() for extension in ('bin', 'env')):
+        return None
+    audio_data = {key: value for key, value in entry.items() if key != 'hash'}
+    audio_data.update(loop=tuple(entry['loop']), pcm_data=None, encoded=None, envelope=None,
+                      audio_file=audio_file)
+    return audio_data
+
+def convert_job(job):
+    """convert_clip() for a worker process."""
+    audio_file, options = job
+    return convert_clip(audio_file, **options)
+
+def generate_audio_data_source(audio_data_list, output_dir, source_dir=None):
     """Generate a single source file with all audio data implementations."""
-    source_path = Path(output_dir).parent / "src" / "AudioData.cpp"
+    source_path = Path(source_dir or Path(output_dir).parent.parent / "src") / "AudioData.cpp"
     
     # Ensure src directory exists
     source_path.parent.mkdir(parents=True, exist_ok=True)
     
     content = """// Audio data definitions for Exterminate project
 // This file contains the actual definitions of all audio data
-// The headers only contain extern declarations to avoid multiple definition errors
+// The headers declare the arrays and hold the scalar metadata as constexpr
 // 
 // Auto-generated by tools/audio_to_pcm_header.py - DO NOT EDIT MANUALLY
 
@@ -189,8 +654,8 @@ def generate_audio_data_source(audio_data_list, output_dir):
     
     # Include all audio headers to get extern declarations
     for audio_data in audio_data_list:
-        header_name = f"../include/audio/{audio_data['audio_file'].stem}.h"
-        content += f'#include "{header_name}"\n'
+        header_name = f"audio/{audio_data['audio_file'].stem}.h"
+        content += f'#include <{header_name}>\n'
     
     content += """
 namespace Exterminate {
@@ -208,38 +673,46 @@ namespace Audio {
         content += f"// Audio data for {audio_file.name}\n"
         content += f"const {dtype_name} {var_name}_DATA[] = {{\n"
         
-        # Add PCM data (8 samples per line for readability)
+        # Add PCM data (8 samples per line) or encoded bytes (16 per line)
         flat_data = pcm_data.flatten() if len(pcm_data.shape) > 1 else pcm_data
-        for i in range(0, len(flat_data), 8):
-            chunk = flat_data[i:i+8]
-            sample_values = ', '.join(f'{int(sample)}' for sample in chunk)
+        encoded = audio_data['encoded']
+        values = flat_data if encoded is None else encoded
+        per_line = 8 if encoded is None else 16
+        for i in range(0, len(values), per_line):
+            chunk = values[i:i+per_line]
+            if encoded is None:
+                sample_values = ', '.join(f'{int(sample)}' for sample in chunk)
+            else:
+                sample_values = ', '.join(f'0x{int(byte):02x}' for byte in chunk)
             content += f"    {sample_values}"
-            if i + 8 < len(flat_data):
+            if i + per_line < len(values):
                 content += ","
             content += "\n"
         
         content += f"}};\n\n"
         
-        # Add constants
-        content += f"const size_t {var_name}_SAMPLE_COUNT = {len(flat_data)};\n"
-        content += f"const size_t {var_name}_BYTE_SIZE = {audio_data['total_bytes']};\n"
-        content += f"const uint32_t {var_name}_SAMPLE_RATE = {audio_data['sample_rate']};\n"
-        content += f"const uint8_t {var_name}_CHANNELS = {audio_data['channels']};\n"
-        content += f"const uint8_t {var_name}_BIT_DEPTH = {audio_data['bit_depth']};\n\n"
+        # LED loudness envelope, one byte per ENVELOPE_BLOCK_SAMPLES samples
+        envelope = audio_data['envelope']
+        content += f"const uint8_t {var_name}_ENVELOPE[] = {{\n"
+        for i in range(0, len(envelope), 16):
+            levels = ', '.join(f'{int(level)}' for level in envelope[i:i+16])
+            content += f"    {levels}"
+            if i + 16 < len(envelope):
+                content += ","
+            content += "\n"
+        content += f"}};\n\n"
     
     content += """} // namespace Audio
 } // namespace Exterminate
 """
     
     # Write source file
-    with open(source_path, 'w') as f:
-        f.write(content)
-    
-    print(f"Generated: {source_path}")
+    if write_if_changed(source_path, content):
+        print(f"Generated: {source_path}")
     return source_path
 
-def generate_audio_index(audio_files, output_dir, sample_rate=44100, channels=1, bit_depth=16):
-    """Generate an index header that includes all audio files (declarations only)."""
+def generate_audio_index(audio_data_list, output_dir, sample_rate=44100, channels=1, bit_depth=16):
+    """Generate the registry header: declarations plus the constexpr clip tables."""
     index_path = Path(output_dir) / "audio_index.h"
     
     dtype_name = "int16_t" if bit_depth == 16 else "int32_t"
@@ -256,8 +729,8 @@ def generate_audio_index(audio_files, output_dir, sample_rate=44100, channels=1,
 """
     
     # Include all individual headers
-    for audio_file in audio_files:
-        header_name = f"{Path(audio_file).stem}.h"
+    for audio_data in audio_data_list:
+        header_name = f"{audio_data['audio_file'].stem}.h"
         content += f'#include "{header_name}"\n'
     
     content += f"""
@@ -269,104 +742,224 @@ constexpr uint32_t AUDIO_SAMPLE_RATE = {sample_rate};
 constexpr uint8_t AUDIO_CHANNELS = {channels};
 constexpr uint8_t AUDIO_BIT_DEPTH = {bit_depth};
 
+// Clip sample encodings
+enum class AudioCodec : uint8_t {{
+    PCM16 = 0,      // Raw signed 16-bit samples in data
+    IMA_ADPCM = 1,  // 4-bit IMA-ADPCM blocks in encoded (4:1)
+    MU_LAW = 2      // 8-bit G.711 mu-law bytes in encoded (2:1)
+}};
+
+// IMA-ADPCM block layout: int16 first sample, uint8 step index, uint8 pad,
+// then two samples per byte (low nibble first)
+constexpr size_t ADPCM_BLOCK_BYTES = {ADPCM_BLOCK_BYTES};
+constexpr size_t ADPCM_HEADER_BYTES = {ADPCM_HEADER_BYTES};
+constexpr size_t ADPCM_BLOCK_SAMPLES = 1 + (ADPCM_BLOCK_BYTES - ADPCM_HEADER_BYTES) * 2;
+
+// Clip samples covered by one loudness envelope entry
+constexpr size_t ENVELOPE_BLOCK_SAMPLES = {ENVELOPE_BLOCK_SAMPLES};
+
 // PCM audio file registry
 struct AudioFile {{
     const char* name;
-    const {dtype_name}* data;
-    size_t sample_count;
-    size_t byte_size;
+    const {dtype_name}* data;        // PCM16 samples (nullptr for compressed clips)
+    size_t sample_count;        // Decoded mono samples
+    size_t byte_size;           // Stored bytes in flash
     uint32_t sample_rate;
     uint8_t channels;
     uint8_t bit_depth;
+    AudioCodec codec;
+    const uint8_t* encoded;     // Compressed payload (nullptr for PCM16)
+    const uint8_t* envelope;    // Loudness (0-255) per ENVELOPE_BLOCK_SAMPLES samples
+    uint32_t loop_start;        // First sample of the loop
+    uint32_t loop_end;          // Sample after the loop (0 = play once)
 }};
 
-// Available audio files
-extern const AudioFile AUDIO_FILES[];
-extern const size_t AUDIO_FILE_COUNT;
+// Available audio files; constant data in flash, nothing runs at startup
+inline constexpr AudioFile AUDIO_FILES[] = {{
+"""
+    
+    # Compressed clips expose their bytes via 'encoded'
+    for audio_data in audio_data_list:
+        var_name = audio_data['var_name']
+        filename = audio_data['audio_file'].name
+        codec = audio_data['codec']
+        pcm_ptr = f"{var_name}_DATA" if codec == 'pcm16' else "nullptr"
+        encoded_ptr = "nullptr" if codec == 'pcm16' else f"{var_name}_DATA"
+        loop_start, loop_end = audio_data['loop']
+        content += f"""    {{"{filename}", {pcm_ptr}, {var_name}_SAMPLE_COUNT, {var_name}_BYTE_SIZE,
+     {var_name}_SAMPLE_RATE, {var_name}_CHANNELS, {var_name}_BIT_DEPTH,
+     AudioCodec::{CODECS[codec]}, {encoded_ptr}, {var_name}_ENVELOPE, {loop_start}, {loop_end}}},
+"""
+    
+    content += f"""}};
+
+constexpr size_t AUDIO_FILE_COUNT = {len(audio_data_list)};
 
 // Audio file indices for easy access
 enum class AudioIndex : size_t {{
 """
     
     # Add enum values
-    for i, audio_file in enumerate(audio_files):
-        var_name = sanitize_variable_name(Path(audio_file).name)
-        content += f"    {var_name} = {i},\n"
+    for i, audio_data in enumerate(audio_data_list):
+        content += f"    {audio_data['var_name']} = {i},\n"
     
-    content += f"""    COUNT = {len(audio_files)}
+    content += f"""    COUNT = {len(audio_data_list)}
+}};
+
+// Clip groups for random playback
+enum class AudioCategory : uint8_t {{
+"""
+    
+    for i, (enumerator, _) in enumerate(CATEGORIES.values()):
+        content += f"    {enumerator} = {i},\n"
+    
+    names = [audio_data['audio_file'].name for audio_data in audio_data_list]
+    seeds, slots = build_name_hash(names)
+    categories = [f"AudioCategory::{CATEGORIES[audio_data['category']][0]}" for audio_data in audio_data_list]
+    weights = [weight for _, weight in CATEGORIES.values()]
+    
+    content += f"""    COUNT = {len(CATEGORIES)}
+}};
+
+// Category of each clip, in AudioIndex order
+inline constexpr AudioCategory AUDIO_CATEGORIES[] = {{
+{format_table(categories, 4)}
 }};
 
-// Helper functions
+// Relative chance of each category in playRandomAudio()
+inline constexpr uint8_t AUDIO_CATEGORY_WEIGHTS[] = {{
+{format_table(weights)}
+}};
+
+// Perfect hash of the clip names: the seed-0 hash picks a bucket, the
+// bucket's seed hashes the name to a slot holding its index
+constexpr size_t AUDIO_NAME_BUCKETS = {len(seeds)};
+constexpr size_t AUDIO_NAME_SLOTS = {len(slots)};
+constexpr uint16_t AUDIO_NAME_EMPTY = 0xFFFF;
+
+inline constexpr uint16_t AUDIO_NAME_SEEDS[] = {{
+{format_table(seeds)}
+}};
+
+inline constexpr uint16_t AUDIO_NAME_INDEX[] = {{
+{format_table(['AUDIO_NAME_EMPTY' if slot is None else slot for slot in slots], 8)}
+}};
+
+// Seeded 32-bit FNV-1a; must match hash_name() in tools/audio_to_pcm_header.py
+constexpr uint32_t hashAudioName(const char* name, uint32_t seed) {{
+    uint32_t hash = {FNV_OFFSET_BASIS}u ^ seed;
+    for (; *name; ++name) {{
+        hash = (hash ^ static_cast<uint8_t>(*name)) * {FNV_PRIME}u;
+    }}
+    return hash;
+}}
+
+constexpr bool audioNameEquals(const char* a, const char* b) {{
+    for (; *a && *a == *b; ++a, ++b) {{
+    }}
+    return *a == *b;
+}}
+
+// Index of a compiled-in clip by name (AudioIndex::COUNT if unknown);
+// two hashes and one compare, folded away for a literal name
+constexpr AudioIndex findAudioIndex(const char* name) {{
+    const uint32_t seed = AUDIO_NAME_SEEDS[hashAudioName(name, 0) & (AUDIO_NAME_BUCKETS - 1)];
+    const uint16_t index = AUDIO_NAME_INDEX[hashAudioName(name, seed) & (AUDIO_NAME_SLOTS - 1)];
+    return index != AUDIO_NAME_EMPTY && audioNameEquals(AUDIO_FILES[index].name, name)
+               ? static_cast<AudioIndex>(index)
+               : AudioIndex::COUNT;
+}}
+
+// Compiled-in clip by tag, e.g. audioFile<AudioIndex::AUDIO_00001>().sample_rate
+template <AudioIndex Index>
+constexpr const AudioFile& audioFile() {{
+    static_assert(Index < AudioIndex::COUNT, "no such clip");
+    return AUDIO_FILES[static_cast<size_t>(Index)];
+}}
+
+constexpr uint32_t audioDurationMs(const AudioFile& file) {{
+    return static_cast<uint32_t>(static_cast<uint64_t>(file.sample_count) * 1000 / file.sample_rate);
+}}
+
+// Category of a clip; clips past the compiled-in table (a larger sound bank) are phrases
+constexpr AudioCategory getAudioCategory(size_t index) {{
+    return index < AUDIO_FILE_COUNT ? AUDIO_CATEGORIES[index] : AudioCategory::{CATEGORIES[DEFAULT_CATEGORY][0]};
+}}
+
+// Helper functions (these follow a mounted sound bank)
 const AudioFile* getAudioFile(AudioIndex index);
 const AudioFile* getAudioFile(const char* name);
+size_t getAudioFileCount();
+
+// Replace the compiled-in registry (e.g. with a flash sound bank's index);
+// nullptr restores AUDIO_FILES
+void setAudioFileTable(const AudioFile* files, size_t count);
 
 }} // namespace Audio
 }} // namespace Exterminate
 """
     
-    with open(index_path, 'w') as f:
-        f.write(content)
-    
-    print(f"Generated: {index_path}")
+    if write_if_changed(index_path, content):
+        print(f"Generated: {index_path}")
 
-def generate_audio_index_source(audio_files, output_dir):
-    """Generate the source file for the audio index with implementations."""
-    source_path = Path(output_dir).parent / "src" / "AudioIndex.cpp"
+def generate_audio_index_source(audio_data_list, output_dir, source_dir=None):
+    """Generate the source file for the registry lookups that follow a sound bank."""
+    source_path = Path(source_dir or Path(output_dir).parent.parent / "src") / "AudioIndex.cpp"
     
     # Ensure src directory exists
     source_path.parent.mkdir(parents=True, exist_ok=True)
     
-    dtype_name = "int16_t"  # Assuming 16-bit for now
-    
     content = """// Audio index implementations for Exterminate project
-// This file contains the actual definitions for audio file registry
+// The compiled-in registry is constexpr in audio_index.h; these lookups
+// also cover a mounted sound bank
 // 
 // Auto-generated by tools/audio_to_pcm_header.py - DO NOT EDIT MANUALLY
 
-#include "../include/audio/audio_index.h"
+#include <audio/audio_index.h>
 
 namespace Exterminate {
 namespace Audio {
 
-const AudioFile AUDIO_FILES[] = {
-"""
-    
-    # Add audio file entries
-    for audio_file in audio_files:
-        var_name = sanitize_variable_name(Path(audio_file).name)
-        filename = Path(audio_file).name
-        content += f"""    {{"{filename}", {var_name}_DATA, {var_name}_SAMPLE_COUNT, {var_name}_BYTE_SIZE, 
-     {var_name}_SAMPLE_RATE, {var_name}_CHANNELS, {var_name}_BIT_DEPTH}},
-"""
-    
-    content += f"""}};
+// Registry in use; a mounted sound bank replaces the compiled-in table
+static const AudioFile* activeFiles = AUDIO_FILES;
+static size_t activeFileCount = AUDIO_FILE_COUNT;
 
-const size_t AUDIO_FILE_COUNT = {len(audio_files)};
+void setAudioFileTable(const AudioFile* files, size_t count) {
+    activeFiles = files ? files : AUDIO_FILES;
+    activeFileCount = files ? count : AUDIO_FILE_COUNT;
+}
 
-const AudioFile* getAudioFile(AudioIndex index) {{
-    if (static_cast<size_t>(index) >= AUDIO_FILE_COUNT) {{
+size_t getAudioFileCount() {
+    return activeFileCount;
+}
+
+const AudioFile* getAudioFile(AudioIndex index) {
+    if (static_cast<size_t>(index) >= activeFileCount) {
         return nullptr;
-    }}
-    return &AUDIO_FILES[static_cast<size_t>(index)];
-}}
+    }
+    return &activeFiles[static_cast<size_t>(index)];
+}
 
-const AudioFile* getAudioFile(const char* name) {{
-    for (size_t i = 0; i < AUDIO_FILE_COUNT; ++i) {{
-        if (strcmp(AUDIO_FILES[i].name, name) == 0) {{
-            return &AUDIO_FILES[i];
-        }}
-    }}
+const AudioFile* getAudioFile(const char* name) {
+    // Compiled-in names are perfect-hashed; a bank's names are only known at run time
+    if (activeFiles == AUDIO_FILES) {
+        const AudioIndex index = findAudioIndex(name);
+        return index == AudioIndex::COUNT ? nullptr : &AUDIO_FILES[static_cast<size_t>(index)];
+    }
+    for (size_t i = 0; i < activeFileCount; ++i) {
+        if (strcmp(activeFiles[i].name, name) == 0) {
+            return &activeFiles[i];
+        }
+    }
     return nullptr;
-}}
+}
 
-}} // namespace Audio
-}} // namespace Exterminate
+} // namespace Audio
+} // namespace Exterminate
 """
     
-    with open(source_path, 'w') as f:
-        f.write(content)
-    
-    print(f"Generated: {source_path}")
+    if write_if_changed(source_path, content):
+        print(f"Generated: {source_path}")
     return source_path
 
 def main():
@@ -377,6 +970,21 @@ def main():
     parser.add_argument('--sample-rate', type=int, default=44100, help='Target sample rate (default: 44100)')
     parser.add_argument('--channels', type=int, choices=[1, 2], default=1, help='Number of channels (default: 1=mono)')
     parser.add_argument('--bit-depth', type=int, choices=[16, 32], default=16, help='Bits per sample (default: 16)')
+    parser.add_argument('--codec', choices=sorted(CODECS), default='pcm16',
+                        help='Clip storage: pcm16, adpcm (IMA-ADPCM 4:1) or mulaw (2:1) (default: pcm16)')
+    parser.add_argument('--auto-rate', action='store_true',
+                        help='Store each clip at the lowest rate that keeps its bandwidth (max: --sample-rate)')
+    parser.add_argument('--loop', type=parse_loop_option, action='append', default=[], metavar='NAME:START:END',
+                        help='Loop a clip between source samples START and END (exclusive); repeatable')
+    parser.add_argument('--category', type=parse_category_option, action='append', default=[],
+                        metavar='NAME:CATEGORY',
+                        help=f"Category for random playback ({', '.join(CATEGORIES)}; default {DEFAULT_CATEGORY}); repeatable")
+    parser.add_argument('--blob-dir', metavar='DIR',
+                        help='Write .bin blobs and an .incbin AudioData.S to DIR instead of src/AudioData.cpp')
+    parser.add_argument('--source-dir', metavar='DIR',
+                        help='Directory for AudioIndex.cpp and AudioData.cpp (default: src/ next to output_dir)')
+    parser.add_argument('--jobs', type=int, default=os.cpu_count() or 1,
+                        help='Clips converted in parallel (default: one per core)')
     
     args = parser.parse_args()
     
@@ -403,29 +1011,88 @@ def main():
         return 1
     
     print(f"Found {len(audio_files)} audio files")
-    print(f"Target format: {args.sample_rate}Hz, {args.channels} channel(s), {args.bit_depth}-bit PCM")
+    print(f"Target format: {args.sample_rate}Hz, {args.channels} channel(s), {args.bit_depth}-bit PCM, codec {args.codec}")
     
-    # Convert each audio file to header (declarations only)
-    audio_data = []
-    success_count = 0
+    loops = {name: (start, end) for name, start, end in args.loop}
+    unknown = set(loops) - {f.name for f in audio_files}
+    if unknown:
+        print(f"Error: --loop names unknown files: {', '.join(sorted(unknown))}")
+        return 1
+    
+    categories = dict(args.category)
+    unknown = set(categories) - {f.name for f in audio_files}
+    if unknown:
+        print(f"Error: --category names unknown files: {', '.join(sorted(unknown))}")
+        return 1
+    
+    # Reuse blobs whose source content and options are unchanged
+    manifest = load_manifest(args.blob_dir) if args.blob_dir else {}
+    hashes = {}
+    audio_data = {}
+    jobs = []
     for audio_file in audio_files:
-        data = pcm_to_header(audio_file, output_path, args.sample_rate, args.channels, args.bit_depth)
-        if data:
-            audio_data.append(data)
-            success_count += 1
+        loop = loops.get(audio_file.name)
+        category = categories.get(audio_file.name, DEFAULT_CATEGORY)
+        if args.blob_dir:
+            hashes[audio_file.name] = conversion_hash(audio_file, args, loop, category)
+            entry = manifest.get(audio_file.name)
+            if entry and entry['hash'] == hashes[audio_file.name]:
+                cached = cached_clip(audio_file, entry, args.blob_dir)
+                if cached:
+                    audio_data[audio_file.name] = cached
+                    continue
+        jobs.append((audio_file, {
+            'sample_rate': args.sample_rate, 'channels': args.channels, 'bit_depth': args.bit_depth,
+            'codec': args.codec, 'auto_rate': args.auto_rate, 'loop': loop, 'category': category,
+        }))
+    
+    if args.blob_dir:
+        print(f"Unchanged: {len(audio_data)} clips, converting {len(jobs)}")
+    
+    # Decode and encode the rest, one process per core
+    workers = max(1, min(args.jobs, len(jobs)))
+    if workers > 1:
+        with ProcessPoolExecutor(max_workers=workers) as pool:
+            results = list(pool.map(convert_job, jobs))
+    else:
+        results = [convert_job(job) for job in jobs]
+    
+    for (audio_file, _), data in zip(jobs, results):
+        if not data:
+            continue
+        if args.blob_dir:
+            write_clip_blobs(data, args.blob_dir)
+            manifest[audio_file.name] = manifest_entry(data, hashes[audio_file.name])
+        audio_data[audio_file.name] = data
+    
+    # Keep file order; failed clips are left out
+    audio_data = [audio_data[f.name] for f in audio_files if f.name in audio_data]
+    success_count = len(audio_data)
     
     if success_count > 0:
-        # Generate single source file with all implementations
-        generate_audio_data_source(audio_data, output_path)
+        for data in audio_data:
+            write_clip_header(data, output_path)
+        
+        if args.blob_dir:
+            # Drop clips that are gone, then link the blobs
+            manifest = {data['audio_file'].name: manifest[data['audio_file'].name] for data in audio_data}
+            write_if_changed(Path(args.blob_dir) / MANIFEST_NAME, json.dumps(manifest, indent=2, sort_keys=True) + '\n')
+            generate_audio_data_asm(audio_data, args.blob_dir)
+        else:
+            # Generate single source file with all implementations
+            generate_audio_data_source(audio_data, output_path, args.source_dir)
         
         # Generate index files (both header and source)
-        generate_audio_index(audio_files, output_path, args.sample_rate, args.channels, args.bit_depth)
-        generate_audio_index_source(audio_files, output_path)
+        generate_audio_index(audio_data, output_path, args.sample_rate, args.channels, args.bit_depth)
+        generate_audio_index_source(audio_data, output_path, args.source_dir)
         
         print(f"Successfully converted {success_count}/{len(audio_files)} files")
         print(f"\nGenerated files:")
         print(f"  - {success_count} header files (declarations)")
-        print(f"  - AudioData.cpp (all implementations)")
+        if args.blob_dir:
+            print(f"  - {Path(args.blob_dir) / 'AudioData.S'} (.incbin of {success_count} clip blobs)")
+        else:
+            print(f"  - AudioData.cpp (all implementations)")
         print(f"  - audio_index.h (registry header)")
         print(f"  - AudioIndex.cpp (registry implementation)")
         print(f"\nTo use in your code:")
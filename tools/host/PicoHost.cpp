@@ -0,0 +1,816 @@
+#include "PicoHost.h"
+#include "pico/audio_i2s.h"
+#include "pico/multicore.h"
+#include "pico/time.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/pio.h"
+#include "hardware/sync.h"
+#include "hardware/structs/m33.h"
+#include "hardware/structs/qmi.h"
+#include "hardware/structs/xip_ctrl.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+
+namespace Exterminate::Host {
+
+namespace {
+
+constexpr uint SILENCE_FRAMES = 256;        // pico-extras' PICO_AUDIO_I2S_SILENCE_BUFFER_SAMPLE_LENGTH
+constexpr uint MAX_CHANNELS = 2;
+constexpr uint IRQ_COUNT = 64;
+constexpr uint FIRST_USER_IRQ = 46;         // SPARE_IRQ_0 on the RP2350
+constexpr uint USER_IRQ_COUNT = 6;
+constexpr uint SM_COUNT = 4;
+constexpr size_t MAX_TIMERS = 16;           // The SDK's default alarm pool
+constexpr uint32_t CLK_SYS_HZ = 1000000000; // One cycle per host nanosecond
+constexpr uint MAX_CONSUMER_BUFFERS = 4;    // Stands in for the heap audio_i2s_connect_extra() mallocs from
+constexpr uint MAX_CONSUMER_FRAMES = 256;
+
+using Clock = std::chrono::steady_clock;
+
+uint64_t s_nowUs = 0;
+
+// Interrupts: one core, every handler at the same priority
+irq_handler_t s_handlers[IRQ_COUNT] = {};
+bool s_irqEnabled[IRQ_COUNT] = {};
+bool s_irqPending[IRQ_COUNT] = {};
+uint32_t s_userIrqsClaimed = 0;
+bool s_interruptsDisabled = false;
+bool s_inHandler = false;
+HandlerStats s_handlerStats = {};
+
+struct Timer {
+    repeating_timer_t* timer;
+    uint64_t dueUs;
+};
+Timer s_timers[MAX_TIMERS];
+size_t s_timerCount = 0;
+int s_nextAlarmId = 1;
+
+uint32_t s_dmaClaimed = 0;
+uint32_t s_smClaimed[2] = {};
+spin_lock_t s_spinLocks[32];
+
+dma_hw_t s_dma = {};
+pio_hw_t s_pio[2] = {};
+adc_hw_t s_adc = {};
+qmi_hw_t s_qmi = {};
+xip_ctrl_hw_t s_xipCtrl = {};
+m33_hw_t s_m33 = {};
+
+// I2S: the transfer in flight covers frames [s_transferStart, + s_transferFrames)
+// of the output, which has been delivered up to s_frames
+audio_format_t s_i2sFormat = {44100, AUDIO_BUFFER_FORMAT_PCM_S16, 2};
+bool s_i2sEnabled = false;
+audio_buffer_t* s_playing = nullptr;
+uint64_t s_transferStart = 0;
+uint32_t s_transferFrames = 0;
+uint64_t s_frames = 0;
+I2sSink s_sink = nullptr;
+void* s_sinkContext = nullptr;
+
+// pico-extras' producer_pool_take_buffer_default() and producer_pool_give_buffer_default()
+audio_buffer_t* defaultProducerTake(audio_connection_t* connection, bool block) {
+    return get_free_audio_buffer(connection->producer_pool, block);
+}
+
+void defaultProducerGive(audio_connection_t* connection, audio_buffer_t* buffer) {
+    queue_full_audio_buffer(connection->producer_pool, buffer);
+}
+
+// pico-extras' default connection (buffer_copying_on_consumer_take_connection):
+// each consumer take fills one consumer buffer from the producer's queued
+// buffers, freeing each producer buffer once it is used up. The producer
+// buffers never reach the consumer, nor does their user_data.
+struct CopyingConnection {
+    audio_connection_t core;
+    audio_buffer_t* current_producer_buffer;
+    uint32_t current_producer_buffer_pos;
+};
+
+audio_buffer_t* copyingConsumerTake(audio_connection_t* connection, bool block) {
+    CopyingConnection* cc = reinterpret_cast<CopyingConnection*>(connection);
+    audio_buffer_t* buffer = get_free_audio_buffer(connection->consumer_pool, block);
+    if (!buffer) {
+        return nullptr;
+    }
+    const uint stride = buffer->format->sample_stride;
+    uint32_t pos = 0;
+    while (pos < buffer->max_sample_count) {
+        if (!cc->current_producer_buffer) {
+            cc->current_producer_buffer = get_full_audio_buffer(connection->producer_pool, block);
+            if (!cc->current_producer_buffer) {
+                if (pos == 0) {
+                    queue_free_audio_buffer(connection->consumer_pool, buffer);
+                    return nullptr;
+                }
+                break;
+            }
+            cc->current_producer_buffer_pos = 0;
+        }
+        audio_buffer_t* source = cc->current_producer_buffer;
+        const uint32_t frames = std::min(buffer->max_sample_count - pos,
+                                         source->sample_count - cc->current_producer_buffer_pos);
+        std::copy_n(source->buffer->bytes + cc->current_producer_buffer_pos * stride, frames * stride,
+                    buffer->buffer->bytes + pos * stride);
+        pos += frames;
+        cc->current_producer_buffer_pos += frames;
+        if (cc->current_producer_buffer_pos == source->sample_count) {
+            queue_free_audio_buffer(connection->producer_pool, source);
+            cc->current_producer_buffer = nullptr;
+        }
+    }
+    buffer->sample_count = pos;
+    return buffer;
+}
+
+void copyingConsumerGive(audio_connection_t* connection, audio_buffer_t* buffer) {
+    queue_free_audio_buffer(connection->consumer_pool, buffer);
+}
+
+// Static like pico-extras' connections, so a hooked callback survives a reconnect
+CopyingConnection s_i2sConnection = {
+    {&defaultProducerTake, &defaultProducerGive,
+     &copyingConsumerTake, &copyingConsumerGive,
+     nullptr, nullptr},
+    nullptr, 0
+};
+
+// The consumer pool audio_i2s_connect_extra() allocates, in static memory
+audio_buffer_pool_t s_consumerPool = {};
+audio_buffer_t s_consumerBuffers[MAX_CONSUMER_BUFFERS] = {};
+mem_buffer_t s_consumerMem[MAX_CONSUMER_BUFFERS] = {};
+uint8_t s_consumerBytes[MAX_CONSUMER_BUFFERS][MAX_CONSUMER_FRAMES * MAX_CHANNELS * sizeof(int16_t)];
+audio_buffer_format_t s_consumerFormat = {};
+
+// The connection I2S takes its buffers through (nullptr before a connect)
+audio_connection_t* s_connection = nullptr;
+
+template <typename Call>
+auto runHandler(Call call) {
+    const bool wasInHandler = s_inHandler;
+    s_inHandler = true;
+    const Clock::time_point start = Clock::now();
+    auto result = call();
+    const uint64_t ns = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now() - start).count());
+    s_inHandler = wasInHandler;
+    ++s_handlerStats.calls;
+    s_handlerStats.totalNs += ns;
+    s_handlerStats.peakNs = std::max(s_handlerStats.peakNs, ns);
+    return result;
+}
+
+void dispatchPending() {
+    if (s_inHandler || s_interruptsDisabled) {
+        return;
+    }
+    for (bool ran = true; ran;) {
+        ran = false;
+        for (uint irq = 0; irq < IRQ_COUNT; ++irq) {
+            if (s_irqPending[irq] && s_irqEnabled[irq] && s_handlers[irq]) {
+                s_irqPending[irq] = false;
+                runHandler([irq] { s_handlers[irq](); return true; });
+                ran = true;
+            }
+        }
+    }
+}
+
+uint64_t framesToUs(uint64_t frames) {
+    return (frames * 1000000 + s_i2sFormat.sample_freq - 1) / s_i2sFormat.sample_freq;
+}
+
+uint64_t usToFrames(uint64_t us) {
+    return us * s_i2sFormat.sample_freq / 1000000;
+}
+
+void deliver(const int16_t* samples, size_t frames) {
+    static const int16_t silence[SILENCE_FRAMES * MAX_CHANNELS] = {};
+    const uint channels = std::min<uint>(s_i2sFormat.channel_count, MAX_CHANNELS);
+    s_frames += frames;
+    if (!s_sink) {
+        return;
+    }
+    if (samples) {
+        s_sink(samples, frames, channels, s_sinkContext);
+        return;
+    }
+    while (frames > 0) {
+        const size_t chunk = std::min<size_t>(frames, SILENCE_FRAMES);
+        s_sink(silence, chunk, channels, s_sinkContext);
+        frames -= chunk;
+    }
+}
+
+// audio_start_dma_transfer(): the next queued buffer, or silence
+void startTransfer() {
+    audio_buffer_t* buffer = s_connection ? take_audio_buffer(&s_consumerPool, false) : nullptr;
+    s_playing = buffer;
+    s_transferStart = s_frames;
+    s_transferFrames = buffer ? buffer->sample_count : SILENCE_FRAMES;
+}
+
+// Send the first @p frames of the transfer and give its buffer back
+void finishTransfer(uint32_t frames) {
+    deliver(s_playing ? reinterpret_cast<const int16_t*>(s_playing->buffer->bytes) : nullptr, frames);
+    if (s_playing) {
+        audio_buffer_t* buffer = s_playing;
+        s_playing = nullptr;
+        give_audio_buffer(&s_consumerPool, buffer);
+    }
+}
+
+// The I2S DMA IRQ
+void completeTransfer() {
+    const bool wasInHandler = s_inHandler;
+    s_inHandler = true;
+    finishTransfer(s_transferFrames);
+    startTransfer();
+    s_inHandler = wasInHandler;
+    dispatchPending();
+}
+
+void runTimer(size_t slot) {
+    repeating_timer_t* timer = s_timers[slot].timer;
+    const bool again = runHandler([timer] { return timer->callback(timer); });
+
+    // The callback may have added or cancelled timers
+    for (size_t i = 0; i < s_timerCount; ++i) {
+        if (s_timers[i].timer == timer) {
+            if (again) {
+                s_timers[i].dueUs = s_nowUs + static_cast<uint64_t>(std::abs(timer->delay_us));
+            } else {
+                s_timers[i] = s_timers[--s_timerCount];
+            }
+            break;
+        }
+    }
+    dispatchPending();
+}
+
+} // namespace
+
+void setI2sSink(I2sSink sink, void* context) {
+    s_sink = sink;
+    s_sinkContext = context;
+}
+
+void reset() {
+    s_nowUs = 0;
+    std::fill(std::begin(s_handlers), std::end(s_handlers), nullptr);
+    std::fill(std::begin(s_irqEnabled), std::end(s_irqEnabled), false);
+    std::fill(std::begin(s_irqPending), std::end(s_irqPending), false);
+    s_userIrqsClaimed = 0;
+    s_interruptsDisabled = false;
+    s_inHandler = false;
+    s_handlerStats = HandlerStats{};
+    s_timerCount = 0;
+    s_dmaClaimed = 0;
+    s_smClaimed[0] = s_smClaimed[1] = 0;
+    s_dma = dma_hw_t{};
+    s_i2sEnabled = false;
+    s_playing = nullptr;
+    s_transferStart = 0;
+    s_transferFrames = 0;
+    s_frames = 0;
+    // The callbacks stay: a consumer_pool_take hook outlives its controller
+    if (s_connection) {
+        s_connection->producer_pool = nullptr;
+        s_connection->consumer_pool = nullptr;
+        s_connection = nullptr;
+    }
+    s_i2sConnection.current_producer_buffer = nullptr;
+    s_i2sConnection.current_producer_buffer_pos = 0;
+    s_consumerPool = audio_buffer_pool_t{};
+}
+
+uint64_t nowUs() {
+    return s_nowUs;
+}
+
+void runUntil(uint64_t us) {
+    for (;;) {
+        // Earliest event; a DMA completion goes before a timer due at the same time
+        size_t timer = MAX_TIMERS;
+        for (size_t i = 0; i < s_timerCount; ++i) {
+            if (timer == MAX_TIMERS || s_timers[i].dueUs < s_timers[timer].dueUs) {
+                timer = i;
+            }
+        }
+        const uint64_t dmaUs = s_i2sEnabled ? framesToUs(s_transferStart + s_transferFrames) : UINT64_MAX;
+        const uint64_t timerUs = timer < MAX_TIMERS ? s_timers[timer].dueUs : UINT64_MAX;
+        const uint64_t next = std::min(dmaUs, timerUs);
+        if (next > us) {
+            break;
+        }
+
+        s_nowUs = std::max(s_nowUs, next);
+        if (dmaUs <= timerUs) {
+            completeTransfer();
+        } else {
+            runTimer(timer);
+        }
+    }
+    s_nowUs = std::max(s_nowUs, us);
+}
+
+HandlerStats takeHandlerStats() {
+    const HandlerStats stats = s_handlerStats;
+    s_handlerStats = HandlerStats{};
+    return stats;
+}
+
+} // namespace Exterminate::Host
+
+using namespace Exterminate::Host;
+
+// Registers
+
+dma_hw_t* const dma_hw = &s_dma;
+pio_hw_t* const pio0 = &s_pio[0];
+pio_hw_t* const pio1 = &s_pio[1];
+adc_hw_t* const adc_hw = &s_adc;
+qmi_hw_t* const qmi_hw = &s_qmi;
+xip_ctrl_hw_t* const xip_ctrl_hw = &s_xipCtrl;
+m33_hw_t* const m33_hw = &s_m33;
+
+uint32_t host_cycle_count(void) {
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count());
+}
+
+uint32_t clock_get_hz(enum clock_index clk_index) {
+    (void)clk_index;
+    return CLK_SYS_HZ;
+}
+
+// pico/time.h
+
+uint32_t time_us_32(void) {
+    return static_cast<uint32_t>(s_nowUs);
+}
+
+uint64_t time_us_64(void) {
+    return s_nowUs;
+}
+
+absolute_time_t get_absolute_time(void) {
+    return s_nowUs;
+}
+
+absolute_time_t make_timeout_time_us(uint64_t us) {
+    return s_nowUs + us;
+}
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void* user_data,
+                            repeating_timer_t* out) {
+    if (s_timerCount == MAX_TIMERS) {
+        return false;
+    }
+    out->delay_us = delay_us;
+    out->alarm_id = s_nextAlarmId++;
+    out->callback = callback;
+    out->user_data = user_data;
+    s_timers[s_timerCount++] = Timer{out, s_nowUs + static_cast<uint64_t>(std::abs(delay_us))};
+    return true;
+}
+
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void* user_data,
+                            repeating_timer_t* out) {
+    return add_repeating_timer_us(static_cast<int64_t>(delay_ms) * 1000, callback, user_data, out);
+}
+
+bool cancel_repeating_timer(repeating_timer_t* timer) {
+    for (size_t i = 0; i < s_timerCount; ++i) {
+        if (s_timers[i].timer == timer) {
+            s_timers[i] = s_timers[--s_timerCount];
+            return true;
+        }
+    }
+    return false;
+}
+
+// Waiting lets simulated time, and whatever is due in it, run
+void busy_wait_us_32(uint32_t delay_us) {
+    runUntil(s_nowUs + delay_us);
+}
+
+void sleep_us(uint64_t us) {
+    runUntil(s_nowUs + us);
+}
+
+void sleep_ms(uint32_t ms) {
+    runUntil(s_nowUs + static_cast<uint64_t>(ms) * 1000);
+}
+
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp) {
+    runUntil(timeout_timestamp);
+    return true;
+}
+
+// pico/multicore.h
+
+void multicore_launch_core1(void (*entry)(void)) {
+    (void)entry;
+    std::fprintf(stderr, "PicoHost: ERROR - core1 is not simulated, use StreamingMode::Timer\n");
+    std::abort();
+}
+
+void multicore_reset_core1(void) {
+}
+
+void multicore_lockout_victim_init(void) {
+}
+
+// hardware/sync.h
+
+uint32_t save_and_disable_interrupts(void) {
+    const uint32_t status = s_interruptsDisabled ? 1 : 0;
+    s_interruptsDisabled = true;
+    return status;
+}
+
+void restore_interrupts(uint32_t status) {
+    s_interruptsDisabled = status != 0;
+    dispatchPending();
+}
+
+spin_lock_t* spin_lock_init(uint lock_num) {
+    return &s_spinLocks[lock_num % 32];
+}
+
+// hardware/irq.h
+
+int user_irq_claim_unused(bool required) {
+    for (uint i = 0; i < USER_IRQ_COUNT; ++i) {
+        if (!(s_userIrqsClaimed & (1u << i))) {
+            s_userIrqsClaimed |= 1u << i;
+            return static_cast<int>(FIRST_USER_IRQ + i);
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "PicoHost: ERROR - No user IRQs left\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void user_irq_unclaim(uint irq_num) {
+    s_userIrqsClaimed &= ~(1u << (irq_num - FIRST_USER_IRQ));
+}
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    s_handlers[num] = handler;
+}
+
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {
+    (void)order_priority;
+    s_handlers[num] = handler;
+}
+
+void irq_remove_handler(uint num, irq_handler_t handler) {
+    if (s_handlers[num] == handler) {
+        s_handlers[num] = nullptr;
+    }
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority) {
+    (void)num;
+    (void)hardware_priority;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    s_irqEnabled[num] = enabled;
+    dispatchPending();
+}
+
+void irq_set_pending(uint num) {
+    s_irqPending[num] = true;
+    dispatchPending();
+}
+
+// hardware/dma.h
+
+int dma_claim_unused_channel(bool required) {
+    for (uint channel = 0; channel < NUM_DMA_CHANNELS; ++channel) {
+        if (!(s_dmaClaimed & (1u << channel))) {
+            s_dmaClaimed |= 1u << channel;
+            return static_cast<int>(channel);
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "PicoHost: ERROR - No DMA channels left\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void dma_channel_unclaim(uint channel) {
+    s_dmaClaimed &= ~(1u << channel);
+}
+
+dma_channel_config dma_channel_get_default_config(uint channel) {
+    (void)channel;
+    return dma_channel_config{0};
+}
+
+void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size) {
+    (void)c;
+    (void)size;
+}
+
+void channel_config_set_read_increment(dma_channel_config* c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_write_increment(dma_channel_config* c, bool incr) {
+    (void)c;
+    (void)incr;
+}
+
+void channel_config_set_dreq(dma_channel_config* c, uint dreq) {
+    (void)c;
+    (void)dreq;
+}
+
+void channel_config_set_chain_to(dma_channel_config* c, uint chain_to) {
+    (void)c;
+    (void)chain_to;
+}
+
+void channel_config_set_irq_quiet(dma_channel_config* c, bool irq_quiet) {
+    (void)c;
+    (void)irq_quiet;
+}
+
+void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits) {
+    (void)c;
+    (void)write;
+    (void)size_bits;
+}
+
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint transfer_count, bool trigger) {
+    (void)trigger;
+    dma_channel_hw_t& hw = s_dma.ch[channel];
+    hw.al1_ctrl = config->ctrl;
+    hw.write_addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(write_addr));
+    hw.read_addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(read_addr));
+    hw.transfer_count = transfer_count;
+}
+
+void dma_channel_set_read_addr(uint channel, const volatile void* read_addr, bool trigger) {
+    (void)trigger;
+    s_dma.ch[channel].read_addr = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(read_addr));
+}
+
+uint32_t dma_encode_endless_transfer_count(void) {
+    return 0xF0000000u;
+}
+
+void dma_channel_abort(uint channel) {
+    (void)channel;
+}
+
+bool dma_channel_is_busy(uint channel) {
+    (void)channel;
+    return false;
+}
+
+void dma_irqn_set_channel_enabled(uint irq_index, uint channel, bool enabled) {
+    (void)irq_index;
+    (void)channel;
+    (void)enabled;
+}
+
+bool dma_irqn_get_channel_status(uint irq_index, uint channel) {
+    (void)irq_index;
+    (void)channel;
+    return false;
+}
+
+void dma_irqn_acknowledge_channel(uint irq_index, uint channel) {
+    (void)irq_index;
+    (void)channel;
+}
+
+// hardware/pio.h
+
+PIO pio_get_instance(uint instance) {
+    return instance ? pio1 : pio0;
+}
+
+int pio_claim_unused_sm(PIO pio, bool required) {
+    uint32_t& claimed = s_smClaimed[pio == pio1 ? 1 : 0];
+    for (uint sm = 0; sm < SM_COUNT; ++sm) {
+        if (!(claimed & (1u << sm))) {
+            claimed |= 1u << sm;
+            return static_cast<int>(sm);
+        }
+    }
+    if (required) {
+        std::fprintf(stderr, "PicoHost: ERROR - No PIO state machines left\n");
+        std::abort();
+    }
+    return -1;
+}
+
+void pio_sm_unclaim(PIO pio, uint sm) {
+    s_smClaimed[pio == pio1 ? 1 : 0] &= ~(1u << sm);
+}
+
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled) {
+    (void)pio;
+    (void)sm;
+    (void)enabled;
+}
+
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx) {
+    return (pio == pio1 ? 8 : 0) + sm + (is_tx ? 0 : 4);
+}
+
+// hardware/gpio.h and hardware/adc.h: pins and the ADC do nothing
+
+void gpio_init(uint gpio) {
+    (void)gpio;
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    (void)gpio;
+    (void)out;
+}
+
+void gpio_put(uint gpio, bool value) {
+    (void)gpio;
+    (void)value;
+}
+
+void gpio_set_function(uint gpio, enum gpio_function fn) {
+    (void)gpio;
+    (void)fn;
+}
+
+void adc_init(void) {
+}
+
+void adc_gpio_init(uint gpio) {
+    (void)gpio;
+}
+
+void adc_select_input(uint input) {
+    (void)input;
+}
+
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift) {
+    (void)en;
+    (void)dreq_en;
+    (void)dreq_thresh;
+    (void)err_in_fifo;
+    (void)byte_shift;
+}
+
+void adc_set_clkdiv(float clkdiv) {
+    (void)clkdiv;
+}
+
+void adc_run(bool run) {
+    (void)run;
+}
+
+void adc_fifo_drain(void) {
+}
+
+// pico/audio.h: pico-extras' list operations
+
+audio_buffer_t* get_free_audio_buffer(audio_buffer_pool_t* context, bool block) {
+    (void)block;
+    audio_buffer_t* buffer = context->free_list;
+    if (buffer) {
+        context->free_list = buffer->next;
+        buffer->next = nullptr;
+    }
+    return buffer;
+}
+
+void queue_free_audio_buffer(audio_buffer_pool_t* context, audio_buffer_t* ab) {
+    ab->next = context->free_list;
+    context->free_list = ab;
+}
+
+audio_buffer_t* get_full_audio_buffer(audio_buffer_pool_t* context, bool block) {
+    (void)block;
+    audio_buffer_t* buffer = context->prepared_list;
+    if (buffer) {
+        context->prepared_list = buffer->next;
+        if (!context->prepared_list) {
+            context->prepared_list_tail = nullptr;
+        }
+        buffer->next = nullptr;
+    }
+    return buffer;
+}
+
+void queue_full_audio_buffer(audio_buffer_pool_t* context, audio_buffer_t* ab) {
+    ab->next = nullptr;
+    if (context->prepared_list_tail) {
+        context->prepared_list_tail->next = ab;
+    } else {
+        context->prepared_list = ab;
+    }
+    context->prepared_list_tail = ab;
+}
+
+audio_buffer_t* take_audio_buffer(audio_buffer_pool_t* ac, bool block) {
+    audio_connection_t* connection = ac->connection;
+    return ac->type == audio_buffer_pool::ac_producer ? connection->producer_pool_take(connection, block)
+                                                      : connection->consumer_pool_take(connection, block);
+}
+
+void give_audio_buffer(audio_buffer_pool_t* ac, audio_buffer_t* buffer) {
+    audio_connection_t* connection = ac->connection;
+    if (ac->type == audio_buffer_pool::ac_producer) {
+        connection->producer_pool_give(connection, buffer);
+    } else {
+        connection->consumer_pool_give(connection, buffer);
+    }
+}
+
+// pico/audio_i2s.h
+
+const audio_format_t* audio_i2s_setup(const audio_format_t* intended_audio_format,
+                                      const audio_i2s_config_t* config) {
+    (void)config;
+    if (intended_audio_format->format != AUDIO_BUFFER_FORMAT_PCM_S16 ||
+        intended_audio_format->channel_count == 0 || intended_audio_format->channel_count > MAX_CHANNELS) {
+        return nullptr;
+    }
+    s_i2sFormat = *intended_audio_format;
+    return &s_i2sFormat;
+}
+
+bool audio_i2s_connect_extra(audio_buffer_pool_t* producer, bool buffer_on_give, uint buffer_count,
+                             uint samples_per_buffer, audio_connection_t* connection) {
+    (void)buffer_on_give;
+    if (buffer_count == 0 || buffer_count > MAX_CONSUMER_BUFFERS || samples_per_buffer == 0 ||
+        samples_per_buffer > MAX_CONSUMER_FRAMES) {
+        return false;
+    }
+
+    // audio_new_consumer_pool(): buffer_count free buffers in the producer's format
+    s_consumerFormat = audio_buffer_format_t{producer->format, static_cast<uint16_t>(
+        s_i2sFormat.channel_count * sizeof(int16_t))};
+    s_consumerPool = audio_buffer_pool_t{};
+    s_consumerPool.type = audio_buffer_pool::ac_consumer;
+    s_consumerPool.format = producer->format;
+    for (uint i = 0; i < buffer_count; ++i) {
+        s_consumerMem[i] = mem_buffer_t{samples_per_buffer * s_consumerFormat.sample_stride, s_consumerBytes[i], 0};
+        s_consumerBuffers[i] = audio_buffer_t{&s_consumerMem[i], &s_consumerFormat, 0, samples_per_buffer, 0, nullptr};
+        queue_free_audio_buffer(&s_consumerPool, &s_consumerBuffers[i]);
+    }
+
+    // audio_complete_connection()
+    s_connection = connection ? connection : &s_i2sConnection.core;
+    s_connection->producer_pool = producer;
+    s_connection->consumer_pool = &s_consumerPool;
+    producer->connection = s_connection;
+    s_consumerPool.connection = s_connection;
+    return true;
+}
+
+bool audio_i2s_connect(audio_buffer_pool_t* producer) {
+    return audio_i2s_connect_extra(producer, false, 2, 256, nullptr);
+}
+
+void audio_i2s_set_enabled(bool enabled) {
+    if (enabled == s_i2sEnabled) {
+        return;
+    }
+    s_i2sEnabled = enabled;
+
+    const uint64_t frameNow = usToFrames(s_nowUs);
+    if (!enabled) {
+        // The part of the buffer in flight already sent; the buffer goes back
+        const uint64_t played = frameNow > s_transferStart ? frameNow - s_transferStart : 0;
+        finishTransfer(static_cast<uint32_t>(std::min<uint64_t>(played, s_transferFrames)));
+        return;
+    }
+
+    // Silence while disabled, then the first transfer starts at once
+    if (frameNow > s_frames) {
+        deliver(nullptr, static_cast<size_t>(frameNow - s_frames));
+    }
+    const bool wasInHandler = s_inHandler;
+    s_inHandler = true;
+    startTransfer();
+    s_inHandler = wasInHandler;
+    dispatchPending();
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "pico/types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Exterminate::Host {
+
+/**
+ * @brief Simulated RP2350 behind the stand-in SDK headers in tools/host/sdk
+ *
+ * Lets the firmware's AudioController run unmodified on a host. Time is
+ * simulated and only moves in runUntil(), which fires, in time order,
+ * the repeating timers and the completions of the I2S DMA transfers.
+ * Each completion does what pico-extras' DMA IRQ does: gives the
+ * finished buffer back to the I2S consumer pool, then takes the next one
+ * through the connection's consumer_pool_take (pico-extras' 256-sample
+ * silence buffer if none is queued). The consumer pool and the default
+ * copying connection of audio_i2s_connect() are modelled as pico-extras
+ * has them, so a producer buffer only reaches the consumer if the
+ * firmware connects a pass-through of its own. An IRQ raised with irq_set_pending() runs
+ * as soon as no handler is running and interrupts are enabled, as it
+ * would on one core. The renders are therefore the same on every host
+ * and at every host speed.
+ *
+ * Hardware the audio path can do without is only modelled as registers:
+ * no DMA transfer, PSRAM access or ADC conversion ever happens, so the
+ * clip cache, the clip prefetcher, direct playback and the Dalek voice
+ * stay off, and the core1 streaming mode is not available.
+ *
+ * Cycle counts (CycleCounter) are nanoseconds of the host's steady clock.
+ */
+
+/**
+ * @brief Receives every frame I2S sends, in order
+ *
+ * Silence while I2S is disabled (standby) is delivered as zero frames,
+ * so the output stays aligned with simulated time.
+ */
+using I2sSink = void (*)(const int16_t* samples, size_t frames, uint channels, void* context);
+
+void setI2sSink(I2sSink sink, void* context);
+
+/**
+ * @brief Return to power-on: time 0, I2S off, no timers, IRQ handlers or claims
+ *
+ * For running several controllers in one process, each after the
+ * previous one is destroyed. The firmware never destroys its
+ * AudioController, so shutdown() leaves its streaming timer running;
+ * reset() drops it.
+ */
+void reset();
+
+/**
+ * @brief Current simulated time
+ */
+uint64_t nowUs();
+
+/**
+ * @brief Advance simulated time to @p us, running every event due on the way
+ */
+void runUntil(uint64_t us);
+
+/**
+ * @brief Host time spent in IRQ handlers and timer callbacks
+ */
+struct HandlerStats {
+    uint32_t calls;
+    uint64_t totalNs;
+    uint64_t peakNs;    ///< Longest single call
+};
+
+/**
+ * @brief Return the handler time since the last call and start a new count
+ *
+ * The I2S DMA completion itself is not included, only what it triggers.
+ */
+HandlerStats takeHandlerStats();
+
+} // namespace Exterminate::Host
@@ -0,0 +1,119 @@
+#include "WavFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace Exterminate::Host {
+
+namespace {
+
+uint16_t le16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+uint32_t le32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+void put16(std::vector<uint8_t>& out, uint16_t value) {
+    out.push_back(static_cast<uint8_t>(value));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+void put32(std::vector<uint8_t>& out, uint32_t value) {
+    put16(out, static_cast<uint16_t>(value));
+    put16(out, static_cast<uint16_t>(value >> 16));
+}
+
+} // namespace
+
+bool readWav(const std::string& path, WavFile& wav) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "WavFile: ERROR - Cannot open %s\n", path.c_str());
+        return false;
+    }
+    const std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (bytes.size() < 12 || std::memcmp(bytes.data(), "RIFF", 4) != 0 ||
+        std::memcmp(bytes.data() + 8, "WAVE", 4) != 0) {
+        std::fprintf(stderr, "WavFile: ERROR - %s is not a WAV file\n", path.c_str());
+        return false;
+    }
+
+    uint16_t channels = 0;
+    uint16_t bits = 0;
+    const uint8_t* data = nullptr;
+    size_t dataBytes = 0;
+
+    // Walk the chunks; each is padded to an even length
+    size_t offset = 12;
+    while (offset + 8 <= bytes.size()) {
+        const uint8_t* chunk = bytes.data() + offset;
+        const size_t length = std::min<size_t>(le32(chunk + 4), bytes.size() - offset - 8);
+        if (std::memcmp(chunk, "fmt ", 4) == 0 && length >= 16) {
+            if (le16(chunk + 8) != 1) {
+                std::fprintf(stderr, "WavFile: ERROR - %s is not PCM\n", path.c_str());
+                return false;
+            }
+            channels = le16(chunk + 10);
+            wav.sampleRate = le32(chunk + 12);
+            bits = le16(chunk + 22);
+        } else if (std::memcmp(chunk, "data", 4) == 0) {
+            data = chunk + 8;
+            dataBytes = length;
+        }
+        offset += 8 + length + (length & 1);
+    }
+
+    if (!data || channels == 0 || bits != 16) {
+        std::fprintf(stderr, "WavFile: ERROR - %s needs a 16-bit PCM data chunk\n", path.c_str());
+        return false;
+    }
+
+    const size_t frames = dataBytes / (2u * channels);
+    wav.channels = 1;
+    wav.samples.resize(frames);
+    for (size_t i = 0; i < frames; ++i) {
+        int32_t sum = 0;
+        for (uint16_t c = 0; c < channels; ++c) {
+            sum += static_cast<int16_t>(le16(data + (i * channels + c) * 2));
+        }
+        wav.samples[i] = static_cast<int16_t>(sum / channels);
+    }
+    return true;
+}
+
+bool writeWav(const std::string& path, const WavFile& wav) {
+    const uint32_t dataBytes = static_cast<uint32_t>(wav.samples.size() * 2);
+    std::vector<uint8_t> out;
+    out.reserve(44 + dataBytes);
+
+    out.insert(out.end(), {'R', 'I', 'F', 'F'});
+    put32(out, 36 + dataBytes);
+    out.insert(out.end(), {'W', 'A', 'V', 'E', 'f', 'm', 't', ' '});
+    put32(out, 16);
+    const uint16_t channels = std::max<uint16_t>(wav.channels, 1);
+    put16(out, 1);                    // PCM
+    put16(out, channels);
+    put32(out, wav.sampleRate);
+    put32(out, wav.sampleRate * 2 * channels);   // Byte rate
+    put16(out, 2 * channels);         // Block align
+    put16(out, 16);
+    out.insert(out.end(), {'d', 'a', 't', 'a'});
+    put32(out, dataBytes);
+    for (int16_t sample : wav.samples) {
+        put16(out, static_cast<uint16_t>(sample));
+    }
+
+    std::ofstream file(path, std::ios::binary);
+    if (!file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()))) {
+        std::fprintf(stderr, "WavFile: ERROR - Cannot write %s\n", path.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace Exterminate::Host
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Exterminate::Host {
+
+/**
+ * @brief PCM16 audio loaded from or saved to a WAV file
+ */
+struct WavFile {
+    uint32_t sampleRate = 0;
+    uint16_t channels = 1;          ///< Interleaved in samples
+    std::vector<int16_t> samples;
+};
+
+/**
+ * @brief Read a 16-bit PCM WAV; multi-channel files are averaged to mono
+ *
+ * @p wav.channels is always 1 afterwards.
+ *
+ * @return false (after printing why) if the file is missing or not 16-bit PCM
+ */
+bool readWav(const std::string& path, WavFile& wav);
+
+/**
+ * @brief Write @p wav as a 16-bit PCM WAV of @p wav.channels channels
+ */
+bool writeWav(const std::string& path, const WavFile& wav);
+
+} // namespace Exterminate::Host
@@ -0,0 +1,640 @@
+// Run the firmware's AudioController on the host, against the simulated
+// RP2350 of PicoHost: clips and triggers go in, the exact stream I2S
+// would send comes out as a stereo WAV. Built-in scenarios exercise each
+// sample path on synthetic test clips; they can be checked bit for bit
+// against the golden renders in tools/host/golden, and timed per buffer.
+//
+//   audio_render --list
+//   audio_render --scenario <name> <out.wav> [--golden <file.wav>] [--check-playout]
+//   audio_render --bench [--repeat <n>] [scenario...]
+//   audio_render [options] <out.wav> <ms>:<command>[=<value>]...
+//
+// Options: --clip <file.wav> (repeatable; index 0 is the first, replaces
+// the test clips), --buffer <samples>, --depth <count>[:<max>],
+// --no-dsp, --preserve-tempo, --no-hot-start, --timer-only,
+// --length <ms>, --verbose (keep the firmware's console output),
+// --check-playout (fail unless the fill stamps reached I2S: the LED
+// intensity was published with a plausible fill lead, and a trigger was
+// hot started).
+//
+// Commands: play=<clip>[@gain], queue=<clip>[@gain], synth=zap|hum|beep,
+// release, pitch=<scale>, synth-pitch=<scale>, volume=<0-1>, random,
+// stop, pause, resume. release and synth-pitch act on the latest synth note.
+//
+// Clip cache, prefetch and direct playback need hardware the simulation
+// does not have, and are off. Depth is fixed unless --depth gives a
+// larger maximum: adaptive depth follows the host's fill time, so its
+// renders are not reproducible.
+
+#include "AudioController.h"
+#include "PicoHost.h"
+#include "WavFile.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace Exterminate;
+
+namespace {
+
+FILE* s_report = stdout;
+SynthEngine::NoteId s_lastNote = SynthEngine::NO_NOTE;  // Note that release and synth-pitch act on
+
+constexpr uint32_t OUTPUT_RATE = 44100;
+constexpr uint32_t MAX_RENDER_MS = 60000;   // For renders that run until idle
+constexpr uint32_t IDLE_TAIL_MS = 50;
+constexpr size_t WAV_HEADER_BYTES = 44;     // As Host::writeWav() lays it out
+
+// ---------------------------------------------------------------------------
+// Clips
+
+struct Clip {
+    std::string name;
+    uint32_t sampleRate;
+    std::vector<int16_t> samples;
+    std::vector<uint8_t> envelope;
+    uint32_t loopStart;
+    uint32_t loopEnd;
+};
+
+// Loudness per ENVELOPE_BLOCK_SAMPLES block, as tools/audio_to_pcm_header.py computes it
+void computeEnvelope(Clip& clip) {
+    const size_t block = Audio::ENVELOPE_BLOCK_SAMPLES;
+    clip.envelope.clear();
+    for (size_t start = 0; start < clip.samples.size(); start += block) {
+        double sum = 0.0;
+        for (size_t i = start; i < std::min(start + block, clip.samples.size()); ++i) {
+            const double sample = clip.samples[i] / 32768.0;
+            sum += sample * sample;
+        }
+        const double level = std::min(1.0, std::sqrt(sum / block) * 3.0);
+        clip.envelope.push_back(static_cast<uint8_t>(std::lround(level * 255.0)));
+    }
+}
+
+// Integer-only synthesis, so the test clips are identical on every host
+std::vector<Clip> makeTestClips() {
+    std::vector<Clip> clips;
+
+    // 0: 400 ms sweep from 300 Hz to 1.2 kHz with a short attack and release
+    Clip tone{"tone", 44100, {}, {}, 0, 0};
+    const uint32_t toneSamples = 17640;
+    const uint32_t attack = 441;
+    const uint32_t release = 2205;
+    uint32_t phase = 0;
+    for (uint32_t i = 0; i < toneSamples; ++i) {
+        const uint64_t hz = 300 + (900ull * i) / toneSamples;
+        phase += static_cast<uint32_t>((hz << 32) / tone.sampleRate);
+        int32_t amplitude = 20000;
+        if (i < attack) {
+            amplitude = amplitude * static_cast<int32_t>(i) / static_cast<int32_t>(attack);
+        } else if (i >= toneSamples - release) {
+            amplitude = amplitude * static_cast<int32_t>(toneSamples - i) / static_cast<int32_t>(release);
+        }
+        tone.samples.push_back(static_cast<int16_t>((SineTable::lookup(phase) * amplitude) >> 15));
+    }
+    clips.push_back(tone);
+
+    // 1: 300 ms of decaying noise at 22.05 kHz, for the rate converter
+    Clip noise{"noise", 22050, {}, {}, 0, 0};
+    const uint32_t noiseSamples = 6615;
+    uint32_t state = 0x12345678u;
+    for (uint32_t i = 0; i < noiseSamples; ++i) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        const int32_t remaining = static_cast<int32_t>(noiseSamples - i);
+        const int32_t amplitude = static_cast<int32_t>((24000ll * remaining * remaining) /
+                                                       (static_cast<int64_t>(noiseSamples) * noiseSamples));
+        noise.samples.push_back(static_cast<int16_t>((static_cast<int16_t>(state >> 16) * amplitude) >> 15));
+    }
+    clips.push_back(noise);
+
+    // 2: 100 Hz sawtooth looped whole, for looping and gapless queueing
+    Clip hum{"hum", 44100, {}, {}, 0, 0};
+    const uint32_t period = 441;
+    for (uint32_t i = 0; i < 10 * period; ++i) {
+        hum.samples.push_back(static_cast<int16_t>(static_cast<int32_t>(i % period) * 24000 / period - 12000));
+    }
+    hum.loopEnd = static_cast<uint32_t>(hum.samples.size());
+    clips.push_back(hum);
+
+    for (Clip& clip : clips) {
+        computeEnvelope(clip);
+    }
+    return clips;
+}
+
+bool loadClip(const std::string& path, Clip& clip) {
+    Host::WavFile wav;
+    if (!Host::readWav(path, wav)) {
+        return false;
+    }
+    clip = Clip{path, wav.sampleRate, std::move(wav.samples), {}, 0, 0};
+    computeEnvelope(clip);
+    return true;
+}
+
+std::vector<Audio::AudioFile> makeAudioFiles(const std::vector<Clip>& clips) {
+    std::vector<Audio::AudioFile> files;
+    for (const Clip& clip : clips) {
+        files.push_back(Audio::AudioFile{
+            clip.name.c_str(), clip.samples.data(), clip.samples.size(), clip.samples.size() * sizeof(int16_t),
+            clip.sampleRate, 1, 16, Audio::AudioCodec::PCM16, nullptr, clip.envelope.data(),
+            clip.loopStart, clip.loopEnd});
+    }
+    return files;
+}
+
+// ---------------------------------------------------------------------------
+// Triggers
+
+struct Event {
+    uint32_t atMs;
+    std::string command;
+    std::string value;
+};
+
+bool parseEvent(const char* text, Event& event) {
+    char* end = nullptr;
+    const unsigned long atMs = std::strtoul(text, &end, 10);
+    if (end == text || *end != ':') {
+        return false;
+    }
+    const std::string body(end + 1);
+    const size_t equals = body.find('=');
+    event = Event{static_cast<uint32_t>(atMs), body.substr(0, equals),
+                  equals == std::string::npos ? std::string() : body.substr(equals + 1)};
+    return !event.command.empty();
+}
+
+bool applyEvent(AudioController& controller, const Event& event, size_t clipCount) {
+    const std::string& command = event.command;
+    const float number = static_cast<float>(std::atof(event.value.c_str()));
+
+    if (command == "play" || command == "queue") {
+        const size_t clip = std::strtoul(event.value.c_str(), nullptr, 10);
+        const size_t at = event.value.find('@');
+        const float gain = at == std::string::npos ? 1.0f : static_cast<float>(std::atof(event.value.c_str() + at + 1));
+        if (clip >= clipCount) {
+            std::fprintf(stderr, "audio_render: no clip %zu\n", clip);
+            return false;
+        }
+        const Audio::AudioIndex index = static_cast<Audio::AudioIndex>(clip);
+        if (command == "play") {
+            controller.playAudio(index, gain);
+        } else {
+            controller.queueAudio(index, gain);
+        }
+    } else if (command == "synth") {
+        const SynthPatch* patch = event.value == "zap" ? &SynthPatches::ZAP
+                                : event.value == "hum" ? &SynthPatches::MOTOR_HUM
+                                : event.value == "beep" ? &SynthPatches::BEEP : nullptr;
+        if (!patch) {
+            std::fprintf(stderr, "audio_render: unknown patch '%s'\n", event.value.c_str());
+            return false;
+        }
+        s_lastNote = controller.playSynth(*patch);
+    } else if (command == "release") {
+        controller.releaseSynth(s_lastNote);
+    } else if (command == "pitch") {
+        controller.setSpeechPitch(number);
+    } else if (command == "synth-pitch") {
+        controller.setSynthPitch(s_lastNote, number);
+    } else if (command == "volume") {
+        controller.setVolume(number);
+    } else if (command == "random") {
+        controller.playRandomAudio();
+    } else if (command == "stop") {
+        controller.stopAudio();
+    } else if (command == "pause") {
+        controller.pauseAudio();
+    } else if (command == "resume") {
+        controller.resumeAudio();
+    } else {
+        std::fprintf(stderr, "audio_render: unknown command '%s'\n", command.c_str());
+        return false;
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// Scenarios: one sample path each, on the test clips
+
+struct Settings {
+    uint samplesPerBuffer = 128;
+    uint bufferCount = 2;
+    uint maxBufferCount = 2;
+    bool outputDsp = true;
+    bool preserveTempo = false;
+    bool hotStart = true;
+    bool refillOnRelease = true;
+    bool checkPlayout = false;  // Sample the LED intensity every millisecond
+    uint32_t lengthMs = 0;      // 0: until idle after the last trigger
+};
+
+struct Scenario {
+    const char* name;
+    const char* path;
+    bool outputDsp;
+    bool preserveTempo;
+    uint32_t lengthMs;
+    std::vector<const char*> events;
+};
+
+const std::vector<Scenario>& scenarios() {
+    static const std::vector<Scenario> list = {
+        {"silence", "keep-alive silence between triggers", true, false, 100, {}},
+        {"speech", "one clip, no output chain", false, false, 450, {"0:play=0"}},
+        {"speech-dsp", "one clip through the output chain", true, false, 450, {"0:play=0"}},
+        {"resample", "22.05 kHz clip converted to 44.1 kHz", false, false, 350, {"0:play=1"}},
+        {"mix", "clips, a loop, a gapless queue and synth, mixed", true, false, 600,
+         {"0:play=0", "40:play=1@0.7", "90:synth=zap", "150:play=2@0.5", "200:queue=0@0.5",
+          "250:volume=0.6", "550:stop"}},
+        {"polyphony", "every mixer voice busy", true, false, 300,
+         {"0:play=0@0.3", "0:play=1@0.3", "10:play=0@0.3", "10:play=1@0.3", "20:play=2@0.3", "20:play=0@0.3"}},
+        {"synth", "three synth voices and a release", true, false, 400,
+         {"0:synth=zap", "0:synth=beep", "0:synth=hum", "250:release"}},
+        {"bend", "speech bent 1.5x by the mixer's varispeed", false, false, 350, {"0:pitch=1.5", "0:play=0"}},
+        {"bend-stretch", "speech bent 1.5x, tempo kept by TimeStretch", false, true, 500,
+         {"0:pitch=1.5", "0:play=0"}},
+    };
+    return list;
+}
+
+const Scenario* findScenario(const std::string& name) {
+    for (const Scenario& scenario : scenarios()) {
+        if (name == scenario.name) {
+            return &scenario;
+        }
+    }
+    std::fprintf(stderr, "audio_render: unknown scenario '%s' (see --list)\n", name.c_str());
+    return nullptr;
+}
+
+// ---------------------------------------------------------------------------
+// Rendering
+
+struct Render {
+    std::vector<int16_t> samples;   // Interleaved stereo
+    AudioController::AudioStats stats;
+    Host::HandlerStats handlers;
+    uint32_t budgetNs;
+    float peakIntensity;
+    AudioController::IntensitySkew skew;
+};
+
+// Host::runUntil(), sampling the published intensity on the way if asked
+void advance(const AudioController& controller, const Settings& settings, uint64_t us, Render& result) {
+    if (settings.checkPlayout) {
+        for (uint64_t step = Host::nowUs() + 1000; step < us; step += 1000) {
+            Host::runUntil(step);
+            result.peakIntensity = std::max(result.peakIntensity, controller.getAudioIntensity());
+        }
+    }
+    Host::runUntil(us);
+    result.peakIntensity = std::max(result.peakIntensity, controller.getAudioIntensity());
+}
+
+void appendFrames(const int16_t* samples, size_t frames, uint channels, void* context) {
+    std::vector<int16_t>& out = *static_cast<std::vector<int16_t>*>(context);
+    out.insert(out.end(), samples, samples + frames * channels);
+}
+
+bool render(const Settings& settings, const std::vector<Audio::AudioFile>& files, std::vector<Event> events,
+            bool capture, Render& result) {
+    Host::reset();
+    result.samples.clear();
+    result.peakIntensity = 0.0f;
+    Host::setI2sSink(capture ? &appendFrames : nullptr, &result.samples);
+    Audio::setAudioFileTable(files.data(), files.size());
+
+    AudioController::Config config = AudioController::Config::getDefault();
+    config.sampleRate = OUTPUT_RATE;
+    config.samplesPerBuffer = settings.samplesPerBuffer;
+    config.bufferCount = settings.bufferCount;
+    config.maxBufferCount = settings.maxBufferCount;
+    config.streamingMode = AudioController::StreamingMode::Timer;
+    config.refillOnRelease = settings.refillOnRelease;
+    config.hotStart = settings.hotStart;
+    config.clipCache = false;
+    config.prefetch = false;
+    config.outputDsp = settings.outputDsp;
+    config.preserveTempo = settings.preserveTempo;
+
+    bool ok = true;
+    {
+        AudioController controller(config);
+        if (!controller.initialize()) {
+            std::fprintf(stderr, "audio_render: AudioController did not initialize\n");
+            return false;
+        }
+        Host::takeHandlerStats();
+        s_lastNote = SynthEngine::NO_NOTE;
+
+        std::stable_sort(events.begin(), events.end(),
+                         [](const Event& a, const Event& b) { return a.atMs < b.atMs; });
+        uint32_t lastMs = 0;
+        for (const Event& event : events) {
+            advance(controller, settings, event.atMs * 1000ull, result);
+            ok = applyEvent(controller, event, files.size()) && ok;
+            lastMs = event.atMs;
+        }
+
+        if (settings.lengthMs > 0) {
+            advance(controller, settings, settings.lengthMs * 1000ull, result);
+        } else {
+            uint64_t until = lastMs * 1000ull;
+            while ((controller.isPlaying() || controller.getActiveVoiceCount() > 0) &&
+                   until < MAX_RENDER_MS * 1000ull) {
+                until += 10000;
+                advance(controller, settings, until, result);
+            }
+            advance(controller, settings, until + IDLE_TAIL_MS * 1000ull, result);
+        }
+
+        result.stats = controller.getStats();
+        result.skew = controller.getIntensitySkew();
+        result.handlers = Host::takeHandlerStats();
+        result.budgetNs = controller.getFillBudgetCycles();
+        controller.shutdown();
+    }
+    Audio::setAudioFileTable(nullptr, 0);
+    return ok;
+}
+
+Settings scenarioSettings(const Scenario& scenario, Settings settings) {
+    settings.outputDsp = scenario.outputDsp;
+    settings.preserveTempo = scenario.preserveTempo;
+    settings.lengthMs = scenario.lengthMs;
+    return settings;
+}
+
+std::vector<Event> scenarioEvents(const Scenario& scenario) {
+    std::vector<Event> events;
+    for (const char* text : scenario.events) {
+        Event event;
+        parseEvent(text, event);
+        events.push_back(event);
+    }
+    return events;
+}
+
+// ---------------------------------------------------------------------------
+// Golden comparison
+
+bool readBytes(const std::string& path, std::vector<uint8_t>& bytes) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) {
+        std::fprintf(stderr, "audio_render: cannot open %s\n", path.c_str());
+        return false;
+    }
+    bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+bool matchesGolden(const std::string& renderPath, const std::string& goldenPath) {
+    std::vector<uint8_t> rendered;
+    std::vector<uint8_t> golden;
+    if (!readBytes(renderPath, rendered) || !readBytes(goldenPath, golden)) {
+        return false;
+    }
+    const auto mismatch = std::mismatch(rendered.begin(), rendered.end(), golden.begin(), golden.end());
+    if (mismatch.first == rendered.end() && mismatch.second == golden.end()) {
+        std::fprintf(s_report, "audio_render: %s matches %s\n", renderPath.c_str(), goldenPath.c_str());
+        return true;
+    }
+
+    const size_t offset = static_cast<size_t>(mismatch.first - rendered.begin());
+    if (offset < WAV_HEADER_BYTES) {
+        std::fprintf(s_report, "audio_render: MISMATCH - %s and %s differ in format or length\n",
+                     renderPath.c_str(), goldenPath.c_str());
+    } else {
+        const size_t frame = (offset - WAV_HEADER_BYTES) / 4;
+        std::fprintf(s_report, "audio_render: MISMATCH - %s differs from %s from frame %zu (%.2f ms)\n",
+                     renderPath.c_str(), goldenPath.c_str(), frame, frame * 1000.0 / OUTPUT_RATE);
+    }
+    return false;
+}
+
+// ---------------------------------------------------------------------------
+// Playout check: what only works if I2S plays the producer's own buffers
+
+bool checkPlayout(const Settings& settings, const Render& result) {
+    // A fill runs at most a buffer before its buffer joins a full queue;
+    // a missing stamp reads as a lead of the whole render instead
+    const uint64_t bufferUs = (settings.samplesPerBuffer * 1000000ull + OUTPUT_RATE - 1) / OUTPUT_RATE;
+    const uint64_t maxLeadUs = (std::max(settings.bufferCount, settings.maxBufferCount) + 2) * bufferUs;
+    const AudioController::TriggerLatency& trigger = result.stats.triggerLatency;
+
+    bool ok = true;
+    if (result.peakIntensity <= 0.0f) {
+        std::fprintf(s_report, "audio_render: PLAYOUT - no intensity published from the I2S take\n");
+        ok = false;
+    }
+    if (result.skew.peakFillLeadUs == 0 || result.skew.peakFillLeadUs > maxLeadUs) {
+        std::fprintf(s_report, "audio_render: PLAYOUT - peak fill lead %u us, expected 1-%llu us\n",
+                     result.skew.peakFillLeadUs, static_cast<unsigned long long>(maxLeadUs));
+        ok = false;
+    }
+    if (settings.hotStart && trigger.hotStarts == 0) {
+        std::fprintf(s_report, "audio_render: PLAYOUT - no trigger was hot started (%u measured)\n",
+                     trigger.measured);
+        ok = false;
+    }
+    if (ok) {
+        std::fprintf(s_report, "audio_render: playout - peak intensity %.3f, fill lead %u us (peak %u), %u hot starts\n",
+                     result.peakIntensity, result.skew.lastFillLeadUs, result.skew.peakFillLeadUs, trigger.hotStarts);
+    }
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+
+bool writeRender(const std::string& path, const Render& result) {
+    Host::WavFile wav;
+    wav.sampleRate = OUTPUT_RATE;
+    wav.channels = 2;
+    wav.samples = result.samples;
+    return Host::writeWav(path, wav);
+}
+
+void reportRender(const std::string& path, const Render& result) {
+    const AudioController::AudioStats& stats = result.stats;
+    std::fprintf(s_report, "audio_render: %s - %zu frames (%.1f ms), %u buffers, %u underruns, %u dropped triggers\n",
+                 path.c_str(), result.samples.size() / 2, result.samples.size() / 2 * 1000.0 / OUTPUT_RATE,
+                 stats.buffersProduced, stats.underruns, stats.droppedTriggers);
+}
+
+int runBench(const Settings& base, const std::vector<Audio::AudioFile>& files, std::vector<std::string> names,
+             int repeat) {
+    if (names.empty()) {
+        for (const Scenario& scenario : scenarios()) {
+            names.push_back(scenario.name);
+        }
+    }
+
+    std::fprintf(s_report, "audio_render: producer cost per buffer of %u samples at %u Hz (best mean of %d runs)\n",
+                 base.samplesPerBuffer, OUTPUT_RATE, repeat);
+    std::fprintf(s_report, "  %-13s %8s %11s %11s %11s %8s\n",
+                 "scenario", "buffers", "ns/buffer", "min fill", "max fill", "budget");
+    for (const std::string& name : names) {
+        const Scenario* scenario = findScenario(name);
+        if (!scenario) {
+            return 2;
+        }
+        double bestNs = 0.0;
+        uint32_t minFill = UINT32_MAX;
+        uint32_t maxFill = 0;
+        Render result;
+        for (int run = 0; run < repeat; ++run) {
+            if (!render(scenarioSettings(*scenario, base), files, scenarioEvents(*scenario), false, result)) {
+                return 1;
+            }
+            const uint32_t buffers = std::max<uint32_t>(result.stats.buffersProduced, 1);
+            const double ns = static_cast<double>(result.handlers.totalNs) / buffers;
+            bestNs = run == 0 ? ns : std::min(bestNs, ns);
+            if (result.stats.minFillCycles > 0) {
+                minFill = std::min(minFill, result.stats.minFillCycles);
+            }
+            maxFill = std::max(maxFill, result.stats.maxFillCycles);
+        }
+        std::fprintf(s_report, "  %-13s %8u %11.0f %11u %11u %7.2f%%   %s\n",
+                     scenario->name, result.stats.buffersProduced, bestNs, minFill == UINT32_MAX ? 0 : minFill,
+                     maxFill, result.budgetNs ? 100.0 * bestNs / result.budgetNs : 0.0, scenario->path);
+    }
+    std::fprintf(s_report, "  ns/buffer covers everything the refill IRQ and timers ran per buffer produced;\n"
+                           "  min/max fill are fillAudioBuffer() alone (audible fills), in ns\n");
+    return 0;
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+                 "usage: audio_render --list\n"
+                 "       audio_render --scenario <name> <out.wav> [--golden <file.wav>] [--check-playout]\n"
+                 "       audio_render --bench [--repeat <n>] [scenario...]\n"
+                 "       audio_render [options] <out.wav> <ms>:<command>[=<value>]...\n"
+                 "see the top of tools/host/audio_render.cpp for options and commands\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Settings settings;
+    std::vector<Clip> clips;
+    std::vector<Event> events;
+    std::vector<std::string> positional;
+    std::string scenarioName;
+    std::string goldenPath;
+    bool bench = false;
+    bool verbose = false;
+    int repeat = 3;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--list") {
+            for (const Scenario& scenario : scenarios()) {
+                std::printf("%-13s %s\n", scenario.name, scenario.path);
+            }
+            return 0;
+        } else if (arg == "--bench") {
+            bench = true;
+        } else if (arg == "--verbose") {
+            verbose = true;
+        } else if (arg == "--no-dsp") {
+            settings.outputDsp = false;
+        } else if (arg == "--preserve-tempo") {
+            settings.preserveTempo = true;
+        } else if (arg == "--no-hot-start") {
+            settings.hotStart = false;
+        } else if (arg == "--check-playout") {
+            settings.checkPlayout = true;
+        } else if (arg == "--timer-only") {
+            settings.refillOnRelease = false;
+        } else if (arg == "--scenario" && hasValue) {
+            scenarioName = argv[++i];
+        } else if (arg == "--golden" && hasValue) {
+            goldenPath = argv[++i];
+        } else if (arg == "--repeat" && hasValue) {
+            repeat = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--buffer" && hasValue) {
+            settings.samplesPerBuffer = static_cast<uint>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--length" && hasValue) {
+            settings.lengthMs = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--depth" && hasValue) {
+            char* end = nullptr;
+            settings.bufferCount = static_cast<uint>(std::strtoul(argv[++i], &end, 10));
+            settings.maxBufferCount = *end == ':' ? static_cast<uint>(std::strtoul(end + 1, nullptr, 10))
+                                                  : settings.bufferCount;
+        } else if (arg == "--clip" && hasValue) {
+            Clip clip;
+            if (!loadClip(argv[++i], clip)) {
+                return 1;
+            }
+            clips.push_back(std::move(clip));
+        } else if (arg.compare(0, 2, "--") == 0) {
+            printUsage();
+            return 2;
+        } else {
+            Event event;
+            if (parseEvent(arg.c_str(), event)) {
+                events.push_back(event);
+            } else {
+                positional.push_back(arg);
+            }
+        }
+    }
+
+    if (clips.empty()) {
+        clips = makeTestClips();
+    }
+    const std::vector<Audio::AudioFile> files = makeAudioFiles(clips);
+
+    // The firmware logs every trigger to stdout; keep the report readable
+    if (!verbose) {
+        std::fflush(stdout);
+        s_report = fdopen(dup(fileno(stdout)), "w");
+        if (!s_report || !std::freopen("/dev/null", "w", stdout)) {
+            s_report = stdout;
+        }
+    }
+
+    if (bench) {
+        return runBench(settings, files, positional, repeat);
+    }
+
+    if (positional.size() != 1) {
+        printUsage();
+        return 2;
+    }
+    const std::string outPath = positional[0];
+
+    if (!scenarioName.empty()) {
+        const Scenario* scenario = findScenario(scenarioName);
+        if (!scenario || !events.empty()) {
+            printUsage();
+            return 2;
+        }
+        settings = scenarioSettings(*scenario, settings);
+        events = scenarioEvents(*scenario);
+    }
+
+    Render result;
+    if (!render(settings, files, events, true, result) || !writeRender(outPath, result)) {
+        return 1;
+    }
+    reportRender(outPath, result);
+    const bool playoutOk = !settings.checkPlayout || checkPlayout(settings, result);
+    if (!goldenPath.empty() && !matchesGolden(outPath, goldenPath)) {
+        return 1;
+    }
+    return playoutOk ? 0 : 1;
+}
@@ -0,0 +1,106 @@
+// Run the firmware's DalekVoice effect over a WAV file, block by block as
+// the audio producer does, and report its cost per stage and its levels.
+//
+//   dalek_voice_wav <in.wav> <out.wav> [samples per block]
+
+#include "DalekVoice.h"
+#include "WavFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace Exterminate;
+
+namespace {
+
+struct Levels {
+    double rms;
+    int peak;
+};
+
+Levels measure(const std::vector<int16_t>& samples) {
+    double sum = 0.0;
+    int peak = 0;
+    for (int16_t sample : samples) {
+        sum += static_cast<double>(sample) * sample;
+        peak = std::max(peak, std::abs(static_cast<int>(sample)));
+    }
+    return Levels{samples.empty() ? 0.0 : std::sqrt(sum / samples.size()), peak};
+}
+
+double toDbfs(double level) {
+    return level > 0.0 ? 20.0 * std::log10(level / 32768.0) : -INFINITY;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 3) {
+        std::fprintf(stderr, "usage: %s <in.wav> <out.wav> [samples per block]\n", argv[0]);
+        return 2;
+    }
+    const size_t blockSize = argc > 3 ? std::strtoul(argv[3], nullptr, 10) : 128;
+    if (blockSize == 0) {
+        std::fprintf(stderr, "dalek_voice_wav: block size must be positive\n");
+        return 2;
+    }
+
+    Host::WavFile input;
+    if (!Host::readWav(argv[1], input)) {
+        return 1;
+    }
+
+    DalekVoice voice;
+    DalekVoice::Config config = DalekVoice::Config::getDefault();
+    config.sampleRate = input.sampleRate;
+    voice.configure(config);
+
+    Host::WavFile output;
+    output.sampleRate = input.sampleRate;
+    output.samples.resize(input.samples.size());
+
+    using Clock = std::chrono::steady_clock;
+    const Clock::time_point epoch = Clock::now();
+    auto nowNs = [&epoch]() {
+        return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - epoch).count());
+    };
+    uint32_t stageNs[DalekVoice::Chain::STAGE_COUNT] = {};
+    double totalNs = 0.0;
+    double worstNs = 0.0;
+    size_t blocks = 0;
+    uint16_t minGain = DalekVoice::UNITY_GAIN;
+
+    for (size_t offset = 0; offset < input.samples.size(); offset += blockSize) {
+        const size_t count = std::min(blockSize, input.samples.size() - offset);
+        const Clock::time_point start = Clock::now();
+        voice.chain().processProfiled(&input.samples[offset], &output.samples[offset], count, stageNs, nowNs);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        totalNs += ns;
+        worstNs = std::max(worstNs, ns);
+        ++blocks;
+        minGain = std::min(minGain, voice.takeMinLimiterGain());
+    }
+
+    if (!Host::writeWav(argv[2], output)) {
+        return 1;
+    }
+
+    const Levels in = measure(input.samples);
+    const Levels out = measure(output.samples);
+    const double blockNs = blocks ? totalNs / blocks : 0.0;
+    const double audioNs = 1e9 * static_cast<double>(blockSize) / input.sampleRate;
+
+    std::printf("dalek_voice_wav: %zu samples at %u Hz, %zu blocks of %zu\n",
+                input.samples.size(), input.sampleRate, blocks, blockSize);
+    std::printf("  cost          : %.0f ns/block mean, %.0f ns worst (%.1f ns/sample, %.0fx real time)\n",
+                blockNs, worstNs, blockSize ? blockNs / blockSize : 0.0, blockNs > 0.0 ? audioNs / blockNs : 0.0);
+    for (size_t i = 0; i < DalekVoice::Chain::STAGE_COUNT; ++i) {
+        std::printf("  %-14s: %.0f ns/block\n", DalekVoice::Chain::stageName(i), blocks ? double(stageNs[i]) / blocks : 0.0);
+    }
+    std::printf("  input         : %.1f dBFS RMS, peak %d\n", toDbfs(in.rms), in.peak);
+    std::printf("  output        : %.1f dBFS RMS, peak %d (ceiling %u)\n", toDbfs(out.rms), out.peak, config.ceiling);
+    std::printf("  limiter       : min gain %.3f\n", minGain / 32768.0);
+    return 0;
+}
@@ -0,0 +1,115 @@
+// Bend the pitch of a WAV file the way the producer does with the triggers:
+// varispeed playback (a linear interpolator like the mixer's), optionally
+// followed by the firmware's TimeStretch to keep the original duration.
+// Reports the stretch cost per block and per sequence.
+//
+//   pitch_bend_wav <in.wav> <out.wav> <pitch> [samples per block] [--keep-tempo]
+
+#include "TimeStretch.h"
+#include "WavFile.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace Exterminate;
+
+namespace {
+
+// Q16 phase-accumulator linear interpolation over the input, as AudioMixer does
+struct Varispeed {
+    const std::vector<int16_t>* input;
+    uint64_t position;   // Q16 input position
+    uint32_t step;       // Q16 input samples per output sample
+};
+
+size_t readVarispeed(int16_t* out, size_t count, void* context) {
+    Varispeed& state = *static_cast<Varispeed*>(context);
+    const std::vector<int16_t>& input = *state.input;
+    size_t written = 0;
+    while (written < count) {
+        const size_t index = static_cast<size_t>(state.position >> 16);
+        if (index + 1 >= input.size()) {
+            break;
+        }
+        const int32_t fraction = static_cast<int32_t>((state.position & 0xFFFFu) >> 1);
+        const int32_t current = input[index];
+        out[written++] = static_cast<int16_t>(current + (((input[index + 1] - current) * fraction) >> 15));
+        state.position += state.step;
+    }
+    std::memset(out + written, 0, (count - written) * sizeof(int16_t));
+    return written;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 4) {
+        std::fprintf(stderr, "usage: %s <in.wav> <out.wav> <pitch> [samples per block] [--keep-tempo]\n", argv[0]);
+        return 2;
+    }
+    const double pitch = std::strtod(argv[3], nullptr);
+    size_t blockSize = 128;
+    bool keepTempo = false;
+    for (int i = 4; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--keep-tempo") == 0) {
+            keepTempo = true;
+        } else {
+            blockSize = std::strtoul(argv[i], nullptr, 10);
+        }
+    }
+    if (pitch < 0.5 || pitch > 2.0 || blockSize == 0) {
+        std::fprintf(stderr, "pitch_bend_wav: pitch must be 0.5-2.0 and the block size positive\n");
+        return 2;
+    }
+
+    Host::WavFile input;
+    if (!Host::readWav(argv[1], input)) {
+        return 1;
+    }
+
+    Varispeed varispeed{&input.samples, 0, static_cast<uint32_t>(pitch * 65536.0 + 0.5)};
+    static TimeStretch stretch;
+    stretch.configure(input.sampleRate);
+    stretch.setTempo(static_cast<uint32_t>(TimeStretch::TEMPO_UNITY / pitch + 0.5));
+
+    Host::WavFile output;
+    output.sampleRate = input.sampleRate;
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<int16_t> block(blockSize);
+    double totalNs = 0.0;
+    double worstNs = 0.0;
+    size_t blocks = 0;
+    for (;;) {
+        const Clock::time_point start = Clock::now();
+        const size_t produced = keepTempo ? stretch.process(block.data(), blockSize, &readVarispeed, &varispeed)
+                                          : readVarispeed(block.data(), blockSize, &varispeed);
+        const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        if (produced == 0) {
+            break;
+        }
+        totalNs += ns;
+        worstNs = std::max(worstNs, ns);
+        ++blocks;
+        output.samples.insert(output.samples.end(), block.begin(), block.begin() + produced);
+    }
+
+    if (!Host::writeWav(argv[2], output)) {
+        return 1;
+    }
+
+    const double blockNs = blocks ? totalNs / blocks : 0.0;
+    const double audioNs = 1e9 * static_cast<double>(blockSize) / input.sampleRate;
+    std::printf("pitch_bend_wav: pitch %.3f%s, %zu -> %zu samples at %u Hz (%.3fx duration)\n",
+                pitch, keepTempo ? " keeping tempo" : "", input.samples.size(), output.samples.size(),
+                input.sampleRate, input.samples.empty() ? 0.0 : double(output.samples.size()) / input.samples.size());
+    std::printf("  cost          : %.0f ns/block mean, %.0f ns worst (%.0fx real time)\n",
+                blockNs, worstNs, blockNs > 0.0 ? audioNs / blockNs : 0.0);
+    if (keepTempo) {
+        std::printf("  sequences     : %u of %zu samples\n", stretch.getSequenceCount(), stretch.getSequenceOutput());
+    }
+    return 0;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+// Register state only; there is no microphone signal on the host
+
+#include "pico/types.h"
+
+#define ADC_BASE_PIN 40
+#define NUM_ADC_CHANNELS 9
+#define DREQ_ADC 48
+
+typedef struct {
+    volatile uint32_t cs;
+    volatile uint32_t result;
+    volatile uint32_t fcs;
+    volatile uint32_t fifo;
+    volatile uint32_t div;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} adc_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern adc_hw_t* const adc_hw;
+
+void adc_init(void);
+void adc_gpio_init(uint gpio);
+void adc_select_input(uint input);
+void adc_fifo_setup(bool en, bool dreq_en, uint16_t dreq_thresh, bool err_in_fifo, bool byte_shift);
+void adc_set_clkdiv(float clkdiv);
+void adc_run(bool run);
+void adc_fifo_drain(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+// clk_sys reads as 1 GHz, so CycleCounter cycles are host nanoseconds
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index { clk_sys = 5 };
+
+uint32_t clock_get_hz(enum clock_index clk_index);
+
+#ifdef __cplusplus
+}
+#endif
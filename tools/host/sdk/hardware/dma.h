@@ -0,0 +1,70 @@
+#pragma once
+
+// Channels can be claimed and their registers written; no transfer ever
+// runs, so configurations that need one (clip prefetch, direct playback,
+// the microphone) are not usable on the host
+
+#include "pico/types.h"
+
+#define DMA_IRQ_0 10
+#define DMA_IRQ_1 11
+#define NUM_DMA_CHANNELS 16
+
+enum dma_channel_transfer_size { DMA_SIZE_8 = 0, DMA_SIZE_16 = 1, DMA_SIZE_32 = 2 };
+
+typedef struct {
+    uint32_t ctrl;
+} dma_channel_config;
+
+typedef struct {
+    volatile uint32_t read_addr;
+    volatile uint32_t write_addr;
+    volatile uint32_t transfer_count;
+    volatile uint32_t ctrl_trig;
+    volatile uint32_t al1_ctrl;
+    volatile uint32_t al1_read_addr;
+    volatile uint32_t al1_write_addr;
+    volatile uint32_t al1_transfer_count_trig;
+    volatile uint32_t al2_ctrl;
+    volatile uint32_t al2_transfer_count;
+    volatile uint32_t al2_read_addr;
+    volatile uint32_t al2_write_addr_trig;
+    volatile uint32_t al3_ctrl;
+    volatile uint32_t al3_write_addr;
+    volatile uint32_t al3_transfer_count;
+    volatile uint32_t al3_read_addr_trig;
+} dma_channel_hw_t;
+
+typedef struct {
+    dma_channel_hw_t ch[NUM_DMA_CHANNELS];
+} dma_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern dma_hw_t* const dma_hw;
+
+int dma_claim_unused_channel(bool required);
+void dma_channel_unclaim(uint channel);
+dma_channel_config dma_channel_get_default_config(uint channel);
+void channel_config_set_transfer_data_size(dma_channel_config* c, enum dma_channel_transfer_size size);
+void channel_config_set_read_increment(dma_channel_config* c, bool incr);
+void channel_config_set_write_increment(dma_channel_config* c, bool incr);
+void channel_config_set_dreq(dma_channel_config* c, uint dreq);
+void channel_config_set_chain_to(dma_channel_config* c, uint chain_to);
+void channel_config_set_irq_quiet(dma_channel_config* c, bool irq_quiet);
+void channel_config_set_ring(dma_channel_config* c, bool write, uint size_bits);
+void dma_channel_configure(uint channel, const dma_channel_config* config, volatile void* write_addr,
+                           const volatile void* read_addr, uint transfer_count, bool trigger);
+void dma_channel_set_read_addr(uint channel, const volatile void* read_addr, bool trigger);
+uint32_t dma_encode_endless_transfer_count(void);
+void dma_channel_abort(uint channel);
+bool dma_channel_is_busy(uint channel);
+void dma_irqn_set_channel_enabled(uint irq_index, uint channel, bool enabled);
+bool dma_irqn_get_channel_status(uint irq_index, uint channel);
+void dma_irqn_acknowledge_channel(uint irq_index, uint channel);
+
+#ifdef __cplusplus
+}
+#endif
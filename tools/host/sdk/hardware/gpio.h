@@ -0,0 +1,21 @@
+#pragma once
+
+#include "pico/types.h"
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum gpio_function { GPIO_FUNC_XIP_CS1 = 9, GPIO_FUNC_PWM = 4, GPIO_FUNC_SIO = 5 };
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+void gpio_set_function(uint gpio, enum gpio_function fn);
+
+#ifdef __cplusplus
+}
+#endif
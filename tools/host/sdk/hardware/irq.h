@@ -0,0 +1,28 @@
+#pragma once
+
+// irq_set_pending() runs the handler at once (after the current handler,
+// or when interrupts are restored), as the NVIC would on a single core
+
+#include "pico/types.h"
+
+#define PICO_DEFAULT_IRQ_PRIORITY 0x80
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef void (*irq_handler_t)(void);
+
+int user_irq_claim_unused(bool required);
+void user_irq_unclaim(uint irq_num);
+void irq_set_exclusive_handler(uint num, irq_handler_t handler);
+void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority);
+void irq_remove_handler(uint num, irq_handler_t handler);
+void irq_set_priority(uint num, uint8_t hardware_priority);
+void irq_set_enabled(uint num, bool enabled);
+void irq_set_pending(uint num);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+
+// State machines can be claimed; nothing runs on them
+
+#include "pico/types.h"
+
+typedef struct {
+    volatile uint32_t txf[4];
+} pio_hw_t;
+
+typedef pio_hw_t* PIO;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern pio_hw_t* const pio0;
+extern pio_hw_t* const pio1;
+
+PIO pio_get_instance(uint instance);
+int pio_claim_unused_sm(PIO pio, bool required);
+void pio_sm_unclaim(PIO pio, uint sm);
+void pio_sm_set_enabled(PIO pio, uint sm, bool enabled);
+uint pio_get_dreq(PIO pio, uint sm, bool is_tx);
+
+#ifdef __cplusplus
+}
+#endif
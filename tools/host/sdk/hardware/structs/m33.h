@@ -0,0 +1,25 @@
+#pragma once
+
+// CycleCounter reads DWT CYCCNT; here it counts nanoseconds of the host's
+// steady clock, which matches the 1 GHz clk_sys of hardware/clocks.h.
+// Fill costs are therefore real host time while everything else runs on
+// simulated time.
+
+#include "pico/types.h"
+
+#define M33_DEMCR_TRCENA_BITS 0x01000000u
+#define M33_DWT_CTRL_CYCCNTENA_BITS 0x00000001u
+
+uint32_t host_cycle_count(void);
+
+struct host_cyccnt_t {
+    operator uint32_t() const { return host_cycle_count(); }
+};
+
+typedef struct {
+    volatile uint32_t demcr;
+    volatile uint32_t dwt_ctrl;
+    host_cyccnt_t dwt_cyccnt;
+} m33_hw_t;
+
+extern m33_hw_t* const m33_hw;
@@ -0,0 +1,78 @@
+#pragma once
+
+// Register layout only: there is no PSRAM behind it, and PsramAllocator's
+// direct-mode handshake would wait forever, so hosts run without the
+// clip cache
+
+#include "pico/types.h"
+
+#define QMI_DIRECT_CSR_EN_BITS 0x00000001u
+#define QMI_DIRECT_CSR_BUSY_BITS 0x00000002u
+#define QMI_DIRECT_CSR_ASSERT_CS1N_BITS 0x00000008u
+#define QMI_DIRECT_CSR_AUTO_CS1N_BITS 0x00000080u
+#define QMI_DIRECT_CSR_TXEMPTY_BITS 0x00000800u
+#define QMI_DIRECT_CSR_CLKDIV_LSB 22
+#define QMI_DIRECT_TX_OE_BITS 0x00080000u
+#define QMI_DIRECT_TX_IWIDTH_LSB 16
+#define QMI_DIRECT_TX_IWIDTH_VALUE_Q 2u
+
+#define QMI_M1_TIMING_COOLDOWN_LSB 30
+#define QMI_M1_TIMING_PAGEBREAK_LSB 28
+#define QMI_M1_TIMING_PAGEBREAK_VALUE_1024 2u
+#define QMI_M1_TIMING_MAX_SELECT_LSB 17
+#define QMI_M1_TIMING_MIN_DESELECT_LSB 12
+#define QMI_M1_TIMING_RXDELAY_LSB 8
+#define QMI_M1_TIMING_CLKDIV_LSB 0
+
+#define QMI_M1_RFMT_PREFIX_WIDTH_LSB 0
+#define QMI_M1_RFMT_ADDR_WIDTH_LSB 2
+#define QMI_M1_RFMT_SUFFIX_WIDTH_LSB 4
+#define QMI_M1_RFMT_DUMMY_WIDTH_LSB 6
+#define QMI_M1_RFMT_DATA_WIDTH_LSB 8
+#define QMI_M1_RFMT_PREFIX_LEN_LSB 12
+#define QMI_M1_RFMT_DUMMY_LEN_LSB 16
+#define QMI_M1_RFMT_PREFIX_WIDTH_VALUE_Q 2u
+#define QMI_M1_RFMT_ADDR_WIDTH_VALUE_Q 2u
+#define QMI_M1_RFMT_SUFFIX_WIDTH_VALUE_Q 2u
+#define QMI_M1_RFMT_DUMMY_WIDTH_VALUE_Q 2u
+#define QMI_M1_RFMT_DATA_WIDTH_VALUE_Q 2u
+#define QMI_M1_RFMT_PREFIX_LEN_VALUE_8 1u
+#define QMI_M1_RFMT_DUMMY_LEN_VALUE_24 6u
+
+#define QMI_M1_WFMT_PREFIX_WIDTH_LSB 0
+#define QMI_M1_WFMT_ADDR_WIDTH_LSB 2
+#define QMI_M1_WFMT_SUFFIX_WIDTH_LSB 4
+#define QMI_M1_WFMT_DUMMY_WIDTH_LSB 6
+#define QMI_M1_WFMT_DATA_WIDTH_LSB 8
+#define QMI_M1_WFMT_PREFIX_LEN_LSB 12
+#define QMI_M1_WFMT_PREFIX_WIDTH_VALUE_Q 2u
+#define QMI_M1_WFMT_ADDR_WIDTH_VALUE_Q 2u
+#define QMI_M1_WFMT_SUFFIX_WIDTH_VALUE_Q 2u
+#define QMI_M1_WFMT_DUMMY_WIDTH_VALUE_Q 2u
+#define QMI_M1_WFMT_DATA_WIDTH_VALUE_Q 2u
+#define QMI_M1_WFMT_PREFIX_LEN_VALUE_8 1u
+
+typedef struct {
+    volatile uint32_t timing;
+    volatile uint32_t rfmt;
+    volatile uint32_t rcmd;
+    volatile uint32_t wfmt;
+    volatile uint32_t wcmd;
+} qmi_mem_hw_t;
+
+typedef struct {
+    volatile uint32_t direct_csr;
+    volatile uint32_t direct_tx;
+    volatile uint32_t direct_rx;
+    qmi_mem_hw_t m[2];
+} qmi_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern qmi_hw_t* const qmi_hw;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "pico/types.h"
+
+#define XIP_CTRL_WRITABLE_M1_BITS 0x00000800u
+
+typedef struct {
+    volatile uint32_t ctrl;
+    volatile uint32_t stat;
+    volatile uint32_t ctr_hit;
+    volatile uint32_t ctr_acc;
+} xip_ctrl_hw_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+extern xip_ctrl_hw_t* const xip_ctrl_hw;
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+// One simulated core: disabling interrupts defers the IRQs raised
+// meanwhile until the matching restore
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef volatile uint32_t spin_lock_t;
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+spin_lock_t* spin_lock_init(uint lock_num);
+
+// One core: a spin lock only has to keep this core's IRQs out
+static inline uint32_t spin_lock_blocking(spin_lock_t* lock) {
+    (void)lock;
+    return save_and_disable_interrupts();
+}
+
+static inline void spin_unlock(spin_lock_t* lock, uint32_t saved_irq) {
+    (void)lock;
+    restore_interrupts(saved_irq);
+}
+
+static inline void __sev(void) {}
+static inline void __wfe(void) {}
+static inline void __dmb(void) {}
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+#pragma once
+
+// pico-extras buffer pools: the structures and list operations of
+// pico_audio, with the same field names and semantics
+
+#include "pico/types.h"
+#include "hardware/sync.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define AUDIO_BUFFER_FORMAT_PCM_S16 1
+
+#define PICO_SPINLOCK_ID_AUDIO_FREE_LIST_LOCK 6
+#define PICO_SPINLOCK_ID_AUDIO_PREPARED_LISTS_LOCK 7
+
+typedef struct mem_buffer {
+    size_t size;
+    uint8_t* bytes;
+    uint8_t flags;
+} mem_buffer_t;
+
+typedef struct audio_format {
+    uint32_t sample_freq;
+    uint16_t format;
+    uint16_t channel_count;
+} audio_format_t;
+
+typedef struct audio_buffer_format {
+    const audio_format_t* format;
+    uint16_t sample_stride;
+} audio_buffer_format_t;
+
+typedef struct audio_buffer {
+    mem_buffer_t* buffer;
+    const audio_buffer_format_t* format;
+    uint32_t sample_count;
+    uint32_t max_sample_count;
+    uint32_t user_data;
+    struct audio_buffer* next;
+} audio_buffer_t;
+
+typedef struct audio_connection audio_connection_t;
+
+typedef struct audio_buffer_pool {
+    enum { ac_producer, ac_consumer } type;
+    const audio_format_t* format;
+    audio_connection_t* connection;
+    spin_lock_t* free_list_spin_lock;
+    audio_buffer_t* free_list;
+    spin_lock_t* prepared_list_spin_lock;
+    audio_buffer_t* prepared_list;
+    audio_buffer_t* prepared_list_tail;
+} audio_buffer_pool_t;
+
+struct audio_connection {
+    audio_buffer_t* (*producer_pool_take)(audio_connection_t* connection, bool block);
+    void (*producer_pool_give)(audio_connection_t* connection, audio_buffer_t* buffer);
+    audio_buffer_t* (*consumer_pool_take)(audio_connection_t* connection, bool block);
+    void (*consumer_pool_give)(audio_connection_t* connection, audio_buffer_t* buffer);
+    audio_buffer_pool_t* producer_pool;
+    audio_buffer_pool_t* consumer_pool;
+};
+
+// Nothing runs concurrently on the host, so block = true never waits:
+// an empty list returns nullptr either way
+audio_buffer_t* get_free_audio_buffer(audio_buffer_pool_t* context, bool block);
+void queue_free_audio_buffer(audio_buffer_pool_t* context, audio_buffer_t* ab);
+audio_buffer_t* get_full_audio_buffer(audio_buffer_pool_t* context, bool block);
+void queue_full_audio_buffer(audio_buffer_pool_t* context, audio_buffer_t* ab);
+
+audio_buffer_t* take_audio_buffer(audio_buffer_pool_t* ac, bool block);
+void give_audio_buffer(audio_buffer_pool_t* ac, audio_buffer_t* buffer);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+// I2S output, consumed by the simulated DMA of PicoHost. As in pico-extras,
+// audio_i2s_connect_extra() allocates a consumer pool of buffer_count x
+// samples_per_buffer and uses the given connection; audio_i2s_connect()
+// uses 2 x 256 and the copying connection, which fills consumer buffers
+// from the producer's instead of playing them in place
+
+#include "pico/audio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct audio_i2s_config {
+    uint8_t data_pin;
+    uint8_t clock_pin_base;
+    uint8_t dma_channel;
+    uint8_t pio_sm;
+} audio_i2s_config_t;
+
+const audio_format_t* audio_i2s_setup(const audio_format_t* intended_audio_format,
+                                      const audio_i2s_config_t* config);
+bool audio_i2s_connect(audio_buffer_pool_t* producer);
+bool audio_i2s_connect_extra(audio_buffer_pool_t* producer, bool buffer_on_give, uint buffer_count,
+                             uint samples_per_buffer, audio_connection_t* connection);
+void audio_i2s_set_enabled(bool enabled);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,17 @@
+#pragma once
+
+// There is no second core on the host; launching one is a harness error
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void multicore_launch_core1(void (*entry)(void));
+void multicore_reset_core1(void);
+void multicore_lockout_victim_init(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,42 @@
+#pragma once
+
+// Time is simulated: it only moves when the harness runs the clock
+// (Host::runUntil), so renders do not depend on the host's speed
+
+#include "pico/types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct repeating_timer repeating_timer_t;
+typedef bool (*repeating_timer_callback_t)(repeating_timer_t* rt);
+
+struct repeating_timer {
+    int64_t delay_us;
+    int alarm_id;
+    repeating_timer_callback_t callback;
+    void* user_data;
+};
+
+uint32_t time_us_32(void);
+uint64_t time_us_64(void);
+absolute_time_t get_absolute_time(void);
+absolute_time_t make_timeout_time_us(uint64_t us);
+
+bool add_repeating_timer_us(int64_t delay_us, repeating_timer_callback_t callback, void* user_data,
+                            repeating_timer_t* out);
+bool add_repeating_timer_ms(int32_t delay_ms, repeating_timer_callback_t callback, void* user_data,
+                            repeating_timer_t* out);
+bool cancel_repeating_timer(repeating_timer_t* timer);
+
+void busy_wait_us_32(uint32_t delay_us);
+void sleep_us(uint64_t us);
+void sleep_ms(uint32_t ms);
+bool best_effort_wfe_or_timeout(absolute_time_t timeout_timestamp);
+
+static inline void tight_loop_contents(void) {}
+
+#ifdef __cplusplus
+}
+#endif
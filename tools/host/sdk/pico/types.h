@@ -0,0 +1,20 @@
+#pragma once
+
+// Host stand-in for the Pico SDK (see tools/host/PicoHost.h): only what
+// the firmware's audio path uses
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+typedef uint64_t absolute_time_t;
+
+#define XIP_BASE 0x10000000u
+#define XIP_NOCACHE_NOALLOC_BASE 0x14000000u
+
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+
+static inline void busy_wait_at_least_cycles(uint32_t minimum_cycles) {
+    (void)minimum_cycles;
+}
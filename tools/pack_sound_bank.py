@@ -0,0 +1,185 @@
+#!/usr/bin/env python3
+"""
+Sound Bank Packer
+
+Packs audio files into a flash sound bank image for SoundBank::mount().
+The bank lives in its own flash partition, so clips can be changed without
+rebuilding or reflashing the firmware.
+
+Usage:
+  python tools/pack_sound_bank.py misc sound_bank.bin --codec adpcm --auto-rate
+  picotool load -v -x sound_bank.bin -t bin -o 0x10C00000
+
+Clips are ordered like tools/audio_to_pcm_header.py orders them, so
+Audio::AudioIndex values keep pointing at the same sounds.
+
+Layout (little endian, pointers are absolute XIP addresses):
+  Header            32 bytes (magic, version, count, base, offsets, CRC-32)
+  Index             one 40-byte Audio::AudioFile per clip
+  Names, envelopes  NUL-terminated names and uint8 loudness tables
+  Payloads          clip data, each aligned to a 4 KB flash sector
+"""
+
+import sys
+import argparse
+import struct
+import zlib
+from pathlib import Path
+
+from audio_to_pcm_header import (AUDIO_LIBS_AVAILABLE, CODECS, audio_to_pcm, compute_envelope,
+                                 encode_clip, parse_loop_option, pick_sample_rate, resolve_loop)
+
+# Must match SoundBank in include/SoundBank.h
+BANK_MAGIC = 0x42535845  # "EXSB"
+BANK_VERSION = 2
+BANK_MAX_CLIPS = 256
+BANK_HEADER_FORMAT = '<IHHIIIII'           # everything before headerCrc
+BANK_HEADER_BYTES = 32
+PAYLOAD_ALIGN = 4096
+
+# Must match Audio::AudioFile on the RP2350 (32-bit pointers)
+AUDIO_FILE_FORMAT = '<IIIIIBBBxIIII'
+AUDIO_FILE_BYTES = struct.calcsize(AUDIO_FILE_FORMAT)
+
+# Must match AudioCodec in audio_index.h
+CODEC_IDS = {'pcm16': 0, 'adpcm': 1, 'mulaw': 2}
+
+# Default partition: 12 MB into flash, up to 64 KB short of its end, which
+# BTstack keeps for pairing keys (see CMakeLists.txt)
+DEFAULT_XIP_BASE = 0x10C00000
+DEFAULT_PARTITION_BYTES = 0x3F0000
+
+def align(value, alignment):
+    return (value + alignment - 1) // alignment * alignment
+
+def load_clip(audio_path, sample_rate, codec, auto_rate, loop=None):
+    """Convert one file; returns a dict describing the clip or None."""
+    if not AUDIO_LIBS_AVAILABLE:
+        return None
+
+    if auto_rate:
+        import librosa
+        y, _ = librosa.load(audio_path, sr=sample_rate, mono=True)
+        sample_rate = pick_sample_rate(y, sample_rate)
+
+    result = audio_to_pcm(audio_path, sample_rate, 1, 16)
+    if result is None:
+        return None
+    pcm_data, _ = result
+
+    payload = pcm_data.astype('<i2').tobytes() if codec == 'pcm16' else encode_clip(pcm_data, codec).tobytes()
+    return {
+        'name': Path(audio_path).name,
+        'sample_count': len(pcm_data),
+        'sample_rate': sample_rate,
+        'codec': codec,
+        'payload': payload,
+        'envelope': compute_envelope(pcm_data).tobytes(),
+        'loop': resolve_loop(audio_path, loop, sample_rate, len(pcm_data)),
+    }
+
+def pack_bank(clips, xip_base):
+    """Lay out clips and return the bank image as bytes."""
+    index_offset = BANK_HEADER_BYTES
+    cursor = index_offset + len(clips) * AUDIO_FILE_BYTES
+
+    # Names and envelopes go straight after the index
+    for clip in clips:
+        clip['name_offset'] = cursor
+        cursor += len(clip['name'].encode()) + 1
+    for clip in clips:
+        clip['envelope_offset'] = cursor
+        cursor += len(clip['envelope'])
+
+    # Payloads start on sector boundaries so each can be rewritten alone
+    data_offset = align(cursor, PAYLOAD_ALIGN)
+    cursor = data_offset
+    for clip in clips:
+        clip['payload_offset'] = cursor
+        cursor = align(cursor + len(clip['payload']), PAYLOAD_ALIGN)
+    total_bytes = cursor
+
+    image = bytearray(total_bytes)
+    for i, clip in enumerate(clips):
+        payload_ptr = xip_base + clip['payload_offset']
+        pcm16 = clip['codec'] == 'pcm16'
+        struct.pack_into(AUDIO_FILE_FORMAT, image, index_offset + i * AUDIO_FILE_BYTES,
+                         xip_base + clip['name_offset'],
+                         payload_ptr if pcm16 else 0,
+                         clip['sample_count'],
+                         len(clip['payload']),
+                         clip['sample_rate'],
+                         1, 16,
+                         CODEC_IDS[clip['codec']],
+                         0 if pcm16 else payload_ptr,
+                         xip_base + clip['envelope_offset'],
+                         *clip.get('loop', (0, 0)))
+        name = clip['name'].encode() + b'\0'
+        image[clip['name_offset']:clip['name_offset'] + len(name)] = name
+        image[clip['envelope_offset']:clip['envelope_offset'] + len(clip['envelope'])] = clip['envelope']
+        image[clip['payload_offset']:clip['payload_offset'] + len(clip['payload'])] = clip['payload']
+
+    header = struct.pack(BANK_HEADER_FORMAT, BANK_MAGIC, BANK_VERSION, len(clips), xip_base,
+                         index_offset, data_offset, total_bytes, 0)
+    image[0:BANK_HEADER_BYTES] = header + struct.pack('<I', zlib.crc32(header))
+    return bytes(image)
+
+def main():
+    parser = argparse.ArgumentParser(description='Pack audio files into a flash sound bank image')
+    parser.add_argument('input_dir', help='Directory containing audio files')
+    parser.add_argument('output', help='Bank image to write (.bin)')
+    parser.add_argument('--pattern', default=None, help='File pattern to match (default: mp3/wav/flac/ogg)')
+    parser.add_argument('--sample-rate', type=int, default=44100, help='Target sample rate (default: 44100)')
+    parser.add_argument('--codec', choices=sorted(CODECS), default='pcm16',
+                        help='Clip storage: pcm16, adpcm (IMA-ADPCM 4:1) or mulaw (2:1) (default: pcm16)')
+    parser.add_argument('--auto-rate', action='store_true',
+                        help='Store each clip at the lowest rate that keeps its bandwidth (max: --sample-rate)')
+    parser.add_argument('--xip-base', type=lambda v: int(v, 0), default=DEFAULT_XIP_BASE,
+                        help=f'XIP address of the bank partition (default: 0x{DEFAULT_XIP_BASE:08X})')
+    parser.add_argument('--partition-size', type=lambda v: int(v, 0), default=DEFAULT_PARTITION_BYTES,
+                        help=f'Partition size in bytes (default: 0x{DEFAULT_PARTITION_BYTES:X})')
+    parser.add_argument('--loop', type=parse_loop_option, action='append', default=[], metavar='NAME:START:END',
+                        help='Loop a clip between source samples START and END (exclusive); repeatable')
+
+    args = parser.parse_args()
+
+    if not AUDIO_LIBS_AVAILABLE:
+        print("Error: librosa and soundfile are required to pack a sound bank")
+        return 1
+
+    input_path = Path(args.input_dir)
+    if args.pattern:
+        audio_files = sorted(input_path.glob(args.pattern))
+    else:
+        audio_files = sorted(f for pattern in ['*.mp3', '*.wav', '*.flac', '*.ogg'] for f in input_path.glob(pattern))
+
+    if not audio_files:
+        print(f"No audio files found in {input_path}")
+        return 1
+    if len(audio_files) > BANK_MAX_CLIPS:
+        print(f"Error: {len(audio_files)} clips exceed the bank limit of {BANK_MAX_CLIPS}")
+        return 1
+
+    loops = {name: (start, end) for name, start, end in args.loop}
+    clips = []
+    for audio_file in audio_files:
+        clip = load_clip(str(audio_file), args.sample_rate, args.codec, args.auto_rate, loops.get(audio_file.name))
+        if clip is None:
+            print(f"Error: could not convert {audio_file}")
+            return 1
+        clips.append(clip)
+
+    image = pack_bank(clips, args.xip_base)
+    if len(image) > args.partition_size:
+        print(f"Error: bank is {len(image):,} bytes, partition holds {args.partition_size:,}")
+        return 1
+
+    Path(args.output).write_bytes(image)
+    payload_bytes = sum(len(clip['payload']) for clip in clips)
+    print(f"Packed {len(clips)} clips into {args.output}: {len(image):,} bytes "
+          f"({payload_bytes:,} payload, {len(image) - payload_bytes:,} index/padding)")
+    print(f"Flash with: picotool load -v -x {args.output} -t bin -o 0x{args.xip_base:08X}")
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())